@@ -38,6 +38,7 @@
 #include <ompl/base/goals/GoalRegion.h>
 #include <ompl/config.h>
 #include <iostream>
+#include <thread>
 #include <ode/ode.h>
 
 namespace ob = ompl::base;
@@ -99,6 +100,13 @@ public:
         contact.surface.soft_cfm = 0.2;
     }
 
+    // the world is built the same way every time, so a fresh
+    // environment is a valid copy for parallel propagation
+    oc::OpenDEEnvironmentPtr clone() const override
+    {
+        return std::make_shared<RigidBodyEnvironment>();
+    }
+
     /**************************************************/
 
     // OMPL does not require this function here; we implement it here
@@ -234,6 +242,9 @@ int main(int /*argc*/, char ** /*argv*/)
     stateSpace->setLinearVelocityBounds(bounds);
     stateSpace->setAngularVelocityBounds(bounds);
 
+    // allow up to one simulation per hardware thread to run in parallel
+    env->setWorldPoolSize(std::thread::hardware_concurrency());
+
     ss.setup();
     ss.print();
 
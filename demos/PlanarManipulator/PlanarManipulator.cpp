@@ -189,6 +189,48 @@ void PlanarManipulator::FK(const double *joints, Eigen::Affine2d &eeFrame) const
     }
 }
 
+void PlanarManipulator::FK(const double *const *configs, std::size_t count, ChainPositions &positions) const
+{
+    const std::size_t stride = numLinks_ + 1;
+    positions.x.resize(count * stride);
+    positions.y.resize(count * stride);
+    positions.theta.resize(count * stride);
+
+    for (std::size_t c = 0; c < count; ++c)
+        FK(configs[c], 0, positions, c);
+}
+
+void PlanarManipulator::FK(const double *joints, unsigned int firstJoint, ChainPositions &positions,
+                           std::size_t c) const
+{
+    const std::size_t stride = numLinks_ + 1;
+    if (positions.x.size() < (c + 1) * stride)
+    {
+        positions.x.resize((c + 1) * stride);
+        positions.y.resize((c + 1) * stride);
+        positions.theta.resize((c + 1) * stride);
+        firstJoint = 0;
+    }
+
+    double *x = &positions.x[c * stride];
+    double *y = &positions.y[c * stride];
+    double *theta = &positions.theta[c * stride];
+    if (firstJoint == 0)
+    {
+        x[0] = baseFrame_.translation()(0);
+        y[0] = baseFrame_.translation()(1);
+        theta[0] = atan2(baseFrame_.matrix()(1, 0), baseFrame_.matrix()(0, 0));
+    }
+
+    // Only the accumulated angle and the position are carried along the chain
+    for (unsigned int i = firstJoint; i < numLinks_; ++i)
+    {
+        theta[i + 1] = theta[i] + joints[i];
+        x[i + 1] = x[i] + linkLengths_[i] * cos(theta[i + 1]);
+        y[i + 1] = y[i] + linkLengths_[i] * sin(theta[i + 1]);
+    }
+}
+
 // Inverse kinematics for the given end effector frame.  Only one solution is returned.
 // Returns false if no solution exists to the given pose.
 bool PlanarManipulator::IK(std::vector<double> &solution, const Eigen::Affine2d &eeFrame) const
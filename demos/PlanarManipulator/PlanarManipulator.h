@@ -43,6 +43,16 @@
 class PlanarManipulator
 {
 public:
+    // Positions of the base and of the end of each link, and the accumulated joint angle of
+    // each link, for one or more configurations.  Point i of configuration c is stored at index
+    // c * (numLinks + 1) + i; point 0 is the base and angle 0 is the orientation of the base.
+    struct ChainPositions
+    {
+        std::vector<double> x;
+        std::vector<double> y;
+        std::vector<double> theta;
+    };
+
     // A numLinks manipulator with equal length links.
     PlanarManipulator(unsigned int numLinks, double linkLength, const std::pair<double, double> &origin = {0.0, 0.0});
 
@@ -87,6 +97,15 @@ public:
     void FK(const std::vector<double> &joints, Eigen::Affine2d &eeFrame) const;
     void FK(const Eigen::VectorXd &joints, Eigen::Affine2d &eeFrame) const;
 
+    // Batched forward kinematics for count configurations.  Only positions and accumulated angles
+    // are propagated along the chain, which is much cheaper than composing frames.
+    void FK(const double *const *configs, std::size_t count, ChainPositions &positions) const;
+
+    // Incremental forward kinematics.  Configuration c of positions holds the chain for a
+    // configuration that agrees with joints before firstJoint; only the links from firstJoint on
+    // are recomputed.  With firstJoint = 0, this is FK for a single configuration.
+    void FK(const double *joints, unsigned int firstJoint, ChainPositions &positions, std::size_t c = 0) const;
+
     // Inverse kinematics for the given end effector frame.  Jacobian pseudo-inverse method
     // Returns false if no solution is found to the given pose.
     // NOTE: Joint limits are not respected in this IK solver.
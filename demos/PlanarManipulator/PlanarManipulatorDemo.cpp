@@ -42,6 +42,7 @@
 #include "PlanarManipulator.h"
 #include "PlanarManipulatorStateSpace.h"
 #include "PlanarManipulatorStateValidityChecker.h"
+#include "PlanarManipulatorMotionValidator.h"
 #include "PlanarManipulatorIKGoal.h"
 #include "PlanarManipulatorTSRRTConfig.h"
 #include "PlanarManipulatorXXLDecomposition.h"
@@ -71,6 +72,7 @@ struct Arguments
     double timeout;
     std::string problem;
     bool viz;
+    unsigned int numThreads;
 };
 
 // Minimal setup for a planar manipulation problem.
@@ -128,8 +130,13 @@ ompl::geometric::SimpleSetupPtr setupOMPL(Problem &problem)
     ompl::geometric::SimpleSetupPtr setup(new ompl::geometric::SimpleSetup(space));
 
     // Create the collision checker.
-    setup->setStateValidityChecker(std::make_shared<PlanarManipulatorCollisionChecker>(
-        setup->getSpaceInformation(), problem.manipulator, &problem.world));
+    auto checker = std::make_shared<PlanarManipulatorCollisionChecker>(setup->getSpaceInformation(),
+                                                                       problem.manipulator, &problem.world);
+    setup->setStateValidityChecker(checker);
+
+    // Check motions with batched forward kinematics.
+    setup->getSpaceInformation()->setMotionValidator(std::make_shared<PlanarManipulatorMotionValidator>(
+        setup->getSpaceInformation(), problem.manipulator, checker.get()));
 
     // Increase motion validator resolution.
     setup->getSpaceInformation()->setStateValidityCheckingResolution(0.001);
@@ -225,6 +232,17 @@ ompl::geometric::XXLDecompositionPtr getXXLDecomp(const ompl::base::SpaceInforma
     return decomp;
 }
 
+// Returns XXL for the planar manipulator.  With more than one thread, each
+// worker thread samples regions in a decomposition of its own.
+ompl::base::PlannerPtr getXXL(const ompl::base::SpaceInformationPtr &si, const Problem &problem, int numXYSlices,
+                              unsigned int numThreads)
+{
+    auto xxl = std::make_shared<ompl::geometric::XXL>(si, getXXLDecomp(si, problem, numXYSlices));
+    xxl->setNumThreads(numThreads);
+    xxl->setDecompositionAllocator([si, &problem, numXYSlices] { return getXXLDecomp(si, problem, numXYSlices); });
+    return xxl;
+}
+
 // Computes the Cartesian distance traveled by each joint in the chain
 // on the solution path that is computed.
 void postRunEvent(const ompl::base::PlannerPtr &planner, ompl::tools::Benchmark::RunProperties &run,
@@ -249,7 +267,8 @@ void postRunEvent(const ompl::base::PlannerPtr &planner, ompl::tools::Benchmark:
     run["Cartesian Distance REAL"] = boost::lexical_cast<std::string>(cartesianDist);
 }
 
-void BenchmarkProblem(ompl::geometric::SimpleSetupPtr setup, const Problem &problem, int runs, double timeout)
+void BenchmarkProblem(ompl::geometric::SimpleSetupPtr setup, const Problem &problem, int runs, double timeout,
+                      unsigned int numThreads)
 {
     ompl::base::PlannerPtr kpiece(new ompl::geometric::KPIECE1(setup->getSpaceInformation()));
     ompl::base::PlannerPtr rrt(new ompl::geometric::RRT(setup->getSpaceInformation()));
@@ -263,10 +282,8 @@ void BenchmarkProblem(ompl::geometric::SimpleSetupPtr setup, const Problem &prob
 
     const int numLinks = problem.manipulator.getNumLinks();
     const int xySlices = std::max(2, numLinks / 3);
-    ompl::base::PlannerPtr xxl(new ompl::geometric::XXL(setup->getSpaceInformation(),
-                                                        getXXLDecomp(setup->getSpaceInformation(), problem, xySlices)));
-    ompl::base::PlannerPtr xxl1(new ompl::geometric::XXL(
-        setup->getSpaceInformation(), getXXLDecomp(setup->getSpaceInformation(), problem, /*xySlices*/ 1)));
+    ompl::base::PlannerPtr xxl = getXXL(setup->getSpaceInformation(), problem, xySlices, numThreads);
+    ompl::base::PlannerPtr xxl1 = getXXL(setup->getSpaceInformation(), problem, /*xySlices*/ 1, numThreads);
     xxl1->setName("XXL1");
 
     std::string name ="PlanarManipulator - " + problem.name;
@@ -327,14 +344,14 @@ void WriteVisualization(const Problem &problem, const ompl::geometric::PathGeome
     fout.close();
 }
 
-void SolveProblem(ompl::geometric::SimpleSetupPtr setup, const Problem &problem, double timeout, bool write_viz_out)
+void SolveProblem(ompl::geometric::SimpleSetupPtr setup, const Problem &problem, double timeout, bool write_viz_out,
+                  unsigned int numThreads)
 {
     // Solve the problem with XXL.
     const int numLinks = problem.manipulator.getNumLinks();
     // The number of grid cells in each dimension of the workspace decomposition.
     const int xySlices = std::max(2, numLinks / 3);
-    ompl::base::PlannerPtr xxl(new ompl::geometric::XXL(setup->getSpaceInformation(),
-                                                        getXXLDecomp(setup->getSpaceInformation(), problem, xySlices)));
+    ompl::base::PlannerPtr xxl = getXXL(setup->getSpaceInformation(), problem, xySlices, numThreads);
     setup->setPlanner(xxl);
 
     // SOLVE!
@@ -366,9 +383,9 @@ void PlanarManipulatorPlanning(const Arguments &args)
     ompl::geometric::SimpleSetupPtr setup = setupOMPL(problem);
 
     if (args.numRuns == 1)
-        SolveProblem(setup, problem, args.timeout, args.viz);
+        SolveProblem(setup, problem, args.timeout, args.viz, args.numThreads);
     else
-        BenchmarkProblem(setup, problem, args.numRuns, args.timeout);
+        BenchmarkProblem(setup, problem, args.numRuns, args.timeout, args.numThreads);
 }
 
 int main(int argc, char **argv)
@@ -390,7 +407,9 @@ int main(int argc, char **argv)
         ("problem,p", po::value<std::string>(&args.problem)->default_value("corridor"),
             "The name of the problem [corridor,constricted] to solve")
         ("viz,v", po::bool_switch(&args.viz)->default_value(false),
-            "Write visualization output to disk.  Only works when runs = 1");
+            "Write visualization output to disk.  Only works when runs = 1")
+        ("threads,j", po::value<unsigned int>(&args.numThreads)->default_value(1),
+            "The number of threads XXL uses to sample regions and check motions");
     //  clang-format on
 
     po::variables_map vm;
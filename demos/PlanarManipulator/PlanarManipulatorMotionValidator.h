@@ -0,0 +1,168 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, the MROR Multi-Robot OMPL contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+/* Author: MROR Multi-Robot OMPL contributors */
+
+#ifndef PLANAR_MANIPULATOR_MOTION_VALIDATOR_H_
+#define PLANAR_MANIPULATOR_MOTION_VALIDATOR_H_
+
+#include <queue>
+#include <ompl/base/MotionValidator.h>
+#include <ompl/base/SpaceInformation.h>
+#include "PlanarManipulator.h"
+#include "PlanarManipulatorStateSpace.h"
+#include "PlanarManipulatorStateValidityChecker.h"
+
+// A discrete motion validator for planar manipulators.  The configurations along a motion are
+// interpolated a batch at a time and put through batched forward kinematics.  When the ends of
+// the motion agree on the first joints, that part of the chain is computed only once, and its
+// links are only checked for self-collision with the links that move.
+class PlanarManipulatorMotionValidator : public ompl::base::MotionValidator
+{
+public:
+    PlanarManipulatorMotionValidator(const ompl::base::SpaceInformationPtr &si, const PlanarManipulator &manip,
+                                     const PlanarManipulatorCollisionChecker *checker)
+      : ompl::base::MotionValidator(si), manip_(manip), checker_(checker)
+    {
+    }
+
+    ~PlanarManipulatorMotionValidator() override = default;
+
+    bool checkMotion(const ompl::base::State *s1, const ompl::base::State *s2) const override
+    {
+        // s2 is checked first, then the states in between in bisection order
+        const unsigned int nd = si_->getStateSpace()->validSegmentCount(s1, s2);
+        std::vector<unsigned int> order(1, nd);
+        std::queue<std::pair<unsigned int, unsigned int>> intervals;
+        if (nd >= 2)
+            intervals.emplace(1, nd - 1);
+        while (!intervals.empty())
+        {
+            std::pair<unsigned int, unsigned int> x = intervals.front();
+            intervals.pop();
+            unsigned int mid = (x.first + x.second) / 2;
+            order.push_back(mid);
+            if (x.first < mid)
+                intervals.emplace(x.first, mid - 1);
+            if (x.second > mid)
+                intervals.emplace(mid + 1, x.second);
+        }
+
+        bool result = firstInvalid(s1, s2, nd, order) == order.size();
+        result ? valid_++ : invalid_++;
+        return result;
+    }
+
+    bool checkMotion(const ompl::base::State *s1, const ompl::base::State *s2,
+                     std::pair<ompl::base::State *, double> &lastValid) const override
+    {
+        // The states are checked in order, so the last valid state is known
+        const unsigned int nd = si_->getStateSpace()->validSegmentCount(s1, s2);
+        std::vector<unsigned int> order(nd);
+        for (unsigned int j = 0; j < nd; ++j)
+            order[j] = j + 1;
+
+        std::size_t invalid = firstInvalid(s1, s2, nd, order);
+        bool result = invalid == order.size();
+        if (!result)
+        {
+            lastValid.second = (double)(order[invalid] - 1) / (double)nd;
+            if (lastValid.first != nullptr)
+                si_->getStateSpace()->interpolate(s1, s2, lastValid.second, lastValid.first);
+        }
+        result ? valid_++ : invalid_++;
+        return result;
+    }
+
+private:
+    // Check the states at j / nd along the motion for j in order, a batch at a time.  Returns the
+    // position in order of the first invalid state, or order.size() if all states are valid.
+    std::size_t firstInvalid(const ompl::base::State *s1, const ompl::base::State *s2, unsigned int nd,
+                             const std::vector<unsigned int> &order) const
+    {
+        const unsigned int numLinks = manip_.getNumLinks();
+        const double *v1 = s1->as<PlanarManipulatorStateSpace::StateType>()->values;
+        const double *v2 = s2->as<PlanarManipulatorStateSpace::StateType>()->values;
+
+        // The joints before firstJoint do not move, so neither do the links before it
+        unsigned int firstJoint = 0;
+        while (firstJoint < numLinks && v1[firstJoint] == v2[firstJoint])
+            ++firstJoint;
+
+        PlanarManipulator::ChainPositions prefix;
+        manip_.FK(v1, 0, prefix);
+
+        const std::size_t batchSize = std::min<std::size_t>(order.size(), 32);
+        std::vector<ompl::base::State *> states(batchSize);
+        si_->allocStates(states);
+
+        PlanarManipulator::ChainPositions positions;
+        positions.x.resize(batchSize * (numLinks + 1));
+        positions.y.resize(batchSize * (numLinks + 1));
+        positions.theta.resize(batchSize * (numLinks + 1));
+        for (std::size_t c = 0; c < batchSize; ++c)
+        {
+            std::copy(prefix.x.begin(), prefix.x.begin() + firstJoint + 1, positions.x.begin() + c * (numLinks + 1));
+            std::copy(prefix.y.begin(), prefix.y.begin() + firstJoint + 1, positions.y.begin() + c * (numLinks + 1));
+            std::copy(prefix.theta.begin(), prefix.theta.begin() + firstJoint + 1,
+                      positions.theta.begin() + c * (numLinks + 1));
+        }
+
+        std::size_t invalid = order.size();
+        for (std::size_t first = 0; first < order.size() && invalid == order.size(); first += batchSize)
+        {
+            const std::size_t count = std::min(batchSize, order.size() - first);
+            for (std::size_t c = 0; c < count; ++c)
+            {
+                si_->getStateSpace()->interpolate(s1, s2, (double)order[first + c] / (double)nd, states[c]);
+                manip_.FK(states[c]->as<PlanarManipulatorStateSpace::StateType>()->values, firstJoint, positions, c);
+            }
+
+            for (std::size_t c = 0; c < count; ++c)
+                if (!checker_->isValid(positions, c, firstJoint))
+                {
+                    invalid = first + c;
+                    break;
+                }
+        }
+
+        si_->freeStates(states);
+        return invalid;
+    }
+
+    const PlanarManipulator &manip_;
+    const PlanarManipulatorCollisionChecker *checker_;
+};
+
+#endif
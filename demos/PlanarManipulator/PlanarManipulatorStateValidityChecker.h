@@ -175,43 +175,41 @@ public:
 
     virtual bool isValid(const ompl::base::State *state) const
     {
-        const double *angles = state->as<PlanarManipulatorStateSpace::StateType>()->values;
-        std::vector<Eigen::Affine2d> frames;
-        manip_.FK(angles, frames);
-
-        // Get the coordinates of the endpoint of each segment and the base
-        // of the manipulator.
-        std::vector<Point> coordinates;
-        const Eigen::Affine2d &baseFrame = manip_.getBaseFrame();
-        coordinates.push_back({baseFrame.translation()[0], baseFrame.translation()[1]});
-        for (size_t i = 0; i < frames.size(); ++i)
-            coordinates.push_back({frames[i].translation()(0), frames[i].translation()(1)});
-
-        // Check each coordinate to make sure they are in bounds.
-        for (size_t i = 1; i < coordinates.size(); ++i)
-            if (world_->outOfBounds(coordinates[i]))
-                return false;
+        PlanarManipulator::ChainPositions positions;
+        manip_.FK(state->as<PlanarManipulatorStateSpace::StateType>()->values, 0, positions);
+        return isValid(positions, 0);
+    }
 
-        // Check each coordinate for obstacle intersection.
-        for (size_t i = 1; i < coordinates.size(); ++i)
-            for (size_t j = 0; j < world_->numObstacles(); ++j)
-                if (world_->obstacle(j).inside(coordinates[i]))
-                    return false;
+    // Returns true if configuration c of the chain positions computed with PlanarManipulator::FK
+    // is valid.  The links before firstLink are assumed to be valid already (e.g., they did not
+    // move since the last check), so only their self-collisions with the other links are checked.
+    bool isValid(const PlanarManipulator::ChainPositions &positions, std::size_t c, unsigned int firstLink = 0) const
+    {
+        const unsigned int numLinks = manip_.getNumLinks();
+        const double *x = &positions.x[c * (numLinks + 1)];
+        const double *y = &positions.y[c * (numLinks + 1)];
 
-        // Self-collision with the manipulator.
-        if (inSelfCollision(coordinates))
-            return false;
+        // Check the endpoint of each link to make sure it is in bounds.
+        for (unsigned int i = firstLink + 1; i <= numLinks; ++i)
+            if (world_->outOfBounds({x[i], y[i]}))
+                return false;
 
-        // Above, we only checked the endpoints of the links of the manipulator.
-        // We can still cut a corner of an obstacle.  Check for this.
-        for (size_t i = 0; i < coordinates.size() - 1; ++i)
+        // Check each link for obstacle intersection.  The endpoint of the link may lie inside the
+        // obstacle, or the link may cut a corner of the obstacle.  Obstacles whose bounding box
+        // does not overlap the link are skipped.
+        for (size_t j = 0; j < world_->numObstacles(); ++j)
         {
-            Point p1 = coordinates[i];
-            Point p2 = coordinates[i + 1];
-
-            for (size_t j = 0; j < world_->numObstacles(); ++j)
+            const ConvexPolygon &obstacle = world_->obstacle(j);
+            for (unsigned int i = firstLink; i < numLinks; ++i)
             {
-                const ConvexPolygon &obstacle = world_->obstacle(j);
+                Point p1(x[i], y[i]);
+                Point p2(x[i + 1], y[i + 1]);
+                if (!obstacle.boundsOverlap(p1, p2))
+                    continue;
+
+                if (obstacle.inside(p2))
+                    return false;
+
                 Point prev = obstacle[obstacle.numPoints() - 1];
                 for (size_t k = 0; k < obstacle.numPoints(); ++k)
                 {
@@ -222,23 +220,35 @@ public:
             }
         }
 
-        return true;
+        // Self-collision with the manipulator.
+        return !inSelfCollision(x, y, numLinks, firstLink);
     }
 
 private:
-    bool inSelfCollision(const std::vector<Point> &points) const
+    // Intersect all pairs of links where at least one link is at or after firstLink
+    bool inSelfCollision(const double *x, const double *y, unsigned int numLinks, unsigned int firstLink) const
     {
         // a single line cannot intersect with itself
-        if (points.size() < 3)
+        if (numLinks < 2)
             return false;
 
-        // intersect all pairs of lines
-        for (size_t i = 0; i < points.size() - 1; ++i)
-            for (size_t j = i + 1; j < points.size() - 1; ++j)
-                if (lineLineIntersection(points[i], points[i + 1], points[j], points[j + 1]))
+        // Links whose bounding boxes are apart cannot intersect
+        const double eps = 1e-6;
+        for (unsigned int j = std::max(firstLink, 1u); j < numLinks; ++j)
+        {
+            const double xMin = std::min(x[j], x[j + 1]) - eps, xMax = std::max(x[j], x[j + 1]) + eps;
+            const double yMin = std::min(y[j], y[j + 1]) - eps, yMax = std::max(y[j], y[j + 1]) + eps;
+            for (unsigned int i = 0; i < j; ++i)
+            {
+                if (std::max(x[i], x[i + 1]) < xMin || std::min(x[i], x[i + 1]) > xMax ||
+                    std::max(y[i], y[i + 1]) < yMin || std::min(y[i], y[i + 1]) > yMax)
+                    continue;
+                if (lineLineIntersection({x[i], y[i]}, {x[i + 1], y[i + 1]}, {x[j], y[j]}, {x[j + 1], y[j + 1]}))
                 {
                     return true;
                 }
+            }
+        }
         return false;
     }
 
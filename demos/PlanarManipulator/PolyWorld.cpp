@@ -117,6 +117,16 @@ ConvexPolygon::ConvexPolygon(const std::vector<Point> &coords)
         if (!equalPoints(q, coordinates_[0]))
             coordinates_.push_back(q);
     }
+
+    xMin_ = xMax_ = coordinates_[0].first;
+    yMin_ = yMax_ = coordinates_[0].second;
+    for (const Point &p : coordinates_)
+    {
+        xMin_ = std::min(xMin_, p.first);
+        xMax_ = std::max(xMax_, p.first);
+        yMin_ = std::min(yMin_, p.second);
+        yMax_ = std::max(yMax_, p.second);
+    }
 }
 
 // This algorithm originally came from PNPOLY:
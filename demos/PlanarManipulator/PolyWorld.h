@@ -37,6 +37,7 @@
 #ifndef POLYWORLD_H_
 #define POLYWORLD_H_
 
+#include <algorithm>
 #include <cmath>
 #include <string>
 #include <vector>
@@ -72,8 +73,19 @@ public:
     // Returns true if this polygon contains the given point.
     bool inside(Point point) const;
 
+    // Returns true if the bounding box of the segment p0-p1 overlaps the bounding box of this
+    // polygon grown by eps.  A cheap broad-phase test before inside() and edge intersections.
+    bool boundsOverlap(Point p0, Point p1, double eps = 1e-6) const
+    {
+        return std::max(p0.first, p1.first) >= xMin_ - eps && std::min(p0.first, p1.first) <= xMax_ + eps &&
+               std::max(p0.second, p1.second) >= yMin_ - eps && std::min(p0.second, p1.second) <= yMax_ + eps;
+    }
+
 private:
     std::vector<Point> coordinates_;
+
+    // Axis-aligned bounding box of the polygon
+    double xMin_, xMax_, yMin_, yMax_;
 };
 
 // A representation of a bounded planar world composed of polygonal obstacles.
@@ -323,6 +323,22 @@ class ompl_base_generator_t(code_generator_t):
                 EIGEN_ARRAY_CONVERTER(Eigen::VectorXd, 1)
             """)
             self.mb.add_registration_code('np::initialize();', tail=False)
+            # batch validity checking hands all states to Python as one NumPy array
+            self.add_function_wrapper(
+                'void(const Eigen::Ref<const Eigen::MatrixXd>&, Eigen::Ref<Eigen::VectorXd>)',
+                'BatchStateValidityCheckerFn', 'Batch state validity checker function')
+            self.add_function_wrapper(
+                'void(const Eigen::Ref<const Eigen::MatrixXd>&, const Eigen::Ref<const Eigen::VectorXd>&, '
+                'Eigen::Ref<Eigen::VectorXd>)',
+                'TimedBatchStateValidityCheckerFn', 'Batch state validity checker function with time stamps')
+            # BatchGoalFn has the type of BatchStateValidityCheckerFn, which is registered above
+            self.mb.add_registration_code("""
+                boost::python::def("BatchGoalFn", +[](boost::python::object o) -> ompl::base::BatchGoalFn
+                    {
+                        return detail::PyobjectInvoker<void(const Eigen::Ref<const Eigen::MatrixXd>&,
+                            Eigen::Ref<Eigen::VectorXd>)>(o);
+                    }, "Batch goal distance function");
+            """)
             self.add_array_access(self.ompl_ns.class_(
                 'ConstrainedStateSpace').class_('StateType'), 'double')
             # \todo: figure why commented-out code causes a problem.
@@ -551,6 +567,11 @@ class ompl_control_generator_t(code_generator_t):
             'void(const ompl::base::State*, const ompl::control::Control*, const double, '
             'ompl::base::State*)',
             'StatePropagatorFn', 'State propagator function')
+        # batch propagation hands all states and controls to Python as NumPy arrays
+        self.add_function_wrapper(
+            'void(const Eigen::Ref<const Eigen::MatrixXd>&, const Eigen::Ref<const Eigen::MatrixXd>&, double, '
+            'Eigen::Ref<Eigen::MatrixXd>)',
+            'BatchStatePropagatorFn', 'Batch state propagator function')
         self.add_function_wrapper('double(int, int)', 'EdgeCostFactorFn', \
             'Syclop edge cost factor function')
         self.add_function_wrapper('void(int, int, std::vector<int>&)', 'LeadComputeFn', \
@@ -935,6 +956,8 @@ class ompl_util_generator_t(code_generator_t):
                 'uniformProlateHyperspheroid').exclude()
         except declaration_not_found_t:
             pass
+        # the rate limiter is only used by the logging macros and holds atomics, which cannot be copied
+        self.ompl_ns.namespace('msg').class_('RateLimiter').exclude()
 
 class ompl_morse_generator_t(code_generator_t):
     def __init__(self):
@@ -52,6 +52,7 @@
 #include "ompl/base/Goal.h"
 #include "ompl/base/PlannerData.h"
 #include "py_std_function.hpp"
+#include "py_eigen_function.hpp"
 
 #define DeclareStateType(T) \
     inline int __dummy##T() \
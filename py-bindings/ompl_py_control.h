@@ -41,6 +41,7 @@
 #include "ompl/control/spaces/RealVectorControlSpace.h"
 #include "ompl/control/ODESolver.h"
 #include "py_std_function.hpp"
+#include "py_eigen_function.hpp"
 
 #define DeclareControlType(T) \
     inline int __dummy##T() \
@@ -0,0 +1,72 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2026, the MROR Multi-Robot OMPL contributors
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+/* Author: MROR Multi-Robot OMPL contributors */
+
+#ifndef PY_BINDINGS_PY_EIGEN_FUNCTION_
+#define PY_BINDINGS_PY_EIGEN_FUNCTION_
+
+#include "ompl/config.h"
+#include "py_std_function.hpp"
+
+#if OMPL_HAVE_NUMPY
+#include <Eigen/Core>
+
+namespace detail
+{
+    // Pass Eigen::Ref arguments of wrapped std::function's to Python by value. The converters
+    // registered in numpy_eigen.cpp turn them into NumPy arrays that share memory with the
+    // C++ matrix, so batch callbacks see all their states without any copies.
+    template <typename T>
+    struct WrapType<const Eigen::Ref<T> &>
+    {
+        using ArgType = const Eigen::Ref<T> &;
+        static inline Eigen::Ref<T> wrap(ArgType t)
+        {
+            return t;
+        }
+    };
+    template <typename T>
+    struct WrapType<Eigen::Ref<T>>
+    {
+        using ArgType = Eigen::Ref<T> &;
+        static inline Eigen::Ref<T> wrap(ArgType t)
+        {
+            return t;
+        }
+    };
+}  // namespace detail
+#endif
+
+#endif
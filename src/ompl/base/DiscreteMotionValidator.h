@@ -74,6 +74,11 @@ namespace ompl
             StateSpace *stateSpace_;
 
             void defaultSettings();
+
+            /** \brief Check all the states of the motion from \e s1 to \e s2, split in \e nd segments, with a
+                single call to StateValidityChecker::areValid(). Return the index (1 to \e nd) of the first invalid
+                state, or 0 if all states are valid. */
+            int firstInvalidState(const State *s1, const State *s2, int nd) const;
         };
     }
 }
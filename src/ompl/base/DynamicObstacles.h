@@ -0,0 +1,149 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2026, the MROR Multi-Robot OMPL contributors
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+/* Author: MROR Multi-Robot OMPL contributors */
+
+#ifndef OMPL_BASE_DYNAMIC_OBSTACLES_
+#define OMPL_BASE_DYNAMIC_OBSTACLES_
+
+#include "ompl/base/State.h"
+#include "ompl/util/ClassForward.h"
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ompl
+{
+    namespace base
+    {
+        /// @cond IGNORE
+        OMPL_CLASS_FORWARD(SpaceInformation);
+        OMPL_CLASS_FORWARD(StateSpace);
+        OMPL_CLASS_FORWARD(StateValidityChecker);
+        OMPL_CLASS_FORWARD(ReservationTable);
+        /** \brief Forward declaration of ompl::base::DynamicObstacles */
+        OMPL_CLASS_FORWARD(DynamicObstacles);
+        /// @endcond
+
+        /** \class ompl::base::DynamicObstaclesPtr
+            \brief A shared pointer wrapper for ompl::base::DynamicObstacles */
+
+        /** \brief A shared pointer to a set of dynamic obstacles that is no longer modified */
+        using DynamicObstaclesConstPtr = std::shared_ptr<const DynamicObstacles>;
+
+        /** \brief A set of dynamic obstacles: states of other systems at given times, and windows of
+            shared trajectories. A set is filled once and then only read, so any number of threads may
+            check states against it at the same time (see StateValidityChecker::isValid(const State *,
+            double, const DynamicObstacles &) and ScopedDynamicObstacles). Sets that only refer to
+            shared trajectories are cheap to create, so a planner can build one for every solve. */
+        class DynamicObstacles
+        {
+        public:
+            /** \brief A dynamic obstacle: a state and the space information it belongs to */
+            using Obstacle = std::pair<const SpaceInformationPtr, State *>;
+
+            /** \brief A sequence of states shared by the dynamic obstacles that refer to it */
+            using Trajectory = std::shared_ptr<const std::vector<State *>>;
+
+            DynamicObstacles() = default;
+            DynamicObstacles(const DynamicObstacles &) = delete;
+            DynamicObstacles &operator=(const DynamicObstacles &) = delete;
+
+            /** \brief Frees the states added with add(double, const SpaceInformationPtr &, State *) */
+            ~DynamicObstacles();
+
+            /** \brief Add \e state (of the space described by \e si) as an obstacle at \e time. The set
+                takes ownership of the state. */
+            void add(double time, const SpaceInformationPtr &si, State *state);
+
+            /** \brief Add a window of \e trajectory (of the space described by \e si) as a dynamic
+                obstacle. At time step k (time k * \e stepSize), for \e firstStep <= k <= \e lastStep, the
+                obstacle is at state k of the trajectory, or at its last state once the trajectory has
+                ended. The states are shared, not copied, so they must not change while the set is used. */
+            void add(double stepSize, unsigned int firstStep, unsigned int lastStep, const SpaceInformationPtr &si,
+                     const Trajectory &trajectory);
+
+            /** \brief Index the obstacle states in a space-time grid (see ReservationTable) with cells of
+                side \e cellSize, so that only obstacles within \e conflictRadius of a state are checked. A
+                \e cellSize of 0 disables the grid. */
+            void setReservationTable(double cellSize, double conflictRadius);
+
+            /** \brief Get the grid used to index obstacle states (nullptr if disabled) */
+            const ReservationTablePtr &getReservationTable() const
+            {
+                return reservations_;
+            }
+
+            /** \brief Return true if the set has no obstacles */
+            bool empty() const
+            {
+                return states_.empty() && trajectories_.empty();
+            }
+
+            /** \brief Remove (and free) all obstacles */
+            void clear();
+
+            /** \brief Return true if \e state (of space \e space) does not conflict with any of the
+                obstacles at \e time, according to StateValidityChecker::areStatesValid() of \e checker */
+            bool isValid(const StateValidityChecker &checker, const StateSpace *space, const State *state,
+                         double time) const;
+
+        protected:
+            /** \brief A window of a shared trajectory used as a dynamic obstacle */
+            struct TrajectoryObstacle
+            {
+                SpaceInformationPtr si;
+                Trajectory trajectory;
+                double stepSize;
+                unsigned int firstStep;
+                unsigned int lastStep;
+            };
+
+            /** \brief Times are rounded to multiples of 1 / TIME_SCALE to look up obstacle states */
+            static constexpr double TIME_SCALE = 1e5;
+
+            /** \brief The obstacle states at each (scaled) time */
+            std::unordered_map<int, std::vector<Obstacle>> states_;
+
+            /** \brief The trajectory windows */
+            std::vector<TrajectoryObstacle> trajectories_;
+
+            /** \brief Optional space-time grid indexing the states in states_ */
+            ReservationTablePtr reservations_;
+        };
+    }
+}
+
+#endif
@@ -127,6 +127,13 @@ namespace ompl
              *  isStartGoalPairValid() need not be called. */
             virtual bool isSatisfied(const State *st, double *distance) const;
 
+            /** \brief Check several states at once. \e satisfied[i] is set to a nonzero value if \e states[i]
+                satisfies the goal and \e distances[i] to its distance to the goal, as isSatisfied(const State *,
+                double *) would. Goals that check many states faster in one call override this; by default, the
+                states are checked one by one. */
+            virtual void areSatisfied(const std::vector<const State *> &states, std::vector<int> &satisfied,
+                                      std::vector<double> &distances) const;
+
             /** \brief Since there can be multiple starting states
                 (and multiple goal states) it is possible certain
                 pairs are not to be allowed. By default we however
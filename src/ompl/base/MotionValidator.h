@@ -39,6 +39,7 @@
 
 #include "ompl/base/State.h"
 #include "ompl/util/ClassForward.h"
+#include <atomic>
 #include <utility>
 
 namespace ompl
@@ -127,24 +128,26 @@ namespace ompl
             /** \brief Get the fraction of segments that tested as valid */
             double getValidMotionFraction() const
             {
-                return valid_ == 0 ? 0.0 : (double)valid_ / (double)(invalid_ + valid_);
+                unsigned int valid = valid_, invalid = invalid_;
+                return valid == 0 ? 0.0 : (double)valid / (double)(invalid + valid);
             }
 
             /** \brief Reset the counters for valid and invalid segments */
             void resetMotionCounter()
             {
-                valid_ = invalid_ = 0;
+                valid_ = 0;
+                invalid_ = 0;
             }
 
         protected:
             /** \brief The instance of space information this state validity checker operates on */
             SpaceInformation *si_;
 
-            /** \brief Number of valid segments */
-            mutable unsigned int valid_;
+            /** \brief Number of valid segments (motions may be checked from several threads) */
+            mutable std::atomic<unsigned int> valid_;
 
             /** \brief Number of invalid segments */
-            mutable unsigned int invalid_;
+            mutable std::atomic<unsigned int> invalid_;
         };
     }
 }
@@ -41,6 +41,7 @@
 #include "ompl/base/SpaceInformation.h"
 #include "ompl/base/ProblemDefinition.h"
 #include "ompl/base/PlannerData.h"
+#include "ompl/base/PlannerDataStream.h"
 #include "ompl/base/PlannerStatus.h"
 #include "ompl/base/PlannerTerminationCondition.h"
 #include "ompl/base/GenericParam.h"
@@ -309,6 +310,12 @@ namespace ompl
                 (without calling clear() in between).  */
             virtual void getPlannerData(PlannerData &data) const;
 
+            /** \brief Send the exploration datastructure of the planner to \e sink, one vertex and one edge at a
+                time. Unlike getPlannerData(), this does not need memory proportional to the size of the
+                datastructure if the planner overrides it. By default, the data filled by getPlannerData() is
+                sent as a section named after the planner. */
+            virtual void streamPlannerData(PlannerDataSink &sink) const;
+
             /** \brief Reconstructs the datastructures using information from data. 
                 This is planner specific and should be overridden. */
             virtual void setPlannerData(const PlannerData &data);
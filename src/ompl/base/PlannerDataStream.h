@@ -0,0 +1,205 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2026, the MROR Multi-Robot OMPL contributors
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+/* Author: MROR Multi-Robot OMPL contributors */
+
+#ifndef OMPL_BASE_PLANNER_DATA_STREAM_
+#define OMPL_BASE_PLANNER_DATA_STREAM_
+
+#include "ompl/base/StateSpace.h"
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace ompl
+{
+    namespace base
+    {
+        /// @cond IGNORE
+        OMPL_CLASS_FORWARD(PlannerData);
+        /// @endcond
+
+        /** \brief A visitor that receives the exploration datastructure of a planner one vertex and one edge at a
+            time (see Planner::streamPlannerData()). Unlike PlannerData, nothing is stored, so large trees can be
+            exported without copying them. Vertices are identified by ids that are unique within a section (the
+            addresses of the states or nodes), and an edge may be received before its vertices. The data is
+            grouped in sections (one per tree), which have a name and the state space of their vertices. */
+        class PlannerDataSink
+        {
+        public:
+            /** \brief The type of a vertex */
+            enum VertexType
+            {
+                PLAIN = 0,
+                START = 1,
+                GOAL = 2
+            };
+
+            virtual ~PlannerDataSink() = default;
+
+            /** \brief Begin a section of vertices of the state space \e space (nullptr for vertices without
+                states, such as the nodes of a constraint tree) */
+            virtual void beginSection(const std::string &name, const StateSpace *space) = 0;
+
+            /** \brief Receive a vertex. \e state is nullptr for vertices without states. */
+            virtual void vertex(std::uint64_t id, const State *state, VertexType type) = 0;
+
+            /** \brief Receive a directed edge */
+            virtual void edge(std::uint64_t from, std::uint64_t to) = 0;
+
+            /** \brief Receive a property of a vertex */
+            virtual void property(std::uint64_t id, const std::string &name, const std::string &value) = 0;
+
+            /** \brief End the current section */
+            virtual void endSection() = 0;
+
+            /** \brief The id of the vertex of an object (a state or a node) */
+            static std::uint64_t idOf(const void *object)
+            {
+                return reinterpret_cast<std::uintptr_t>(object);
+            }
+
+            /** \brief Send the vertices and edges of \e data as a section called \e name */
+            void write(const std::string &name, const PlannerData &data);
+        };
+
+        /** \brief A sink that forwards everything to another sink, prefixing the names of the sections */
+        class PrefixedPlannerDataSink : public PlannerDataSink
+        {
+        public:
+            PrefixedPlannerDataSink(PlannerDataSink &sink, std::string prefix) : sink_(sink), prefix_(std::move(prefix))
+            {
+            }
+
+            void beginSection(const std::string &name, const StateSpace *space) override
+            {
+                sink_.beginSection(prefix_ + name, space);
+            }
+
+            void vertex(std::uint64_t id, const State *state, VertexType type) override
+            {
+                sink_.vertex(id, state, type);
+            }
+
+            void edge(std::uint64_t from, std::uint64_t to) override
+            {
+                sink_.edge(from, to);
+            }
+
+            void property(std::uint64_t id, const std::string &name, const std::string &value) override
+            {
+                sink_.property(id, name, value);
+            }
+
+            void endSection() override
+            {
+                sink_.endSection();
+            }
+
+        private:
+            PlannerDataSink &sink_;
+            std::string prefix_;
+        };
+
+        /** \brief A sink that writes a compact binary stream: a tagged record per section, vertex, edge and
+            property, with the states written as their real values (see StateSpace::copyToReals()) in native
+            byte order. The stream can be read back with PlannerDataBinaryReader. */
+        class PlannerDataBinaryWriter : public PlannerDataSink
+        {
+        public:
+            /** \brief Write to \e out. The header is written right away. */
+            PlannerDataBinaryWriter(std::ostream &out);
+
+            void beginSection(const std::string &name, const StateSpace *space) override;
+
+            void vertex(std::uint64_t id, const State *state, VertexType type) override;
+
+            void edge(std::uint64_t from, std::uint64_t to) override;
+
+            void property(std::uint64_t id, const std::string &name, const std::string &value) override;
+
+            void endSection() override;
+
+        private:
+            void writeString(const std::string &s);
+
+            template <typename T>
+            void writeValue(const T &value)
+            {
+                out_.write(reinterpret_cast<const char *>(&value), sizeof(T));
+            }
+
+            std::ostream &out_;
+
+            /** \brief The state space of the current section */
+            const StateSpace *space_{nullptr};
+
+            /** \brief Buffer for the real values of a state */
+            std::vector<double> reals_;
+        };
+
+        /** \brief Reads a stream written by PlannerDataBinaryWriter and sends its contents to a sink */
+        class PlannerDataBinaryReader
+        {
+        public:
+            /** \brief Function that returns the state space with a given name (see StateSpace::getName()). It may
+                return nullptr, in which case the vertices of the section are received without states. */
+            using SpaceLookup = std::function<StateSpacePtr(const std::string &)>;
+
+            /** \brief Read from \e in */
+            PlannerDataBinaryReader(std::istream &in) : in_(in)
+            {
+            }
+
+            /** \brief Read the whole stream and send it to \e sink. States are allocated in the spaces given by
+                \e spaces. Returns false if the stream is malformed. */
+            bool read(PlannerDataSink &sink, const SpaceLookup &spaces);
+
+        private:
+            bool readString(std::string &s);
+
+            template <typename T>
+            bool readValue(T &value)
+            {
+                return static_cast<bool>(in_.read(reinterpret_cast<char *>(&value), sizeof(T)));
+            }
+
+            std::istream &in_;
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,153 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2026, the MROR Multi-Robot OMPL contributors
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+/* Author: MROR Multi-Robot OMPL contributors */
+
+#ifndef OMPL_BASE_RESERVATION_TABLE_
+#define OMPL_BASE_RESERVATION_TABLE_
+
+#include "ompl/base/State.h"
+#include "ompl/util/ClassForward.h"
+#include <Eigen/Core>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ompl
+{
+    namespace base
+    {
+        /// @cond IGNORE
+        OMPL_CLASS_FORWARD(SpaceInformation);
+        OMPL_CLASS_FORWARD(StateSpace);
+        OMPL_CLASS_FORWARD(ProjectionEvaluator);
+        /** \brief Forward declaration of ompl::base::ReservationTable */
+        OMPL_CLASS_FORWARD(ReservationTable);
+        /// @endcond
+
+        /** \class ompl::base::ReservationTablePtr
+            \brief A shared pointer wrapper for ompl::base::ReservationTable */
+
+        /** \brief A space-time occupancy grid of dynamic obstacles. Obstacle states are
+            placed, by their default projection, in every grid cell within a conflict radius,
+            at their time step. A state can then only conflict with the obstacles stored in
+            its own cell at the same time step, and a state whose cell is empty is free of
+            dynamic obstacles without any further checks. The default projections of all
+            spaces involved must map to the same workspace coordinates (e.g., the position
+            of each robot), and the conflict radius must bound the distance between the
+            projections of any two conflicting states. */
+        class ReservationTable
+        {
+        public:
+            /** \brief A dynamic obstacle: a state and the space information it belongs to */
+            using Obstacle = std::pair<const SpaceInformationPtr, State *>;
+
+            /** \brief Constructor. \e cellSize is the side length of a grid cell and
+                \e conflictRadius the distance within which states may conflict. */
+            ReservationTable(double cellSize, double conflictRadius);
+
+            /** \brief Reserve the cells around \e obstacle at time step \e timeKey */
+            void add(int timeKey, const Obstacle &obstacle);
+
+            /** \brief Return the obstacles that may conflict with \e state (of space \e space)
+                at time step \e timeKey, or nullptr if there are none. Once all obstacles are
+                added, this may be called from several threads at the same time. */
+            const std::vector<Obstacle> *find(int timeKey, const State *state, const StateSpace *space) const;
+
+            /** \brief Remove all reservations */
+            void clear();
+
+            /** \brief Return the number of reserved (cell, time step) pairs */
+            std::size_t size() const
+            {
+                return cells_.size();
+            }
+
+            /** \brief Get the side length of a grid cell */
+            double getCellSize() const
+            {
+                return cellSize_;
+            }
+
+            /** \brief Get the distance within which states may conflict */
+            double getConflictRadius() const
+            {
+                return conflictRadius_;
+            }
+
+        protected:
+            /** \brief The maximum number of projection coordinates used to index cells.
+                Further coordinates are ignored, which only makes cells larger. */
+            static const unsigned int MAX_DIM = 3;
+
+            /** \brief A grid cell at a time step */
+            struct Key
+            {
+                int time;
+                int cell[MAX_DIM];
+
+                bool operator==(const Key &other) const
+                {
+                    return time == other.time && cell[0] == other.cell[0] && cell[1] == other.cell[1] &&
+                           cell[2] == other.cell[2];
+                }
+            };
+
+            /** \brief Hash function for Key */
+            struct KeyHash
+            {
+                std::size_t operator()(const Key &key) const;
+            };
+
+            /** \brief Compute the default projection of \e state into \e projection and
+                return the number of coordinates used */
+            unsigned int project(const State *state, const StateSpace *space, Eigen::VectorXd &projection) const;
+
+            /** \brief The side length of a grid cell */
+            double cellSize_;
+
+            /** \brief The distance within which states may conflict */
+            double conflictRadius_;
+
+            /** \brief The obstacles reserving each cell at each time step */
+            std::unordered_map<Key, std::vector<Obstacle>, KeyHash> cells_;
+
+            /** \brief The default projection of each state space of the obstacles added so far */
+            std::unordered_map<const StateSpace *, ProjectionEvaluatorPtr> projections_;
+        };
+    }
+}
+
+#endif
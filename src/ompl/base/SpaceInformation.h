@@ -47,6 +47,7 @@
 #include "ompl/util/Console.h"
 #include "ompl/util/Exception.h"
 
+#include <Eigen/Core>
 #include <functional>
 #include <utility>
 #include <cstdlib>
@@ -74,6 +75,18 @@ namespace ompl
             instead */
         using StateValidityCheckerFn = std::function<bool(const State *)>;
 
+        /** \brief A std::function that checks many states in one call. Row \e i of \e states holds the real values
+            of the i-th state (see StateSpace::copyToReals()); the function sets \e valid(i) to a nonzero value if
+            that state is valid and to 0 otherwise. This allows vectorised checks, e.g., from Python with NumPy. */
+        using BatchStateValidityCheckerFn =
+            std::function<void(const Eigen::Ref<const Eigen::MatrixXd> &states, Eigen::Ref<Eigen::VectorXd> valid)>;
+
+        /** \brief Like BatchStateValidityCheckerFn, but also receives the time stamp of each state in \e times.
+            Times are NaN when the states are checked without a time (e.g., by geometric planners). */
+        using TimedBatchStateValidityCheckerFn =
+            std::function<void(const Eigen::Ref<const Eigen::MatrixXd> &states,
+                               const Eigen::Ref<const Eigen::VectorXd> &times, Eigen::Ref<Eigen::VectorXd> valid)>;
+
         /** \brief The base class for space information. This contains
             all the information about the space planning is done in.
             setup() needs to be called as well, before use */
@@ -101,18 +114,38 @@ namespace ompl
                 return stateValidityChecker_->isValid(state, time);
             }
 
+            /** \brief Check if a given state is valid while accounting for the dynamic obstacles in \e obstacles */
+            bool isValid(const State *state, const double time, const DynamicObstacles &obstacles) const
+            {
+                return stateValidityChecker_->isValid(state, time, obstacles);
+            }
+
             /** \brief method to add a dynamic obstacle */
             void addDynamicObstacle(const double time, const SpaceInformationPtr si, State* state)
             {
                 stateValidityChecker_->addDynamicObstacle(time, si, state);
             }
 
+            /** \brief Add a window of a shared trajectory as a dynamic obstacle (see
+                StateValidityChecker::addDynamicObstacle()) */
+            void addDynamicObstacle(double stepSize, unsigned int firstStep, unsigned int lastStep,
+                                    const SpaceInformationPtr &si, const StateValidityChecker::Trajectory &trajectory)
+            {
+                stateValidityChecker_->addDynamicObstacle(stepSize, firstStep, lastStep, si, trajectory);
+            }
+
             /** \brief clear the dynamicObstacle map */
             void clearDynamicObstacles()
             {
                 stateValidityChecker_->clearDynamicObstacles();
             }
 
+            /** \brief Index dynamic obstacles in a space-time grid (see StateValidityChecker::setReservationTable()) */
+            void setReservationTable(double cellSize, double conflictRadius)
+            {
+                stateValidityChecker_->setReservationTable(cellSize, conflictRadius);
+            }
+
             /** \brief Return the instance of the used state space */
             const StateSpacePtr &getStateSpace() const
             {
@@ -173,6 +206,16 @@ namespace ompl
                 since there is one more level of indirection */
             void setStateValidityChecker(const StateValidityCheckerFn &svc);
 
+            /** \brief Set a function that checks the validity of many states in one call. Motion validation
+                passes all the states along a motion to a single call of this function. */
+            void setBatchStateValidityChecker(const BatchStateValidityCheckerFn &svc);
+
+            /** \brief Set a function that checks the validity of many time-stamped states in one call. Control
+                planners propagating with time (see control::SpaceInformation::propagateWhileValidTest()) pass all
+                the states of a propagation to a single call, along with their times. Dynamic obstacles are still
+                checked in C++ after the function returns. */
+            void setBatchStateValidityChecker(const TimedBatchStateValidityCheckerFn &svc);
+
             /** \brief Return the instance of the used state validity checker */
             const StateValidityCheckerPtr &getStateValidityChecker() const
             {
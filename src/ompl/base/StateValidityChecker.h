@@ -39,7 +39,9 @@
 #define OMPL_BASE_STATE_VALIDITY_CHECKER_
 
 #include "ompl/base/State.h"
+#include "ompl/base/DynamicObstacles.h"
 #include "ompl/util/ClassForward.h"
+#include <memory>
 #include <unordered_map>
 #include <vector>
 #include <limits>
@@ -88,6 +90,11 @@ namespace ompl
             /** \brief Flag indicating that this state validity checker can return
                 a direction that moves a state away from being invalid. */
             bool hasValidDirectionComputation{false};
+
+            /** \brief Flag indicating that this state validity checker evaluates
+                many states in one call to StateValidityChecker::areValid() faster
+                than it evaluates them one at a time. */
+            bool hasBatchValidityComputation{false};
         };
 
         /** \brief Abstract definition for a class checking the
@@ -97,12 +104,14 @@ namespace ompl
         {
         public:
             /** \brief Constructor */
-            StateValidityChecker(SpaceInformation *si) : si_(si)
+            StateValidityChecker(SpaceInformation *si)
+              : si_(si), dynamicObstacles_(std::make_shared<DynamicObstacles>())
             {
             }
 
             /** \brief Constructor */
-            StateValidityChecker(const SpaceInformationPtr &si) : si_(si.get())
+            StateValidityChecker(const SpaceInformationPtr &si)
+              : si_(si.get()), dynamicObstacles_(std::make_shared<DynamicObstacles>())
             {
             }
 
@@ -124,9 +133,28 @@ namespace ompl
                 return isValid(state);
             }
 
-            /** \brief Return true if the state is valid while accounting for dynamic obstacles */
+            /** \brief Check the validity of several states at once: \e valid[i] is set to 1 if \e states[i] is
+                valid and to 0 otherwise. By default, isValid() is called for each state. Checkers that can evaluate
+                many states together should override this function and set
+                StateValidityCheckerSpecs::hasBatchValidityComputation. */
+            virtual void areValid(const std::vector<const State *> &states, std::vector<int> &valid) const;
+
+            /** \brief Check the validity of several states at the given \e times while accounting for dynamic
+                obstacles (see isValid(const State*, double)). If
+                StateValidityCheckerSpecs::hasBatchValidityComputation is set, the states are checked with a
+                single call to areValid() and then against the dynamic obstacles; otherwise isValid(state, time)
+                is called for each state. */
+            virtual void areValid(const std::vector<const State *> &states, const std::vector<double> &times,
+                                  std::vector<int> &valid);
+
+            /** \brief Return true if the state is valid while accounting for dynamic obstacles. The obstacles
+                are those bound to this checker on the calling thread by a ScopedDynamicObstacles, if any, and
+                otherwise the ones added to this checker with addDynamicObstacle(). */
             virtual bool isValid(const State *state, const double time);
 
+            /** \brief Return true if the state is valid while accounting for the dynamic obstacles in \e obstacles */
+            bool isValid(const State *state, double time, const DynamicObstacles &obstacles) const;
+
             /** \brief Function that always return true. This must be overridden when planning for dynamic obstacles */
             virtual bool areStatesValid(const State *state1, const std::pair<const SpaceInformationPtr,const State*> state2) const
             {
@@ -134,15 +162,88 @@ namespace ompl
             }
 
             /** \brief Add a dynamic obstacle */
-            void addDynamicObstacle(const double time, const SpaceInformationPtr &si, State* state)
-            {
-                int key = std::round(time * scalingFactor_);
-                dynObstacles_[key].push_back(std::make_pair(si, state));
-            }
+            void addDynamicObstacle(const double time, const SpaceInformationPtr &si, State* state);
+
+            /** \brief A sequence of states shared by the dynamic obstacles that refer to it */
+            using Trajectory = DynamicObstacles::Trajectory;
+
+            /** \brief Add a window of \e trajectory (of the space described by \e si) as a dynamic obstacle. At
+                time step k (time k * \e stepSize), for \e firstStep <= k <= \e lastStep, the obstacle is at state k
+                of the trajectory, or at its last state once the trajectory has ended. The states are shared, not
+                copied, so they must not change while the obstacle is in use. */
+            void addDynamicObstacle(double stepSize, unsigned int firstStep, unsigned int lastStep,
+                                    const SpaceInformationPtr &si, const Trajectory &trajectory);
 
             /** \brief clear the dynamicObstacle map */
             void clearDynamicObstacles();
 
+            /** \brief Index dynamic obstacles in a space-time grid (see ReservationTable) with cells of side
+                \e cellSize, so that isValid(state, time) only calls areStatesValid() for obstacles within
+                \e conflictRadius of \e state. A \e cellSize of 0 disables the grid. */
+            void setReservationTable(double cellSize, double conflictRadius);
+
+            /** \brief Get the grid used to index dynamic obstacles (nullptr if disabled) */
+            const ReservationTablePtr &getReservationTable() const
+            {
+                return dynamicObstacles_->getReservationTable();
+            }
+
+            /** \brief Get the dynamic obstacles isValid(state, time) uses on the calling thread: those of the
+                innermost ScopedDynamicObstacles for this checker, if any, and otherwise the ones added to it */
+            const DynamicObstacles &getCurrentDynamicObstacles() const;
+
+            /** \brief Get the dynamic obstacles added to this checker */
+            const DynamicObstaclesPtr &getDynamicObstacles() const
+            {
+                return dynamicObstacles_;
+            }
+
+            /** \brief While an instance of this class is alive, isValid(state, time) of \e checker uses
+                \e obstacles instead of the obstacles added to the checker, on the thread that created the
+                instance only. Other threads can thus plan with the same checker against different obstacles
+                at the same time. Instances must be destroyed in the reverse order of their creation.
+
+                Worker threads started by a planner do not see the instances of the thread that called solve():
+                a planner that checks states on its own threads passes them on with Inherit (RRTstar, FMT and XXL
+                do so when they use several threads). */
+            class ScopedDynamicObstacles
+            {
+            public:
+                ScopedDynamicObstacles(const StateValidityChecker &checker, DynamicObstaclesConstPtr obstacles);
+
+                ~ScopedDynamicObstacles();
+
+                ScopedDynamicObstacles(const ScopedDynamicObstacles &) = delete;
+                ScopedDynamicObstacles &operator=(const ScopedDynamicObstacles &) = delete;
+
+                /** \brief Get the innermost instance of the calling thread (nullptr if there is none) */
+                static const ScopedDynamicObstacles *current();
+
+                /** \brief While an instance of this class is alive, the calling thread uses the instances that
+                    were alive on another thread when that thread called current(). They must outlive the
+                    Inherit, e.g. because the other thread waits for the worker that created it. */
+                class Inherit
+                {
+                public:
+                    explicit Inherit(const ScopedDynamicObstacles *scope);
+
+                    ~Inherit();
+
+                    Inherit(const Inherit &) = delete;
+                    Inherit &operator=(const Inherit &) = delete;
+
+                private:
+                    const ScopedDynamicObstacles *previous_;
+                };
+
+            private:
+                friend class StateValidityChecker;
+
+                const StateValidityChecker *checker_;
+                DynamicObstaclesConstPtr obstacles_;
+                const ScopedDynamicObstacles *previous_;
+            };
+
             /** \brief Return true if the state \e state is valid. In addition, set \e dist to the distance to the
                nearest
                 invalid state (using clearance()). If a direction that moves \e state away from being invalid is
@@ -196,11 +297,8 @@ namespace ompl
             /** \brief The specifications of the state validity checker (its capabilities) */
             StateValidityCheckerSpecs specs_;
 
-            /** \brief A hash table that maps time steps (keys) to the values (states) that must be accounted for inside isValid() */
-            std::unordered_map<int, std::vector<std::pair<const SpaceInformationPtr, State*>> > dynObstacles_;
-
-            /** the scaling factor for dynamic obstacles, this will work in most */
-            int scalingFactor_ = 1e5;
+            /** \brief The dynamic obstacles used by isValid(state, time) outside of a ScopedDynamicObstacles */
+            DynamicObstaclesPtr dynamicObstacles_;
         };
 
         /** \brief The simplest state validity checker: all states are valid */
@@ -0,0 +1,80 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2026, the MROR Multi-Robot OMPL contributors
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+/* Author: MROR Multi-Robot OMPL contributors */
+
+#ifndef OMPL_BASE_GOALS_BATCH_GOAL_REGION_
+#define OMPL_BASE_GOALS_BATCH_GOAL_REGION_
+
+#include "ompl/base/goals/GoalRegion.h"
+#include <Eigen/Core>
+#include <functional>
+
+namespace ompl
+{
+    namespace base
+    {
+        /** \brief A std::function that computes the distance to the goal of many states in one call. Row \e i of
+            \e states holds the real values of the i-th state (see StateSpace::copyToReals()); the function sets
+            \e distances(i) to the distance of that state to the goal. This allows vectorised goal checks, e.g.,
+            from Python with NumPy. */
+        using BatchGoalFn =
+            std::function<void(const Eigen::Ref<const Eigen::MatrixXd> &states, Eigen::Ref<Eigen::VectorXd> distances)>;
+
+        /** \brief A goal region whose distance to the goal is computed by a BatchGoalFn. Planners that check
+            several states against the goal at once (see Goal::areSatisfied()) make a single call for all of
+            them. */
+        class BatchGoalRegion : public GoalRegion
+        {
+        public:
+            /** \brief Create a goal region whose distances are computed by \e fn */
+            BatchGoalRegion(const SpaceInformationPtr &si, BatchGoalFn fn);
+
+            ~BatchGoalRegion() override = default;
+
+            /** \brief Compute the distance to the goal with a call to the function for a single state */
+            double distanceGoal(const State *st) const override;
+
+            /** \brief Compute the distances of all the states with a single call to the function */
+            void areSatisfied(const std::vector<const State *> &states, std::vector<int> &satisfied,
+                              std::vector<double> &distances) const override;
+
+        protected:
+            /** \brief The function computing the distances to the goal */
+            BatchGoalFn fn_;
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,78 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2026, the MROR Multi-Robot OMPL contributors
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+/* Author: MROR Multi-Robot OMPL contributors */
+
+#include "ompl/base/goals/BatchGoalRegion.h"
+#include "ompl/base/SpaceInformation.h"
+#include "ompl/util/Exception.h"
+#include <utility>
+
+ompl::base::BatchGoalRegion::BatchGoalRegion(const SpaceInformationPtr &si, BatchGoalFn fn)
+  : GoalRegion(si), fn_(std::move(fn))
+{
+    if (!fn_)
+        throw Exception("Invalid function definition for batch goal checking");
+}
+
+double ompl::base::BatchGoalRegion::distanceGoal(const State *st) const
+{
+    std::vector<int> satisfied;
+    std::vector<double> distances;
+    BatchGoalRegion::areSatisfied(std::vector<const State *>(1, st), satisfied, distances);
+    return distances[0];
+}
+
+void ompl::base::BatchGoalRegion::areSatisfied(const std::vector<const State *> &states, std::vector<int> &satisfied,
+                                               std::vector<double> &distances) const
+{
+    satisfied.resize(states.size());
+    distances.resize(states.size());
+    if (states.empty())
+        return;
+    std::vector<double> reals;
+    const StateSpace *space = si_->getStateSpace().get();
+    space->copyToReals(reals, states[0]);
+    Eigen::MatrixXd values(states.size(), reals.size());
+    for (std::size_t i = 0; i < states.size(); ++i)
+    {
+        if (i > 0)
+            space->copyToReals(reals, states[i]);
+        values.row(i) = Eigen::Map<const Eigen::RowVectorXd>(reals.data(), reals.size());
+    }
+    Eigen::Map<Eigen::VectorXd> result(distances.data(), distances.size());
+    fn_(values, result);
+    for (std::size_t i = 0; i < states.size(); ++i)
+        satisfied[i] = distances[i] < threshold_ ? 1 : 0;
+}
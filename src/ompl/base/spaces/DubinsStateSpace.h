@@ -112,8 +112,21 @@ namespace ompl
                 return false;
             }
 
+            /** \brief Get the turning radius */
+            double getTurningRadius() const
+            {
+                return rho_;
+            }
+
             double distance(const State *state1, const State *state2) const override;
 
+            /** \brief Compute the distances from \e from to each of the states in \e to. This gives the same
+                results as distance(), but evaluates the Dubins words for all targets in one pass. */
+            void distances(const State *from, const std::vector<const State *> &to, std::vector<double> &result) const;
+
+            /** \brief Compute the distances from each of the states in \e from to \e to, in one pass as above */
+            void distances(const std::vector<const State *> &from, const State *to, std::vector<double> &result) const;
+
             void interpolate(const State *from, const State *to, double t, State *state) const override;
             virtual void interpolate(const State *from, const State *to, double t, bool &firstTime,
                                      DubinsPath &path, State *state) const;
@@ -146,6 +159,13 @@ namespace ompl
         protected:
             virtual void interpolate(const State *from, const DubinsPath &path, double t, State *state) const;
 
+            /** \brief Return the path that distance() and interpolate() follow from \e from to \e to: the
+                shortest Dubins path, or the reverse of the shortest path from \e to to \e from, if that is
+                shorter and the distance is symmetric. The last path computed in each thread is cached, so that
+                distance computations, motion validation and interpolation along the same motion compute the
+                path only once. */
+            DubinsPath shortestPath(const State *from, const State *to) const;
+
             /** \brief Turning radius */
             double rho_;
 
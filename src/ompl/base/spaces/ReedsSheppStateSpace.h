@@ -98,6 +98,12 @@ namespace ompl
                 type_ = STATE_SPACE_REEDS_SHEPP;
             }
 
+            /** \brief Get the turning radius */
+            double getTurningRadius() const
+            {
+                return rho_;
+            }
+
             double distance(const State *state1, const State *state2) const override;
             unsigned int validSegmentCount(const State *state1, const State *state2) const override
             {
@@ -122,6 +128,11 @@ namespace ompl
         protected:
             virtual void interpolate(const State *from, const ReedsSheppPath &path, double t, State *state) const;
 
+            /** \brief Return reedsShepp(\e state1, \e state2), computing it only if it is not the last path
+                computed in this thread. Distance computations, motion validation and interpolation along the same
+                motion thus compute the path only once. */
+            ReedsSheppPath cachedReedsShepp(const State *state1, const State *state2) const;
+
             /** \brief Turning radius */
             double rho_;
         };
@@ -211,6 +211,11 @@ ompl::base::AtlasStateSpace::AtlasStateSpace(const StateSpacePtr &ambientSpace,
 
     chartNN_.setDistanceFunction(
         [&](const NNElement &e1, const NNElement &e2) -> double { return distance(e1.first, e2.first); });
+    // charts are points of the ambient space; when it is R^n, pivots can be selected with Euclidean distances
+    // computed directly on the coordinates
+    if (space_->getType() == STATE_SPACE_REAL_VECTOR)
+        chartNN_.getPivotSelector().setBatchDistanceFunction(GreedyKCenters<NNElement>::euclideanDistances(
+            [](const NNElement &e) { return e.first->data(); }, n_));
 }
 
 ompl::base::AtlasStateSpace::~AtlasStateSpace()
@@ -37,6 +37,7 @@
 #include "ompl/base/spaces/DubinsStateSpace.h"
 #include "ompl/base/SpaceInformation.h"
 #include "ompl/util/Exception.h"
+#include <algorithm>
 #include <queue>
 #include <boost/math/constants/constants.hpp>
 
@@ -57,9 +58,9 @@ namespace
         return xm;
     }
 
-    DubinsStateSpace::DubinsPath dubinsLSL(double d, double alpha, double beta)
+    DubinsStateSpace::DubinsPath dubinsLSL(double d, double alpha, double beta, double ca, double sa, double cb,
+                                             double sb)
     {
-        double ca = cos(alpha), sa = sin(alpha), cb = cos(beta), sb = sin(beta);
         double tmp = 2. + d * d - 2. * (ca * cb + sa * sb - d * (sa - sb));
         if (tmp >= DUBINS_ZERO)
         {
@@ -75,9 +76,9 @@ namespace
         return {};
     }
 
-    DubinsStateSpace::DubinsPath dubinsRSR(double d, double alpha, double beta)
+    DubinsStateSpace::DubinsPath dubinsRSR(double d, double alpha, double beta, double ca, double sa, double cb,
+                                             double sb)
     {
-        double ca = cos(alpha), sa = sin(alpha), cb = cos(beta), sb = sin(beta);
         double tmp = 2. + d * d - 2. * (ca * cb + sa * sb - d * (sb - sa));
         if (tmp >= DUBINS_ZERO)
         {
@@ -93,9 +94,9 @@ namespace
         return {};
     }
 
-    DubinsStateSpace::DubinsPath dubinsRSL(double d, double alpha, double beta)
+    DubinsStateSpace::DubinsPath dubinsRSL(double d, double alpha, double beta, double ca, double sa, double cb,
+                                             double sb)
     {
-        double ca = cos(alpha), sa = sin(alpha), cb = cos(beta), sb = sin(beta);
         double tmp = d * d - 2. + 2. * (ca * cb + sa * sb - d * (sa + sb));
         if (tmp >= DUBINS_ZERO)
         {
@@ -111,9 +112,9 @@ namespace
         return {};
     }
 
-    DubinsStateSpace::DubinsPath dubinsLSR(double d, double alpha, double beta)
+    DubinsStateSpace::DubinsPath dubinsLSR(double d, double alpha, double beta, double ca, double sa, double cb,
+                                             double sb)
     {
-        double ca = cos(alpha), sa = sin(alpha), cb = cos(beta), sb = sin(beta);
         double tmp = -2. + d * d + 2. * (ca * cb + sa * sb + d * (sa + sb));
         if (tmp >= DUBINS_ZERO)
         {
@@ -129,9 +130,9 @@ namespace
         return {};
     }
 
-    DubinsStateSpace::DubinsPath dubinsRLR(double d, double alpha, double beta)
+    DubinsStateSpace::DubinsPath dubinsRLR(double d, double alpha, double beta, double ca, double sa, double cb,
+                                             double sb)
     {
-        double ca = cos(alpha), sa = sin(alpha), cb = cos(beta), sb = sin(beta);
         double tmp = .125 * (6. - d * d + 2. * (ca * cb + sa * sb + d * (sa - sb)));
         if (fabs(tmp) < 1.)
         {
@@ -147,9 +148,9 @@ namespace
         return {};
     }
 
-    DubinsStateSpace::DubinsPath dubinsLRL(double d, double alpha, double beta)
+    DubinsStateSpace::DubinsPath dubinsLRL(double d, double alpha, double beta, double ca, double sa, double cb,
+                                             double sb)
     {
-        double ca = cos(alpha), sa = sin(alpha), cb = cos(beta), sb = sin(beta);
         double tmp = .125 * (6. - d * d + 2. * (ca * cb + sa * sb - d * (sa - sb)));
         if (fabs(tmp) < 1.)
         {
@@ -165,12 +166,15 @@ namespace
         return {};
     }
 
-    DubinsStateSpace::DubinsPath dubins(double d, double alpha, double beta)
+    // the trigonometric functions of alpha and beta are shared by all words
+    DubinsStateSpace::DubinsPath dubins(double d, double alpha, double beta, double ca, double sa, double cb,
+                                        double sb)
     {
         if (d < DUBINS_EPS && fabs(alpha - beta) < DUBINS_EPS)
             return {DubinsStateSpace::dubinsPathType[0], 0, d, 0};
 
-        DubinsStateSpace::DubinsPath path(dubinsLSL(d, alpha, beta)), tmp(dubinsRSR(d, alpha, beta));
+        DubinsStateSpace::DubinsPath path(dubinsLSL(d, alpha, beta, ca, sa, cb, sb)),
+            tmp(dubinsRSR(d, alpha, beta, ca, sa, cb, sb));
         double len, minLength = path.length();
 
         if ((len = tmp.length()) < minLength)
@@ -178,29 +182,77 @@ namespace
             minLength = len;
             path = tmp;
         }
-        tmp = dubinsRSL(d, alpha, beta);
+        tmp = dubinsRSL(d, alpha, beta, ca, sa, cb, sb);
         if ((len = tmp.length()) < minLength)
         {
             minLength = len;
             path = tmp;
         }
-        tmp = dubinsLSR(d, alpha, beta);
+        tmp = dubinsLSR(d, alpha, beta, ca, sa, cb, sb);
         if ((len = tmp.length()) < minLength)
         {
             minLength = len;
             path = tmp;
         }
-        tmp = dubinsRLR(d, alpha, beta);
+        tmp = dubinsRLR(d, alpha, beta, ca, sa, cb, sb);
         if ((len = tmp.length()) < minLength)
         {
             minLength = len;
             path = tmp;
         }
-        tmp = dubinsLRL(d, alpha, beta);
+        tmp = dubinsLRL(d, alpha, beta, ca, sa, cb, sb);
         if ((len = tmp.length()) < minLength)
             path = tmp;
         return path;
     }
+
+    DubinsStateSpace::DubinsPath dubins(double d, double alpha, double beta)
+    {
+        return dubins(d, alpha, beta, cos(alpha), sin(alpha), cos(beta), sin(beta));
+    }
+
+    /* Compute the lengths of the shortest paths from (0, 0, th1[i]) to (dx[i], dy[i], th2[i]) for all i, scaled by
+       rho. The states are given as arrays (structure of arrays), so that the arithmetic of the loops can be
+       vectorized. */
+    void dubinsLengths(const std::vector<double> &dx, const std::vector<double> &dy, const std::vector<double> &th1,
+                       const std::vector<double> &th2, double rho, bool symmetric, std::vector<double> &result)
+    {
+        const std::size_t n = dx.size();
+        std::vector<double> d(n), th(n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            d[i] = sqrt(dx[i] * dx[i] + dy[i] * dy[i]) / rho;
+            th[i] = atan2(dy[i], dx[i]);
+        }
+
+        // all six words share the trigonometric functions of the angles relative to the line between the states
+        const double pi = boost::math::constants::pi<double>();
+        result.resize(n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            double alpha = mod2pi(th1[i] - th[i]), beta = mod2pi(th2[i] - th[i]);
+            double length = dubins(d[i], alpha, beta, cos(alpha), sin(alpha), cos(beta), sin(beta)).length();
+            if (symmetric)
+            {
+                // the reverse motion sees the line between the states rotated by pi
+                double ralpha = mod2pi(th2[i] - th[i] - pi), rbeta = mod2pi(th1[i] - th[i] - pi);
+                length = std::min(length, dubins(d[i], ralpha, rbeta, cos(ralpha), sin(ralpha), cos(rbeta),
+                                                 sin(rbeta)).length());
+            }
+            result[i] = rho * length;
+        }
+    }
+
+    /* The last path computed by each thread, for the states it connects. Distance computations, motion
+       validation and interpolation usually ask for the same path several times in a row. */
+    struct DubinsPathCache
+    {
+        const DubinsStateSpace *space{nullptr};
+        double key[8];
+        DubinsStateSpace::DubinsPath path;
+    };
+
+    thread_local DubinsPathCache dubinsPathCache;
 }
 
 const ompl::base::DubinsStateSpace::DubinsPathSegmentType ompl::base::DubinsStateSpace::dubinsPathType[6][3] = {
@@ -213,9 +265,67 @@ const ompl::base::DubinsStateSpace::DubinsPathSegmentType ompl::base::DubinsStat
 
 double ompl::base::DubinsStateSpace::distance(const State *state1, const State *state2) const
 {
+    return rho_ * shortestPath(state1, state2).length();
+}
+
+void ompl::base::DubinsStateSpace::distances(const State *from, const std::vector<const State *> &to,
+                                             std::vector<double> &result) const
+{
+    const std::size_t n = to.size();
+    const auto *s1 = from->as<StateType>();
+    std::vector<double> dx(n), dy(n), th1(n, s1->getYaw()), th2(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const auto *s2 = to[i]->as<StateType>();
+        dx[i] = s2->getX() - s1->getX();
+        dy[i] = s2->getY() - s1->getY();
+        th2[i] = s2->getYaw();
+    }
+    dubinsLengths(dx, dy, th1, th2, rho_, isSymmetric_, result);
+}
+
+void ompl::base::DubinsStateSpace::distances(const std::vector<const State *> &from, const State *to,
+                                             std::vector<double> &result) const
+{
+    const std::size_t n = from.size();
+    const auto *s2 = to->as<StateType>();
+    std::vector<double> dx(n), dy(n), th1(n), th2(n, s2->getYaw());
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const auto *s1 = from[i]->as<StateType>();
+        dx[i] = s2->getX() - s1->getX();
+        dy[i] = s2->getY() - s1->getY();
+        th1[i] = s1->getYaw();
+    }
+    dubinsLengths(dx, dy, th1, th2, rho_, isSymmetric_, result);
+}
+
+ompl::base::DubinsStateSpace::DubinsPath ompl::base::DubinsStateSpace::shortestPath(const State *from,
+                                                                                    const State *to) const
+{
+    const auto *s1 = from->as<StateType>();
+    const auto *s2 = to->as<StateType>();
+    // the parameters of the space are part of the key, in case another space is allocated at the same address
+    const double key[8] = {s1->getX(), s1->getY(), s1->getYaw(), s2->getX(), s2->getY(), s2->getYaw(),
+                           rho_,        isSymmetric_ ? 1. : 0.};
+    DubinsPathCache &cache = dubinsPathCache;
+    if (cache.space == this && std::equal(key, key + 8, cache.key))
+        return cache.path;
+
+    DubinsPath path = dubins(from, to);
     if (isSymmetric_)
-        return rho_ * std::min(dubins(state1, state2).length(), dubins(state2, state1).length());
-    return rho_ * dubins(state1, state2).length();
+    {
+        DubinsPath path2(dubins(to, from));
+        if (path2.length() < path.length())
+        {
+            path2.reverse_ = true;
+            path = path2;
+        }
+    }
+    cache.space = this;
+    std::copy(key, key + 8, cache.key);
+    cache.path = path;
+    return path;
 }
 
 void ompl::base::DubinsStateSpace::interpolate(const State *from, const State *to, const double t, State *state) const
@@ -243,16 +353,7 @@ void ompl::base::DubinsStateSpace::interpolate(const State *from, const State *t
             return;
         }
 
-        path = dubins(from, to);
-        if (isSymmetric_)
-        {
-            DubinsPath path2(dubins(to, from));
-            if (path2.length() < path.length())
-            {
-                path2.reverse_ = true;
-                path = path2;
-            }
-        }
+        path = shortestPath(from, to);
         firstTime = false;
     }
     interpolate(from, path, t, state);
@@ -260,30 +361,32 @@ void ompl::base::DubinsStateSpace::interpolate(const State *from, const State *t
 
 void ompl::base::DubinsStateSpace::interpolate(const State *from, const DubinsPath &path, double t, State *state) const
 {
-    auto *s = allocState()->as<StateType>();
+    // integrate the path in the frame of a unit turning radius, without allocating a temporary state
     double seg = t * path.length(), phi, v;
+    double x = 0., y = 0., yaw = from->as<StateType>()->getYaw();
 
-    s->setXY(0., 0.);
-    s->setYaw(from->as<StateType>()->getYaw());
     if (!path.reverse_)
     {
         for (unsigned int i = 0; i < 3 && seg > 0; ++i)
         {
             v = std::min(seg, path.length_[i]);
-            phi = s->getYaw();
+            phi = yaw;
             seg -= v;
             switch (path.type_[i])
             {
                 case DUBINS_LEFT:
-                    s->setXY(s->getX() + sin(phi + v) - sin(phi), s->getY() - cos(phi + v) + cos(phi));
-                    s->setYaw(phi + v);
+                    x += sin(phi + v) - sin(phi);
+                    y += -cos(phi + v) + cos(phi);
+                    yaw = phi + v;
                     break;
                 case DUBINS_RIGHT:
-                    s->setXY(s->getX() - sin(phi - v) + sin(phi), s->getY() + cos(phi - v) - cos(phi));
-                    s->setYaw(phi - v);
+                    x += -sin(phi - v) + sin(phi);
+                    y += cos(phi - v) - cos(phi);
+                    yaw = phi - v;
                     break;
                 case DUBINS_STRAIGHT:
-                    s->setXY(s->getX() + v * cos(phi), s->getY() + v * sin(phi));
+                    x += v * cos(phi);
+                    y += v * sin(phi);
                     break;
             }
         }
@@ -293,29 +396,32 @@ void ompl::base::DubinsStateSpace::interpolate(const State *from, const DubinsPa
         for (unsigned int i = 0; i < 3 && seg > 0; ++i)
         {
             v = std::min(seg, path.length_[2 - i]);
-            phi = s->getYaw();
+            phi = yaw;
             seg -= v;
             switch (path.type_[2 - i])
             {
                 case DUBINS_LEFT:
-                    s->setXY(s->getX() + sin(phi - v) - sin(phi), s->getY() - cos(phi - v) + cos(phi));
-                    s->setYaw(phi - v);
+                    x += sin(phi - v) - sin(phi);
+                    y += -cos(phi - v) + cos(phi);
+                    yaw = phi - v;
                     break;
                 case DUBINS_RIGHT:
-                    s->setXY(s->getX() - sin(phi + v) + sin(phi), s->getY() + cos(phi + v) - cos(phi));
-                    s->setYaw(phi + v);
+                    x += -sin(phi + v) + sin(phi);
+                    y += cos(phi + v) - cos(phi);
+                    yaw = phi + v;
                     break;
                 case DUBINS_STRAIGHT:
-                    s->setXY(s->getX() - v * cos(phi), s->getY() - v * sin(phi));
+                    x -= v * cos(phi);
+                    y -= v * sin(phi);
                     break;
             }
         }
     }
-    state->as<StateType>()->setX(s->getX() * rho_ + from->as<StateType>()->getX());
-    state->as<StateType>()->setY(s->getY() * rho_ + from->as<StateType>()->getY());
+    auto *s = state->as<StateType>();
+    s->setX(x * rho_ + from->as<StateType>()->getX());
+    s->setY(y * rho_ + from->as<StateType>()->getY());
+    s->setYaw(yaw);
     getSubspace(1)->enforceBounds(s->as<SO2StateSpace::StateType>(1));
-    state->as<StateType>()->setYaw(s->getYaw());
-    freeState(s);
 }
 
 unsigned int ompl::base::DubinsStateSpace::validSegmentCount(const State *state1,
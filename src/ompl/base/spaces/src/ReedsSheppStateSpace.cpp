@@ -37,6 +37,7 @@
 #include "ompl/base/spaces/ReedsSheppStateSpace.h"
 #include "ompl/base/SpaceInformation.h"
 #include "ompl/util/Exception.h"
+#include <algorithm>
 #include <queue>
 #include <boost/math/constants/constants.hpp>
 
@@ -476,6 +477,17 @@ namespace
         CCSCC(x, y, phi, path);
         return path;
     }
+
+    /* The last path computed by each thread, for the states it connects. Distance computations, motion
+       validation and interpolation usually ask for the same path several times in a row. */
+    struct ReedsSheppPathCache
+    {
+        const ReedsSheppStateSpace *space{nullptr};
+        double key[7];
+        ReedsSheppStateSpace::ReedsSheppPath path;
+    };
+
+    thread_local ReedsSheppPathCache reedsSheppPathCache;
 }
 
 const ompl::base::ReedsSheppStateSpace::ReedsSheppPathSegmentType
@@ -514,7 +526,7 @@ ompl::base::ReedsSheppStateSpace::ReedsSheppPath::ReedsSheppPath(const ReedsShep
 
 double ompl::base::ReedsSheppStateSpace::distance(const State *state1, const State *state2) const
 {
-    return rho_ * reedsShepp(state1, state2).length();
+    return rho_ * cachedReedsShepp(state1, state2).length();
 }
 
 void ompl::base::ReedsSheppStateSpace::interpolate(const State *from, const State *to, const double t,
@@ -542,7 +554,7 @@ void ompl::base::ReedsSheppStateSpace::interpolate(const State *from, const Stat
                 copyState(state, from);
             return;
         }
-        path = reedsShepp(from, to);
+        path = cachedReedsShepp(from, to);
         firstTime = false;
     }
     interpolate(from, path, t, state);
@@ -551,11 +563,10 @@ void ompl::base::ReedsSheppStateSpace::interpolate(const State *from, const Stat
 void ompl::base::ReedsSheppStateSpace::interpolate(const State *from, const ReedsSheppPath &path, double t,
                                                    State *state) const
 {
-    auto *s = allocState()->as<StateType>();
+    // integrate the path in the frame of a unit turning radius, without allocating a temporary state
     double seg = t * path.length(), phi, v;
+    double x = 0., y = 0., yaw = from->as<StateType>()->getYaw();
 
-    s->setXY(0., 0.);
-    s->setYaw(from->as<StateType>()->getYaw());
     for (unsigned int i = 0; i < 5 && seg > 0; ++i)
     {
         if (path.length_[i] < 0)
@@ -568,29 +579,32 @@ void ompl::base::ReedsSheppStateSpace::interpolate(const State *from, const Reed
             v = std::min(seg, path.length_[i]);
             seg -= v;
         }
-        phi = s->getYaw();
+        phi = yaw;
         switch (path.type_[i])
         {
             case RS_LEFT:
-                s->setXY(s->getX() + sin(phi + v) - sin(phi), s->getY() - cos(phi + v) + cos(phi));
-                s->setYaw(phi + v);
+                x += sin(phi + v) - sin(phi);
+                y += -cos(phi + v) + cos(phi);
+                yaw = phi + v;
                 break;
             case RS_RIGHT:
-                s->setXY(s->getX() - sin(phi - v) + sin(phi), s->getY() + cos(phi - v) - cos(phi));
-                s->setYaw(phi - v);
+                x += -sin(phi - v) + sin(phi);
+                y += cos(phi - v) - cos(phi);
+                yaw = phi - v;
                 break;
             case RS_STRAIGHT:
-                s->setXY(s->getX() + v * cos(phi), s->getY() + v * sin(phi));
+                x += v * cos(phi);
+                y += v * sin(phi);
                 break;
             case RS_NOP:
                 break;
         }
     }
-    state->as<StateType>()->setX(s->getX() * rho_ + from->as<StateType>()->getX());
-    state->as<StateType>()->setY(s->getY() * rho_ + from->as<StateType>()->getY());
+    auto *s = state->as<StateType>();
+    s->setX(x * rho_ + from->as<StateType>()->getX());
+    s->setY(y * rho_ + from->as<StateType>()->getY());
+    s->setYaw(yaw);
     getSubspace(1)->enforceBounds(s->as<SO2StateSpace::StateType>(1));
-    state->as<StateType>()->setYaw(s->getYaw());
-    freeState(s);
 }
 
 ompl::base::ReedsSheppStateSpace::ReedsSheppPath ompl::base::ReedsSheppStateSpace::reedsShepp(const State *state1,
@@ -605,6 +619,23 @@ ompl::base::ReedsSheppStateSpace::ReedsSheppPath ompl::base::ReedsSheppStateSpac
     return ::reedsShepp(x / rho_, y / rho_, phi);
 }
 
+ompl::base::ReedsSheppStateSpace::ReedsSheppPath
+ompl::base::ReedsSheppStateSpace::cachedReedsShepp(const State *state1, const State *state2) const
+{
+    const auto *s1 = state1->as<StateType>();
+    const auto *s2 = state2->as<StateType>();
+    // the turning radius is part of the key, in case another space is allocated at the same address
+    const double key[7] = {s1->getX(), s1->getY(), s1->getYaw(), s2->getX(), s2->getY(), s2->getYaw(), rho_};
+    ReedsSheppPathCache &cache = reedsSheppPathCache;
+    if (cache.space == this && std::equal(key, key + 7, cache.key))
+        return cache.path;
+
+    cache.path = reedsShepp(state1, state2);
+    cache.space = this;
+    std::copy(key, key + 7, cache.key);
+    return cache.path;
+}
+
 void ompl::base::ReedsSheppMotionValidator::defaultSettings()
 {
     stateSpace_ = dynamic_cast<ReedsSheppStateSpace *>(si_->getStateSpace().get());
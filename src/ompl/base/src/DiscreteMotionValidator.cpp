@@ -36,6 +36,7 @@
 
 #include "ompl/base/DiscreteMotionValidator.h"
 #include "ompl/util/Exception.h"
+#include <algorithm>
 #include <queue>
 
 void ompl::base::DiscreteMotionValidator::defaultSettings()
@@ -45,6 +46,29 @@ void ompl::base::DiscreteMotionValidator::defaultSettings()
         throw Exception("No state space for motion validator");
 }
 
+int ompl::base::DiscreteMotionValidator::firstInvalidState(const State *s1, const State *s2, int nd) const
+{
+    std::vector<State *> interpolated(std::max(nd - 1, 0));
+    si_->allocStates(interpolated);
+    std::vector<const State *> states;
+    states.reserve(interpolated.size() + 1);
+    for (std::size_t j = 0; j < interpolated.size(); ++j)
+    {
+        stateSpace_->interpolate(s1, s2, (double)(j + 1) / (double)nd, interpolated[j]);
+        states.push_back(interpolated[j]);
+    }
+    states.push_back(s2);
+
+    std::vector<int> valid;
+    si_->getStateValidityChecker()->areValid(states, valid);
+    si_->freeStates(interpolated);
+
+    for (std::size_t j = 0; j < states.size(); ++j)
+        if (valid[j] == 0)
+            return j + 1;
+    return 0;
+}
+
 bool ompl::base::DiscreteMotionValidator::checkMotion(const State *s1, const State *s2,
                                                       std::pair<State *, double> &lastValid) const
 {
@@ -53,6 +77,23 @@ bool ompl::base::DiscreteMotionValidator::checkMotion(const State *s1, const Sta
     bool result = true;
     int nd = stateSpace_->validSegmentCount(s1, s2);
 
+    if (si_->getStateValidityChecker()->getSpecs().hasBatchValidityComputation)
+    {
+        /* check all states in one call; the first invalid one determines the last valid state */
+        if (int j = firstInvalidState(s1, s2, nd))
+        {
+            lastValid.second = (double)(j - 1) / (double)nd;
+            if (lastValid.first != nullptr)
+                stateSpace_->interpolate(s1, s2, lastValid.second, lastValid.first);
+            result = false;
+        }
+        if (result)
+            valid_++;
+        else
+            invalid_++;
+        return result;
+    }
+
     if (nd > 1)
     {
         /* temporary storage for the checked state */
@@ -93,6 +134,17 @@ bool ompl::base::DiscreteMotionValidator::checkMotion(const State *s1, const Sta
 bool ompl::base::DiscreteMotionValidator::checkMotion(const State *s1, const State *s2) const
 {
     /* assume motion starts in a valid configuration so s1 is valid */
+    if (si_->getStateValidityChecker()->getSpecs().hasBatchValidityComputation)
+    {
+        /* check all states in one call instead of subdividing the motion */
+        bool result = firstInvalidState(s1, s2, stateSpace_->validSegmentCount(s1, s2)) == 0;
+        if (result)
+            valid_++;
+        else
+            invalid_++;
+        return result;
+    }
+
     if (!si_->isValid(s2))
     {
         invalid_++;
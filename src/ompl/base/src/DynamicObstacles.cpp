@@ -0,0 +1,119 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2026, the MROR Multi-Robot OMPL contributors
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+/* Author: MROR Multi-Robot OMPL contributors */
+
+#include "ompl/base/DynamicObstacles.h"
+#include "ompl/base/StateValidityChecker.h"
+#include "ompl/base/SpaceInformation.h"
+#include "ompl/base/ReservationTable.h"
+#include <algorithm>
+#include <cmath>
+
+ompl::base::DynamicObstacles::~DynamicObstacles()
+{
+    clear();
+}
+
+void ompl::base::DynamicObstacles::add(double time, const SpaceInformationPtr &si, State *state)
+{
+    int key = std::round(time * TIME_SCALE);
+    states_[key].push_back(std::make_pair(si, state));
+    if (reservations_)
+        reservations_->add(key, states_[key].back());
+}
+
+void ompl::base::DynamicObstacles::add(double stepSize, unsigned int firstStep, unsigned int lastStep,
+                                       const SpaceInformationPtr &si, const Trajectory &trajectory)
+{
+    trajectories_.push_back({si, trajectory, stepSize, firstStep, lastStep});
+}
+
+void ompl::base::DynamicObstacles::setReservationTable(double cellSize, double conflictRadius)
+{
+    if (cellSize <= 0.)
+    {
+        reservations_.reset();
+        return;
+    }
+    reservations_ = std::make_shared<ReservationTable>(cellSize, conflictRadius);
+    // index the obstacles added so far
+    for (const auto &obstacles : states_)
+        for (const auto &obstacle : obstacles.second)
+            reservations_->add(obstacles.first, obstacle);
+}
+
+void ompl::base::DynamicObstacles::clear()
+{
+    for (auto &obstacles : states_)
+        for (auto &obstacle : obstacles.second)
+            obstacle.first->freeState(obstacle.second);
+    states_.clear();
+    trajectories_.clear();
+    if (reservations_)
+        reservations_->clear();
+}
+
+bool ompl::base::DynamicObstacles::isValid(const StateValidityChecker &checker, const StateSpace *space,
+                                           const State *state, double time) const
+{
+    for (const auto &window : trajectories_)
+    {
+        const long step = std::lround(time / window.stepSize);
+        if (step < (long)window.firstStep || step > (long)window.lastStep || window.trajectory->empty())
+            continue;
+        const auto &states = *window.trajectory;
+        const State *other = states[std::min<std::size_t>(step, states.size() - 1)];
+        if (!checker.areStatesValid(state, std::make_pair(window.si, other)))
+            return false;
+    }
+    if (states_.empty())
+        return true;
+    int key = std::round(time * TIME_SCALE);
+    const std::vector<Obstacle> *obstacles = nullptr;
+    if (reservations_)
+        // only the obstacles reserving the cell of this state can be in conflict with it
+        obstacles = reservations_->find(key, state, space);
+    else
+    {
+        auto it = states_.find(key);
+        if (it != states_.end())
+            obstacles = &it->second;
+    }
+    if (obstacles != nullptr)
+        for (const auto &obstacle : *obstacles)
+            if (!checker.areStatesValid(state, obstacle))
+                return false;
+    return true;
+}
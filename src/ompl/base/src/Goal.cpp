@@ -49,6 +49,15 @@ bool ompl::base::Goal::isSatisfied(const State *st, double *distance) const
     return isSatisfied(st);
 }
 
+void ompl::base::Goal::areSatisfied(const std::vector<const State *> &states, std::vector<int> &satisfied,
+                                    std::vector<double> &distances) const
+{
+    satisfied.resize(states.size());
+    distances.resize(states.size());
+    for (std::size_t i = 0; i < states.size(); ++i)
+        satisfied[i] = isSatisfied(states[i], &distances[i]) ? 1 : 0;
+}
+
 void ompl::base::Goal::print(std::ostream &out) const
 {
     out << "Goal memory address " << this << std::endl;
@@ -132,6 +132,13 @@ void ompl::base::Planner::getPlannerData(PlannerData &data) const
         data.properties[plannerProgressProperty.first] = plannerProgressProperty.second();
 }
 
+void ompl::base::Planner::streamPlannerData(PlannerDataSink &sink) const
+{
+    PlannerData data(si_);
+    getPlannerData(data);
+    sink.write(getName(), data);
+}
+
 void ompl::base::Planner::setPlannerData(const PlannerData &data)
 {
     for (const auto &plannerProgressProperty : plannerProgressProperties_)
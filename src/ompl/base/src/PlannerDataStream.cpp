@@ -0,0 +1,256 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2026, the MROR Multi-Robot OMPL contributors
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+/* Author: MROR Multi-Robot OMPL contributors */
+
+#include "ompl/base/PlannerDataStream.h"
+#include "ompl/base/PlannerData.h"
+#include "ompl/util/Console.h"
+
+/// @cond IGNORE
+namespace
+{
+    const char MAGIC[] = "OMPLPDS";
+    const std::uint8_t VERSION = 1;
+
+    const char SECTION = 'S';
+    const char VERTEX = 'V';
+    const char EDGE = 'E';
+    const char PROPERTY = 'P';
+    const char END_SECTION = 'X';
+
+    // set on the type of a vertex that is written without state
+    const std::uint8_t NO_STATE = 0x80;
+}
+/// @endcond
+
+void ompl::base::PlannerDataSink::write(const std::string &name, const PlannerData &data)
+{
+    beginSection(name, data.getSpaceInformation()->getStateSpace().get());
+    for (unsigned int i = 0; i < data.numVertices(); ++i)
+    {
+        const State *state = data.getVertex(i).getState();
+        VertexType type = data.isStartVertex(i) ? START : (data.isGoalVertex(i) ? GOAL : PLAIN);
+        vertex(idOf(state), state, type);
+    }
+    std::vector<unsigned int> edges;
+    for (unsigned int i = 0; i < data.numVertices(); ++i)
+    {
+        data.getEdges(i, edges);
+        for (unsigned int j : edges)
+            edge(idOf(data.getVertex(i).getState()), idOf(data.getVertex(j).getState()));
+    }
+    endSection();
+}
+
+ompl::base::PlannerDataBinaryWriter::PlannerDataBinaryWriter(std::ostream &out) : out_(out)
+{
+    out_.write(MAGIC, sizeof(MAGIC) - 1);
+    writeValue(VERSION);
+}
+
+void ompl::base::PlannerDataBinaryWriter::writeString(const std::string &s)
+{
+    writeValue(static_cast<std::uint32_t>(s.size()));
+    out_.write(s.data(), s.size());
+}
+
+void ompl::base::PlannerDataBinaryWriter::beginSection(const std::string &name, const StateSpace *space)
+{
+    space_ = space;
+    std::uint32_t dimension = 0;
+    if (space_ != nullptr)
+    {
+        // the number of reals of a state does not depend on the state
+        State *state = space_->allocState();
+        space_->copyToReals(reals_, state);
+        space_->freeState(state);
+        dimension = reals_.size();
+    }
+    writeValue(SECTION);
+    writeString(name);
+    writeString(space_ != nullptr ? space_->getName() : std::string());
+    writeValue(dimension);
+}
+
+void ompl::base::PlannerDataBinaryWriter::vertex(std::uint64_t id, const State *state, VertexType type)
+{
+    const bool hasState = state != nullptr && space_ != nullptr;
+    writeValue(VERTEX);
+    writeValue(id);
+    writeValue(static_cast<std::uint8_t>(hasState ? type : type | NO_STATE));
+    if (hasState)
+    {
+        space_->copyToReals(reals_, state);
+        out_.write(reinterpret_cast<const char *>(reals_.data()), reals_.size() * sizeof(double));
+    }
+}
+
+void ompl::base::PlannerDataBinaryWriter::edge(std::uint64_t from, std::uint64_t to)
+{
+    writeValue(EDGE);
+    writeValue(from);
+    writeValue(to);
+}
+
+void ompl::base::PlannerDataBinaryWriter::property(std::uint64_t id, const std::string &name, const std::string &value)
+{
+    writeValue(PROPERTY);
+    writeValue(id);
+    writeString(name);
+    writeString(value);
+}
+
+void ompl::base::PlannerDataBinaryWriter::endSection()
+{
+    writeValue(END_SECTION);
+    space_ = nullptr;
+    out_.flush();
+}
+
+bool ompl::base::PlannerDataBinaryReader::readString(std::string &s)
+{
+    std::uint32_t size = 0;
+    if (!readValue(size))
+        return false;
+    s.resize(size);
+    return size == 0 || static_cast<bool>(in_.read(&s[0], size));
+}
+
+bool ompl::base::PlannerDataBinaryReader::read(PlannerDataSink &sink, const SpaceLookup &spaces)
+{
+    char magic[sizeof(MAGIC) - 1];
+    std::uint8_t version = 0;
+    if (!in_.read(magic, sizeof(magic)) || std::string(magic, sizeof(magic)) != std::string(MAGIC) ||
+        !readValue(version) || version != VERSION)
+    {
+        OMPL_ERROR("Not a planner data stream");
+        return false;
+    }
+
+    StateSpacePtr space;
+    State *state = nullptr;
+    std::uint32_t dimension = 0;
+    std::vector<double> reals;
+    bool inSection = false;
+    bool ok = true;
+    auto freeState = [&]
+    {
+        if (state != nullptr)
+            space->freeState(state);
+        state = nullptr;
+    };
+
+    char tag;
+    while (ok && in_.get(tag))
+    {
+        switch (tag)
+        {
+            case SECTION:
+            {
+                std::string name, spaceName;
+                ok = !inSection && readString(name) && readString(spaceName) && readValue(dimension);
+                if (!ok)
+                    break;
+                freeState();
+                space = spaces ? spaces(spaceName) : StateSpacePtr();
+                if (space)
+                {
+                    state = space->allocState();
+                    space->copyToReals(reals, state);
+                    if (reals.size() != dimension)
+                    {
+                        OMPL_ERROR("State space '%s' does not match the planner data stream", spaceName.c_str());
+                        ok = false;
+                        break;
+                    }
+                }
+                reals.resize(dimension);
+                inSection = true;
+                sink.beginSection(name, space.get());
+                break;
+            }
+            case VERTEX:
+            {
+                std::uint64_t id;
+                std::uint8_t type;
+                ok = inSection && readValue(id) && readValue(type);
+                if (!ok)
+                    break;
+                const bool hasState = (type & NO_STATE) == 0;
+                if (hasState)
+                    ok = static_cast<bool>(in_.read(reinterpret_cast<char *>(reals.data()), reals.size() * sizeof(double)));
+                if (!ok)
+                    break;
+                if (hasState && state != nullptr)
+                    space->copyFromReals(state, reals);
+                sink.vertex(id, hasState ? state : nullptr,
+                            static_cast<PlannerDataSink::VertexType>(type & ~NO_STATE));
+                break;
+            }
+            case EDGE:
+            {
+                std::uint64_t from, to;
+                ok = inSection && readValue(from) && readValue(to);
+                if (ok)
+                    sink.edge(from, to);
+                break;
+            }
+            case PROPERTY:
+            {
+                std::uint64_t id;
+                std::string name, value;
+                ok = inSection && readValue(id) && readString(name) && readString(value);
+                if (ok)
+                    sink.property(id, name, value);
+                break;
+            }
+            case END_SECTION:
+                ok = inSection;
+                if (ok)
+                    sink.endSection();
+                inSection = false;
+                break;
+            default:
+                ok = false;
+        }
+    }
+    freeState();
+    if (!ok || inSection)
+    {
+        OMPL_ERROR("Malformed planner data stream");
+        return false;
+    }
+    return true;
+}
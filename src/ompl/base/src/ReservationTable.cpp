@@ -0,0 +1,111 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2026, the MROR Multi-Robot OMPL contributors
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+/* Author: MROR Multi-Robot OMPL contributors */
+
+#include "ompl/base/ReservationTable.h"
+#include "ompl/base/SpaceInformation.h"
+#include "ompl/util/Exception.h"
+#include <boost/functional/hash.hpp>
+#include <cmath>
+
+ompl::base::ReservationTable::ReservationTable(double cellSize, double conflictRadius)
+  : cellSize_(cellSize), conflictRadius_(conflictRadius)
+{
+    if (cellSize_ <= 0. || conflictRadius_ < 0.)
+        throw Exception("Reservation table needs a positive cell size and a non-negative conflict radius");
+}
+
+std::size_t ompl::base::ReservationTable::KeyHash::operator()(const Key &key) const
+{
+    std::size_t seed = 0;
+    boost::hash_combine(seed, key.time);
+    for (int c : key.cell)
+        boost::hash_combine(seed, c);
+    return seed;
+}
+
+unsigned int ompl::base::ReservationTable::project(const State *state, const StateSpace *space,
+                                                   Eigen::VectorXd &projection) const
+{
+    // add() fills the cache; states looked up later usually belong to one of the same spaces
+    auto it = projections_.find(space);
+    if (it == projections_.end() && !space->hasDefaultProjection())
+        throw Exception("Reservation table needs a default projection for state space " + space->getName());
+    const ProjectionEvaluatorPtr &proj = it != projections_.end() ? it->second : space->getDefaultProjection();
+    projection.resize(proj->getDimension());
+    proj->project(state, projection);
+    return std::min(proj->getDimension(), MAX_DIM);
+}
+
+void ompl::base::ReservationTable::add(int timeKey, const Obstacle &obstacle)
+{
+    const StateSpace *space = obstacle.first->getStateSpace().get();
+    ProjectionEvaluatorPtr &proj = projections_[space];
+    if (!proj && space->hasDefaultProjection())
+        proj = space->getDefaultProjection();
+    Eigen::VectorXd projection;
+    unsigned int dim = project(obstacle.second, space, projection);
+
+    // range of cells within the conflict radius in each dimension
+    int low[MAX_DIM] = {0, 0, 0}, high[MAX_DIM] = {0, 0, 0};
+    for (unsigned int i = 0; i < dim; ++i)
+    {
+        low[i] = (int)std::floor((projection[i] - conflictRadius_) / cellSize_);
+        high[i] = (int)std::floor((projection[i] + conflictRadius_) / cellSize_);
+    }
+
+    Key key{timeKey, {low[0], low[1], low[2]}};
+    for (key.cell[0] = low[0]; key.cell[0] <= high[0]; ++key.cell[0])
+        for (key.cell[1] = low[1]; key.cell[1] <= high[1]; ++key.cell[1])
+            for (key.cell[2] = low[2]; key.cell[2] <= high[2]; ++key.cell[2])
+                cells_[key].push_back(obstacle);
+}
+
+const std::vector<ompl::base::ReservationTable::Obstacle> *
+ompl::base::ReservationTable::find(int timeKey, const State *state, const StateSpace *space) const
+{
+    thread_local Eigen::VectorXd projection;
+    unsigned int dim = project(state, space, projection);
+    Key key{timeKey, {0, 0, 0}};
+    for (unsigned int i = 0; i < dim; ++i)
+        key.cell[i] = (int)std::floor(projection[i] / cellSize_);
+    auto it = cells_.find(key);
+    return it == cells_.end() ? nullptr : &it->second;
+}
+
+void ompl::base::ReservationTable::clear()
+{
+    cells_.clear();
+}
@@ -36,6 +36,7 @@
 
 #include "ompl/base/SpaceInformation.h"
 #include <cassert>
+#include <limits>
 #include <queue>
 #include <utility>
 #include "ompl/base/DiscreteMotionValidator.h"
@@ -106,6 +107,103 @@ void ompl::base::SpaceInformation::setStateValidityChecker(const StateValidityCh
     setStateValidityChecker(std::make_shared<FnStateValidityChecker>(this, svc));
 }
 
+namespace
+{
+    /* Checks states with a function that sees all of them as a single matrix, one row per state */
+    class FnBatchStateValidityChecker : public ompl::base::StateValidityChecker
+    {
+    public:
+        FnBatchStateValidityChecker(ompl::base::SpaceInformation *si, ompl::base::BatchStateValidityCheckerFn fn,
+                                    ompl::base::TimedBatchStateValidityCheckerFn timedFn)
+          : StateValidityChecker(si), fn_(std::move(fn)), timedFn_(std::move(timedFn))
+        {
+            specs_.hasBatchValidityComputation = true;
+        }
+
+        using StateValidityChecker::areValid;
+
+        bool isValid(const ompl::base::State *state) const override
+        {
+            std::vector<int> valid;
+            areValid(std::vector<const ompl::base::State *>(1, state), valid);
+            return valid[0] != 0;
+        }
+
+        void areValid(const std::vector<const ompl::base::State *> &states, std::vector<int> &valid) const override
+        {
+            check(states, nullptr, valid);
+        }
+
+        void areValid(const std::vector<const ompl::base::State *> &states, const std::vector<double> &times,
+                      std::vector<int> &valid) override
+        {
+            if (!timedFn_)
+            {
+                StateValidityChecker::areValid(states, times, valid);
+                return;
+            }
+            check(states, &times, valid);
+            const ompl::base::DynamicObstacles &obstacles = getCurrentDynamicObstacles();
+            if (obstacles.empty())
+                return;
+            const ompl::base::StateSpace *space = si_->getStateSpace().get();
+            for (std::size_t i = 0; i < states.size(); ++i)
+                if (valid[i] != 0 && !obstacles.isValid(*this, space, states[i], times[i]))
+                    valid[i] = 0;
+        }
+
+    private:
+        void check(const std::vector<const ompl::base::State *> &states, const std::vector<double> *times,
+                   std::vector<int> &valid) const
+        {
+            valid.resize(states.size());
+            if (states.empty())
+                return;
+            std::vector<double> reals;
+            const ompl::base::StateSpace *space = si_->getStateSpace().get();
+            space->copyToReals(reals, states[0]);
+            Eigen::MatrixXd values(states.size(), reals.size());
+            for (std::size_t i = 0; i < states.size(); ++i)
+            {
+                if (i > 0)
+                    space->copyToReals(reals, states[i]);
+                values.row(i) = Eigen::Map<const Eigen::RowVectorXd>(reals.data(), reals.size());
+            }
+            Eigen::VectorXd result(Eigen::VectorXd::Zero(states.size()));
+            if (timedFn_)
+            {
+                Eigen::VectorXd stamps(states.size());
+                for (std::size_t i = 0; i < states.size(); ++i)
+                    stamps[i] = times != nullptr ? (*times)[i] : std::numeric_limits<double>::quiet_NaN();
+                timedFn_(values, stamps, result);
+            }
+            else
+                fn_(values, result);
+            for (std::size_t i = 0; i < states.size(); ++i)
+                valid[i] = result[i] != 0. ? 1 : 0;
+        }
+
+        ompl::base::BatchStateValidityCheckerFn fn_;
+        ompl::base::TimedBatchStateValidityCheckerFn timedFn_;
+    };
+}  // namespace
+
+void ompl::base::SpaceInformation::setBatchStateValidityChecker(const BatchStateValidityCheckerFn &svc)
+{
+    if (!svc)
+        throw Exception("Invalid function definition for batch state validity checking");
+
+    setStateValidityChecker(std::make_shared<FnBatchStateValidityChecker>(this, svc, nullptr));
+}
+
+void ompl::base::SpaceInformation::setBatchStateValidityChecker(const TimedBatchStateValidityCheckerFn &svc)
+{
+    if (!svc)
+        throw Exception("Invalid function definition for batch state validity checking");
+
+    setStateValidityChecker(std::make_shared<FnBatchStateValidityChecker>(this, nullptr, svc));
+}
+
 void ompl::base::SpaceInformation::setDefaultMotionValidator()
 {
     if (dynamic_cast<ReedsSheppStateSpace *>(stateSpace_.get()))
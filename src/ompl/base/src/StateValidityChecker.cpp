@@ -36,42 +36,111 @@
 
 #include "ompl/base/StateValidityChecker.h"
 #include "ompl/base/SpaceInformation.h"
+#include "ompl/base/ReservationTable.h"
+
+namespace
+{
+    /* The innermost ScopedDynamicObstacles of the calling thread, if any */
+    thread_local const ompl::base::StateValidityChecker::ScopedDynamicObstacles *g_scopedObstacles = nullptr;
+}
+
+ompl::base::StateValidityChecker::ScopedDynamicObstacles::ScopedDynamicObstacles(
+    const StateValidityChecker &checker, DynamicObstaclesConstPtr obstacles)
+  : checker_(&checker), obstacles_(std::move(obstacles)), previous_(g_scopedObstacles)
+{
+    g_scopedObstacles = this;
+}
+
+ompl::base::StateValidityChecker::ScopedDynamicObstacles::~ScopedDynamicObstacles()
+{
+    g_scopedObstacles = previous_;
+}
+
+const ompl::base::StateValidityChecker::ScopedDynamicObstacles *
+ompl::base::StateValidityChecker::ScopedDynamicObstacles::current()
+{
+    return g_scopedObstacles;
+}
+
+ompl::base::StateValidityChecker::ScopedDynamicObstacles::Inherit::Inherit(const ScopedDynamicObstacles *scope)
+  : previous_(g_scopedObstacles)
+{
+    g_scopedObstacles = scope;
+}
+
+ompl::base::StateValidityChecker::ScopedDynamicObstacles::Inherit::~Inherit()
+{
+    g_scopedObstacles = previous_;
+}
+
+const ompl::base::DynamicObstacles &ompl::base::StateValidityChecker::getCurrentDynamicObstacles() const
+{
+    for (const ScopedDynamicObstacles *scope = g_scopedObstacles; scope != nullptr; scope = scope->previous_)
+        if (scope->checker_ == this)
+            return *scope->obstacles_;
+    return *dynamicObstacles_;
+}
 
 bool ompl::base::StateValidityChecker::isValid(const State *state, const double time)
 {
-    if (dynObstacles_.empty())
-        return isValid(state);
-    else
+    return isValid(state, time, getCurrentDynamicObstacles());
+}
+
+bool ompl::base::StateValidityChecker::isValid(const State *state, double time,
+                                               const DynamicObstacles &obstacles) const
+{
+    if (!isValid(state))
+        return false;
+    return obstacles.empty() || obstacles.isValid(*this, si_->getStateSpace().get(), state, time);
+}
+
+void ompl::base::StateValidityChecker::areValid(const std::vector<const State *> &states,
+                                                std::vector<int> &valid) const
+{
+    valid.resize(states.size());
+    for (std::size_t i = 0; i < states.size(); ++i)
+        valid[i] = isValid(states[i]) ? 1 : 0;
+}
+
+void ompl::base::StateValidityChecker::areValid(const std::vector<const State *> &states,
+                                                const std::vector<double> &times, std::vector<int> &valid)
+{
+    if (!specs_.hasBatchValidityComputation)
     {
-        if (isValid(state))
-        {
-            int t_key = std::round(time * scalingFactor_);
-            auto obsAtTime = dynObstacles_.find(t_key);
-            if (obsAtTime != dynObstacles_.end())
-            {
-                for (auto st = obsAtTime->second.begin(); st != obsAtTime->second.end(); st++)
-                {
-                    if (!areStatesValid(state, *st))
-                        return false;
-                }
-                return true;
-            }
-            else
-                return true;
-        }
-        else
-            return false;
+        valid.resize(states.size());
+        for (std::size_t i = 0; i < states.size(); ++i)
+            valid[i] = isValid(states[i], times[i]) ? 1 : 0;
+        return;
     }
+    areValid(states, valid);
+    const DynamicObstacles &obstacles = getCurrentDynamicObstacles();
+    if (obstacles.empty())
+        return;
+    const StateSpace *space = si_->getStateSpace().get();
+    for (std::size_t i = 0; i < states.size(); ++i)
+        if (valid[i] != 0 && !obstacles.isValid(*this, space, states[i], times[i]))
+            valid[i] = 0;
+}
+
+void ompl::base::StateValidityChecker::addDynamicObstacle(const double time, const SpaceInformationPtr &si,
+                                                          State *state)
+{
+    dynamicObstacles_->add(time, si, state);
+}
+
+void ompl::base::StateValidityChecker::addDynamicObstacle(double stepSize, unsigned int firstStep,
+                                                          unsigned int lastStep, const SpaceInformationPtr &si,
+                                                          const Trajectory &trajectory)
+{
+    dynamicObstacles_->add(stepSize, firstStep, lastStep, si, trajectory);
+}
+
+void ompl::base::StateValidityChecker::setReservationTable(double cellSize, double conflictRadius)
+{
+    dynamicObstacles_->setReservationTable(cellSize, conflictRadius);
 }
 
 void ompl::base::StateValidityChecker::clearDynamicObstacles()
 {
-    for (auto t_itr = dynObstacles_.begin(); t_itr != dynObstacles_.end(); t_itr++)
-    {
-        for (auto st_itr = (t_itr->second).begin(); st_itr != (t_itr->second).end(); st_itr++)
-        {
-            st_itr->first->freeState(st_itr->second);
-        }
-    }
-    dynObstacles_.clear();
-}
\ No newline at end of file
+    dynamicObstacles_->clear();
+}
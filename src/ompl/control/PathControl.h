@@ -124,7 +124,9 @@ namespace ompl
             void append(const base::State *state, const Control *control, double duration);
 
             /** \brief Make the path such that all controls are applied for a single time step (computes intermediate
-             * states) */
+             * states). A path that is already in that form is not modified, so concurrent calls on an interpolated path
+             * are safe. The first interpolation of a path replaces its states and controls; it must not run
+             * concurrently with any other use of the path. */
             void interpolate();
 
             /** \brief Set this path to a random segment */
@@ -117,6 +117,12 @@ namespace ompl
             virtual unsigned int getBestControlTest(Control *control, const base::State *source, base::State *dest,
                                                 const Control *previous, unsigned int previousSteps);
 
+            /** \brief Like getBestControl(), but all the controls are propagated together (see
+                SpaceInformation::propagateBatchWhileValid()). This is used if the state propagator can propagate
+                batches of states. The states are checked at their times if \e previousSteps is not nullptr. */
+            unsigned int getBestControlBatch(Control *control, const base::State *source, base::State *dest,
+                                             const Control *previous, const unsigned int *previousSteps);
+
             /** \brief An instance of the control sampler*/
             ControlSamplerPtr cs_;
 
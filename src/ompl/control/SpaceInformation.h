@@ -65,6 +65,15 @@ namespace ompl
         using StatePropagatorFn =
             std::function<void(const base::State *, const Control *, const double, base::State *)>;
 
+        /** \brief A function that propagates many states in one call. Row \e i of \e states holds the real values
+            of the i-th state (see base::StateSpace::copyToReals()) and row \e i of \e controls the values of the
+            control applied to it (see ControlSpace::getValueAddressAtIndex()). The function writes the real values
+            of the state reached after \e duration to row \e i of \e results. This allows vectorised propagation,
+            e.g., from Python with NumPy. */
+        using BatchStatePropagatorFn = std::function<void(
+            const Eigen::Ref<const Eigen::MatrixXd> &states, const Eigen::Ref<const Eigen::MatrixXd> &controls,
+            double duration, Eigen::Ref<Eigen::MatrixXd> results)>;
+
         /** \brief Space information containing necessary information for planning with controls. setup() needs to be
          * called before use. */
         class SpaceInformation : public base::SpaceInformation
@@ -203,6 +212,10 @@ namespace ompl
             /** \brief Set the instance of StatePropagator to perform state propagation */
             void setStatePropagator(const StatePropagatorPtr &sp);
 
+            /** \brief Set a function that propagates many states in one call. The control space must give access
+                to the values of its controls (see ControlSpace::getValueAddressAtIndex()). */
+            void setBatchStatePropagator(const BatchStatePropagatorFn &fn);
+
             /** \brief When controls are applied to states, they are applied for a time duration that is an integer
                 multiple of the stepSize, within the bounds specified by setMinMaxControlDuration() */
             void setPropagationStepSize(double stepSize)
@@ -287,6 +300,28 @@ namespace ompl
             unsigned int propagateWhileValid(const base::State *state, const Control *control, int steps,
                                              std::vector<base::State *> &result, bool alloc) const;
 
+            /** \brief Propagate the model of the system forward from \e state with each of \e controls, for the
+                number of steps in the same entry of \e steps, and stop each propagation at the first invalid state
+                as propagateWhileValid() does. The propagations that are still running advance one step with a
+                single call to StatePropagator::propagateBatch(), and the states they reach are checked with a single
+                call to base::StateValidityChecker::areValid() if the checker has batch validity computation.
+                \param state the state to start at
+                \param controls the controls to apply
+                \param steps the maximum numbers of time steps to apply the controls for; set to the numbers of steps
+                performed without collision
+                \param results the states at the end of the propagations or the last valid states if a collision is
+                found */
+            void propagateBatchWhileValid(const base::State *state, const std::vector<const Control *> &controls,
+                                          std::vector<unsigned int> &steps,
+                                          const std::vector<base::State *> &results) const;
+
+            /** \brief Like propagateBatchWhileValid(), but the states are checked at their times (with the
+                dynamic obstacles), the propagations starting after \e previousSteps steps */
+            void propagateBatchWhileValidTest(const base::State *state, const std::vector<const Control *> &controls,
+                                              std::vector<unsigned int> &steps,
+                                              const std::vector<base::State *> &results,
+                                              unsigned int previousSteps) const;
+
             /** @} */
 
             /** \brief Print information about the current instance of the state space */
@@ -299,6 +334,12 @@ namespace ompl
             /** Declare parameter settings */
             void declareParams();
 
+            /** \brief Implement propagateBatchWhileValid() and propagateBatchWhileValidTest(); the states are
+                checked at their times if \e startTime is not nullptr */
+            void propagateBatchWhileValid(const base::State *state, const std::vector<const Control *> &controls,
+                                          std::vector<unsigned int> &steps, const std::vector<base::State *> &results,
+                                          const double *startTime) const;
+
             /** \brief The control space describing the space of controls applicable to states in the state space */
             ControlSpacePtr controlSpace_;
 
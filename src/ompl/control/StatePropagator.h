@@ -40,6 +40,7 @@
 #include "ompl/base/State.h"
 #include "ompl/control/Control.h"
 #include "ompl/util/ClassForward.h"
+#include <vector>
 
 namespace ompl
 {
@@ -92,6 +93,26 @@ namespace ompl
             virtual void propagate(const base::State *state, const Control *control, double duration,
                                    base::State *result) const = 0;
 
+            /** \brief Propagate each of \e states with the control of the same index in \e controls for \e duration
+                and store the states reached in \e results. Propagators that propagate many states faster in one
+                call override this and canPropagateBatch(); by default, the states are propagated one by one.
+
+                \note The states in \e states and \e results must be different. */
+            virtual void propagateBatch(const std::vector<const base::State *> &states,
+                                        const std::vector<const Control *> &controls, double duration,
+                                        const std::vector<base::State *> &results) const
+            {
+                for (std::size_t i = 0; i < states.size(); ++i)
+                    propagate(states[i], controls[i], duration, results[i]);
+            }
+
+            /** \brief Return true if propagateBatch() propagates several states faster than calling propagate()
+                for each of them. Control samplers that try several controls propagate them together if so. */
+            virtual bool canPropagateBatch() const
+            {
+                return false;
+            }
+
             /** \brief Some systems can only propagate forward in time (i.e., the \e duration argument for the
                propagate()
                 function is always positive). If this is the case, this function should return false. Planners that need
@@ -113,6 +113,8 @@ namespace ompl
 
             void getPlannerData(base::PlannerData &data) const override;
 
+            void streamPlannerData(base::PlannerDataSink &sink) const override;
+
             void setPlannerData(const base::PlannerData &data) override;
 
             /** \brief Set a different nearest neighbors datastructure */
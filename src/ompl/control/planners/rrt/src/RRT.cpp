@@ -158,6 +158,11 @@ ompl::base::PlannerStatus ompl::control::RRT::solve(const base::PlannerTerminati
             {
                 Motion *lastmotion = nmotion;
                 bool solved = false;
+                // check all the states against the goal at once
+                std::vector<int> satisfied;
+                std::vector<double> distances;
+                goal->areSatisfied(std::vector<const base::State *>(pstates.begin(), pstates.end()), satisfied,
+                                   distances);
                 size_t p = 0;
                 for (; p < pstates.size(); ++p)
                 {
@@ -171,8 +176,8 @@ ompl::base::PlannerStatus ompl::control::RRT::solve(const base::PlannerTerminati
                     motion->parent = lastmotion;
                     lastmotion = motion;
                     nn_->add(motion);
-                    double dist = 0.0;
-                    solved = goal->isSatisfied(motion->state, &dist);
+                    double dist = distances[p];
+                    solved = satisfied[p] != 0;
                     if (solved)
                     {
                         approxdif = dist;
@@ -296,6 +301,27 @@ void ompl::control::RRT::getPlannerData(base::PlannerData &data) const
     }
 }
 
+void ompl::control::RRT::streamPlannerData(base::PlannerDataSink &sink) const
+{
+    std::vector<Motion *> motions;
+    if (nn_)
+        nn_->list(motions);
+
+    sink.beginSection(getName(), si_->getStateSpace().get());
+    for (auto m : motions)
+    {
+        base::PlannerDataSink::VertexType type = base::PlannerDataSink::PLAIN;
+        if (m->parent == nullptr)
+            type = base::PlannerDataSink::START;
+        else if (m == lastGoalMotion_)
+            type = base::PlannerDataSink::GOAL;
+        sink.vertex(base::PlannerDataSink::idOf(m->state), m->state, type);
+        if (m->parent != nullptr)
+            sink.edge(base::PlannerDataSink::idOf(m->parent->state), base::PlannerDataSink::idOf(m->state));
+    }
+    sink.endSection();
+}
+
 void ompl::control::RRT::setPlannerData(const base::PlannerData &data)
 {
     Planner::setPlannerData(data);
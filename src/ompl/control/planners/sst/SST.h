@@ -71,6 +71,8 @@ namespace ompl
 
             void getPlannerData(base::PlannerData &data) const override;
 
+            void streamPlannerData(base::PlannerDataSink &sink) const override;
+
             /** \brief Clear datastructures. Call this function if the
                 input data to the planner has changed and you do not
                 want to continue planning */
@@ -42,6 +42,7 @@
 #include "ompl/base/objectives/MechanicalWorkOptimizationObjective.h"
 #include "ompl/tools/config/SelfConfig.h"
 #include <limits>
+#include <unordered_set>
 
 ompl::control::SST::SST(const SpaceInformationPtr &si) : base::Planner(si, "SST")
 {
@@ -453,3 +454,31 @@ void ompl::control::SST::getPlannerData(base::PlannerData &data) const
             data.addStartVertex(base::PlannerDataVertex(m->state_));
     }
 }
+
+void ompl::control::SST::streamPlannerData(base::PlannerDataSink &sink) const
+{
+    std::vector<Motion *> motions;
+    if (nn_)
+        nn_->list(motions);
+
+    sink.beginSection(getName(), si_->getStateSpace().get());
+    if (prevSolution_.size() != 0)
+        sink.vertex(base::PlannerDataSink::idOf(prevSolution_[0]), prevSolution_[0], base::PlannerDataSink::GOAL);
+
+    // the active motions are in nn_; the inactive ones that are still in the tree are reached through their
+    // descendants and sent once
+    std::unordered_set<const Motion *> inactiveSent;
+    for (auto m : motions)
+    {
+        for (Motion *c = m; c != nullptr; c = c->parent_)
+        {
+            if (c != m && (!c->inactive_ || !inactiveSent.insert(c).second))
+                break;
+            sink.vertex(base::PlannerDataSink::idOf(c->state_), c->state_,
+                        c->parent_ != nullptr ? base::PlannerDataSink::PLAIN : base::PlannerDataSink::START);
+            if (c->parent_ != nullptr)
+                sink.edge(base::PlannerDataSink::idOf(c->parent_->state_), base::PlannerDataSink::idOf(c->state_));
+        }
+    }
+    sink.endSection();
+}
@@ -41,6 +41,7 @@
 #include "ompl/base/OptimizationObjective.h"
 #include "ompl/util/Exception.h"
 #include "ompl/util/Console.h"
+#include <algorithm>
 #include <numeric>
 #include <cmath>
 
@@ -198,11 +199,18 @@ void ompl::control::PathControl::interpolate()
     }
 
     const auto *si = static_cast<const SpaceInformation *>(si_.get());
+    double res = si->getPropagationStepSize();
+
+    // a path that is already interpolated is left untouched, so that several threads can call this function on a
+    // path they share (e.g., through plans) without writing to it
+    if (std::all_of(controlDurations_.begin(), controlDurations_.end(),
+                    [res](double duration) { return floor(0.5 + duration / res) <= 1; }))
+        return;
+
     std::vector<base::State *> newStates;
     std::vector<Control *> newControls;
     std::vector<double> newControlDurations;
 
-    double res = si->getPropagationStepSize();
     for (unsigned int i = 0; i < controls_.size(); ++i)
     {
         auto steps = (int)floor(0.5 + controlDurations_[i] / res);
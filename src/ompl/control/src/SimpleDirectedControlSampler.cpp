@@ -71,6 +71,9 @@ unsigned int ompl::control::SimpleDirectedControlSampler::sampleToTest(Control *
 unsigned int ompl::control::SimpleDirectedControlSampler::getBestControl(Control *control, const base::State *source,
                                                                          base::State *dest, const Control *previous)
 {
+    if (numControlSamples_ > 1 && si_->getStatePropagator()->canPropagateBatch())
+        return getBestControlBatch(control, source, dest, previous, nullptr);
+
     // Sample the first control
     if (previous != nullptr)
         cs_->sampleNext(control, previous, source);
@@ -124,6 +127,9 @@ unsigned int ompl::control::SimpleDirectedControlSampler::getBestControl(Control
 unsigned int ompl::control::SimpleDirectedControlSampler::getBestControlTest(Control *control, const base::State *source,
                                                                          base::State *dest, const Control *previous, unsigned int previousSteps)
 {
+    if (numControlSamples_ > 1 && si_->getStatePropagator()->canPropagateBatch())
+        return getBestControlBatch(control, source, dest, previous, &previousSteps);
+
     // Sample the first control
     if (previous != nullptr)
         cs_->sampleNext(control, previous, source);
@@ -173,3 +179,56 @@ unsigned int ompl::control::SimpleDirectedControlSampler::getBestControlTest(Con
 
     return steps;
 }
+
+unsigned int ompl::control::SimpleDirectedControlSampler::getBestControlBatch(Control *control,
+                                                                              const base::State *source,
+                                                                              base::State *dest,
+                                                                              const Control *previous,
+                                                                              const unsigned int *previousSteps)
+{
+    const unsigned int minDuration = si_->getMinControlDuration();
+    const unsigned int maxDuration = si_->getMaxControlDuration();
+
+    // Sample all the controls and their durations
+    std::vector<Control *> controls(numControlSamples_);
+    std::vector<unsigned int> steps(numControlSamples_);
+    for (unsigned int i = 0; i < numControlSamples_; ++i)
+    {
+        controls[i] = i == 0 ? control : si_->allocControl();
+        if (previous != nullptr)
+            cs_->sampleNext(controls[i], previous, source);
+        else
+            cs_->sample(controls[i], source);
+        steps[i] = cs_->sampleStepCount(minDuration, maxDuration);
+    }
+
+    // Propagate them together, and save the control that gets closest to target
+    std::vector<base::State *> states(numControlSamples_);
+    si_->allocStates(states);
+    std::vector<const Control *> applied(controls.begin(), controls.end());
+    if (previousSteps != nullptr)
+        si_->propagateBatchWhileValidTest(source, applied, steps, states, *previousSteps);
+    else
+        si_->propagateBatchWhileValid(source, applied, steps, states);
+
+    unsigned int best = 0;
+    double bestDistance = si_->distance(states[0], dest);
+    for (unsigned int i = 1; i < numControlSamples_; ++i)
+    {
+        double distance = si_->distance(states[i], dest);
+        if (distance < bestDistance)
+        {
+            best = i;
+            bestDistance = distance;
+        }
+    }
+    if (best != 0)
+        si_->copyControl(control, controls[best]);
+    si_->copyState(dest, states[best]);
+
+    for (unsigned int i = 1; i < numControlSamples_; ++i)
+        si_->freeControl(controls[i]);
+    si_->freeStates(states);
+
+    return steps[best];
+}
@@ -141,6 +141,82 @@ void ompl::control::SpaceInformation::setStatePropagator(const StatePropagatorPt
     statePropagator_ = sp;
 }
 
+namespace
+{
+    /* Propagates states with a function that sees all of them (and their controls) as matrices, one row per
+       state */
+    class FnBatchStatePropagator : public ompl::control::StatePropagator
+    {
+    public:
+        FnBatchStatePropagator(ompl::control::SpaceInformation *si, ompl::control::BatchStatePropagatorFn fn)
+          : StatePropagator(si), fn_(std::move(fn))
+        {
+        }
+
+        void propagate(const ompl::base::State *state, const ompl::control::Control *control, const double duration,
+                       ompl::base::State *result) const override
+        {
+            propagateBatch(std::vector<const ompl::base::State *>(1, state),
+                           std::vector<const ompl::control::Control *>(1, control), duration,
+                           std::vector<ompl::base::State *>(1, result));
+        }
+
+        void propagateBatch(const std::vector<const ompl::base::State *> &states,
+                            const std::vector<const ompl::control::Control *> &controls, double duration,
+                            const std::vector<ompl::base::State *> &results) const override
+        {
+            if (states.empty())
+                return;
+            std::vector<double> reals;
+            const ompl::base::StateSpace *space = si_->getStateSpace().get();
+            space->copyToReals(reals, states[0]);
+            Eigen::MatrixXd values(states.size(), reals.size());
+            for (std::size_t i = 0; i < states.size(); ++i)
+            {
+                if (i > 0)
+                    space->copyToReals(reals, states[i]);
+                values.row(i) = Eigen::Map<const Eigen::RowVectorXd>(reals.data(), reals.size());
+            }
+            const ompl::control::ControlSpace *controlSpace = si_->getControlSpace().get();
+            unsigned int dim = controlSpace->getDimension();
+            Eigen::MatrixXd controlValues(states.size(), dim);
+            for (std::size_t i = 0; i < states.size(); ++i)
+                for (unsigned int j = 0; j < dim; ++j)
+                {
+                    // the values are only read
+                    const double *value =
+                        controlSpace->getValueAddressAtIndex(const_cast<ompl::control::Control *>(controls[i]), j);
+                    if (value == nullptr)
+                        throw ompl::Exception("Batch state propagation needs access to the values of controls");
+                    controlValues(i, j) = *value;
+                }
+            Eigen::MatrixXd resultValues(states.size(), reals.size());
+            fn_(values, controlValues, duration, resultValues);
+            for (std::size_t i = 0; i < states.size(); ++i)
+            {
+                Eigen::Map<Eigen::RowVectorXd>(reals.data(), reals.size()) = resultValues.row(i);
+                space->copyFromReals(results[i], reals);
+            }
+        }
+
+        bool canPropagateBatch() const override
+        {
+            return true;
+        }
+
+    private:
+        ompl::control::BatchStatePropagatorFn fn_;
+    };
+}  // namespace
+
+void ompl::control::SpaceInformation::setBatchStatePropagator(const BatchStatePropagatorFn &fn)
+{
+    if (!fn)
+        throw Exception("Invalid function definition for batch state propagation");
+
+    setStatePropagator(std::make_shared<FnBatchStatePropagator>(this, fn));
+}
+
 bool ompl::control::SpaceInformation::canPropagateBackward() const
 {
     if (statePropagator_)
@@ -237,6 +313,33 @@ unsigned int ompl::control::SpaceInformation::propagateWhileValidTest(const base
     double signedStepSize = steps > 0 ? stepSize_ : -stepSize_;
     steps = abs(steps);
 
+    if (stateValidityChecker_->getSpecs().hasBatchValidityComputation)
+    {
+        // propagate all the steps first, so that the checker sees them (and their times) in a single call
+        std::vector<base::State *> states(steps);
+        allocStates(states);
+        std::vector<double> times(steps);
+        const base::State *previous = state;
+        for (int i = 0; i < steps; ++i)
+        {
+            statePropagator_->propagate(previous, control, signedStepSize, states[i]);
+            times[i] = time + (i + 1) * stepSize_;
+            previous = states[i];
+        }
+        std::vector<int> valid;
+        stateValidityChecker_->areValid(std::vector<const base::State *>(states.begin(), states.end()), times,
+                                        valid);
+        unsigned int r = 0;
+        while (r < (unsigned int)steps && valid[r] != 0)
+            ++r;
+        if (r > 0)
+            copyState(result, states[r - 1]);
+        else if (result != state)
+            copyState(result, state);
+        freeStates(states);
+        return r;
+    }
+
     // perform the first step of propagation
     statePropagator_->propagate(state, control, signedStepSize, result);
     time += stepSize_;
@@ -281,6 +384,96 @@ unsigned int ompl::control::SpaceInformation::propagateWhileValidTest(const base
     return 0;
 }
 
+void ompl::control::SpaceInformation::propagateBatchWhileValid(const base::State *state,
+                                                               const std::vector<const Control *> &controls,
+                                                               std::vector<unsigned int> &steps,
+                                                               const std::vector<base::State *> &results) const
+{
+    propagateBatchWhileValid(state, controls, steps, results, nullptr);
+}
+
+void ompl::control::SpaceInformation::propagateBatchWhileValidTest(const base::State *state,
+                                                                   const std::vector<const Control *> &controls,
+                                                                   std::vector<unsigned int> &steps,
+                                                                   const std::vector<base::State *> &results,
+                                                                   unsigned int previousSteps) const
+{
+    double startTime = stepSize_ * previousSteps;
+    propagateBatchWhileValid(state, controls, steps, results, &startTime);
+}
+
+void ompl::control::SpaceInformation::propagateBatchWhileValid(const base::State *state,
+                                                               const std::vector<const Control *> &controls,
+                                                               std::vector<unsigned int> &steps,
+                                                               const std::vector<base::State *> &results,
+                                                               const double *startTime) const
+{
+    // the last valid state of every propagation and the state its next step reaches
+    std::vector<base::State *> current(controls.size()), next(controls.size());
+    allocStates(current);
+    allocStates(next);
+    std::vector<unsigned int> done(controls.size(), 0);
+    std::vector<std::size_t> running;
+    for (std::size_t i = 0; i < controls.size(); ++i)
+    {
+        copyState(current[i], state);
+        if (steps[i] > 0)
+            running.push_back(i);
+    }
+
+    std::vector<const base::State *> from;
+    std::vector<const Control *> applied;
+    std::vector<base::State *> to;
+    std::vector<double> times;
+    std::vector<int> valid;
+    for (unsigned int step = 1; !running.empty(); ++step)
+    {
+        from.clear();
+        applied.clear();
+        to.clear();
+        for (std::size_t i : running)
+        {
+            from.push_back(current[i]);
+            applied.push_back(controls[i]);
+            to.push_back(next[i]);
+        }
+        statePropagator_->propagateBatch(from, applied, stepSize_, to);
+
+        std::vector<const base::State *> reached(to.begin(), to.end());
+        if (startTime != nullptr)
+        {
+            times.assign(running.size(), *startTime + step * stepSize_);
+            stateValidityChecker_->areValid(reached, times, valid);
+        }
+        else if (stateValidityChecker_->getSpecs().hasBatchValidityComputation)
+            stateValidityChecker_->areValid(reached, valid);
+        else
+        {
+            valid.resize(reached.size());
+            for (std::size_t j = 0; j < reached.size(); ++j)
+                valid[j] = isValid(reached[j]) ? 1 : 0;
+        }
+
+        std::size_t stillRunning = 0;
+        for (std::size_t j = 0; j < running.size(); ++j)
+        {
+            std::size_t i = running[j];
+            if (valid[j] == 0)
+                continue;
+            std::swap(current[i], next[i]);
+            if (++done[i] < steps[i])
+                running[stillRunning++] = i;
+        }
+        running.resize(stillRunning);
+    }
+
+    for (std::size_t i = 0; i < controls.size(); ++i)
+        copyState(results[i], current[i]);
+    freeStates(current);
+    freeStates(next);
+    steps = done;
+}
+
 void ompl::control::SpaceInformation::propagate(const base::State *state, const Control *control, int steps,
                                                 std::vector<base::State *> &result, bool alloc) const
 {
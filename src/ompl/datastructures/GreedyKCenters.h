@@ -38,7 +38,12 @@
 #define OMPL_DATASTRUCTURES_GREEDY_K_CENTERS_
 
 #include "ompl/util/RandomNumbers.h"
+#include "ompl/util/WorkerPool.h"
+#include <algorithm>
 #include <functional>
+#include <limits>
+#include <memory>
+#include <vector>
 #include <Eigen/Core>
 
 namespace ompl
@@ -52,6 +57,10 @@ namespace ompl
     public:
         /** \brief The definition of a distance function */
         using DistanceFunction = std::function<double(const _T &, const _T &)>;
+        /** \brief The definition of a function that computes the distances between all points in \e data and
+            \e center at once, storing the distance to data[i] in \e dists[i] */
+        using BatchDistanceFunction =
+            std::function<void(const std::vector<_T> &data, const _T &center, Eigen::Ref<Eigen::VectorXd> dists)>;
         /** \brief A matrix type for storing distances between points and centers */
         using Matrix = Eigen::MatrixXd;
 
@@ -71,19 +80,74 @@ namespace ompl
             return distFun_;
         }
 
+        /** \brief Set a function that computes the distances from all points to a center in one call. This
+            avoids one call through the distance function per pair of points and allows vectorized
+            implementations (e.g., for points in R^n). It must be consistent with the distance function. */
+        void setBatchDistanceFunction(const BatchDistanceFunction &batchDistFun)
+        {
+            batchDistFun_ = batchDistFun;
+        }
+
+        /** \brief Get the batch distance function used (may be empty) */
+        const BatchDistanceFunction &getBatchDistanceFunction() const
+        {
+            return batchDistFun_;
+        }
+
+        /** \brief Return a batch distance function computing Euclidean distances between points of
+            R^\e dimension. \e coordinates returns the array of \e dimension coordinates of a point. */
+        static BatchDistanceFunction euclideanDistances(std::function<const double *(const _T &)> coordinates,
+                                                        unsigned int dimension)
+        {
+            return [coordinates = std::move(coordinates), dimension](const std::vector<_T> &data, const _T &center,
+                                                                     Eigen::Ref<Eigen::VectorXd> dists)
+            {
+                const Eigen::Map<const Eigen::VectorXd> c(coordinates(center), dimension);
+                for (std::size_t i = 0; i < data.size(); ++i)
+                    dists[i] = (Eigen::Map<const Eigen::VectorXd>(coordinates(data[i]), dimension) - c).norm();
+            };
+        }
+
+        /** \brief Set the number of threads used to compute distances to a center when there are at least
+            getMinParallelSize() data points. The distance function must be thread safe. The threads are
+            started on first use and kept until the number of threads changes. */
+        void setNumThreads(unsigned int numThreads)
+        {
+            numThreads_ = std::max(numThreads, 1u);
+        }
+
+        /** \brief Get the number of threads used to compute distances */
+        unsigned int getNumThreads() const
+        {
+            return numThreads_;
+        }
+
+        /** \brief Set the minimum number of data points for which distances are computed in parallel */
+        void setMinParallelSize(std::size_t minParallelSize)
+        {
+            minParallelSize_ = minParallelSize;
+        }
+
+        /** \brief Get the minimum number of data points for which distances are computed in parallel */
+        std::size_t getMinParallelSize() const
+        {
+            return minParallelSize_;
+        }
+
         /** \brief Greedy algorithm for selecting k centers
             \param data a vector of data points
             \param k the desired number of centers
             \param centers a vector of length k containing the indices into
                 data of the k centers
             \param dists a matrix such that dists(i,j) is the distance
-                between data[i] and data[center[j]]
+                between data[i] and data[center[j]]. It is only resized if
+                it is too small, so it can be reused as scratch space.
         */
         void kcenters(const std::vector<_T> &data, unsigned int k, std::vector<unsigned int> &centers, Matrix &dists)
         {
             // array containing the minimum distance between each data point
             // and the centers computed so far
-            std::vector<double> minDist(data.size(), std::numeric_limits<double>::infinity());
+            minDist_.assign(data.size(), std::numeric_limits<double>::infinity());
 
             centers.clear();
             centers.reserve(k);
@@ -94,17 +158,17 @@ namespace ompl
             for (unsigned i = 1; i < k; ++i)
             {
                 unsigned ind = 0;
-                const _T &center = data[centers[i - 1]];
                 double maxDist = -std::numeric_limits<double>::infinity();
+                computeDistances(data, data[centers[i - 1]], dists, i - 1);
                 for (unsigned j = 0; j < data.size(); ++j)
                 {
-                    if ((dists(j, i - 1) = distFun_(data[j], center)) < minDist[j])
-                        minDist[j] = dists(j, i - 1);
+                    if (dists(j, i - 1) < minDist_[j])
+                        minDist_[j] = dists(j, i - 1);
                     // the j-th center is the one furthest away from center 0,..,j-1
-                    if (minDist[j] > maxDist)
+                    if (minDist_[j] > maxDist)
                     {
                         ind = j;
-                        maxDist = minDist[j];
+                        maxDist = minDist_[j];
                     }
                 }
                 // no more centers available
@@ -113,16 +177,57 @@ namespace ompl
                 centers.push_back(ind);
             }
 
-            const _T &center = data[centers.back()];
-            unsigned i = centers.size() - 1;
-            for (unsigned j = 0; j < data.size(); ++j)
-                dists(j, i) = distFun_(data[j], center);
+            computeDistances(data, data[centers.back()], dists, centers.size() - 1);
         }
 
     protected:
+        /** \brief Compute the distances from all points in \e data to \e center and store them in column
+            \e col of \e dists */
+        void computeDistances(const std::vector<_T> &data, const _T &center, Matrix &dists, unsigned int col) const
+        {
+            const std::size_t n = data.size();
+            if (batchDistFun_)
+            {
+                batchDistFun_(data, center, dists.col(col).head(n));
+                return;
+            }
+            double *column = dists.col(col).data();
+            auto compute = [&](std::size_t begin, std::size_t end)
+            {
+                for (std::size_t j = begin; j < end; ++j)
+                    column[j] = distFun_(data[j], center);
+            };
+            if (numThreads_ < 2 || n < minParallelSize_)
+            {
+                compute(0, n);
+                return;
+            }
+            if (!workers_ || workers_->getNumThreads() != numThreads_)
+                workers_ = std::make_unique<WorkerPool>(numThreads_);
+            // split the points in contiguous blocks, one per thread
+            const std::size_t block = (n + numThreads_ - 1) / numThreads_;
+            workers_->parallelFor((n + block - 1) / block, [&](unsigned int /*thread*/, std::size_t b)
+                                  { compute(b * block, std::min((b + 1) * block, n)); });
+        }
+
         /** \brief The used distance function */
         DistanceFunction distFun_;
 
+        /** \brief Optional function computing many distances at once */
+        BatchDistanceFunction batchDistFun_;
+
+        /** \brief Number of threads used to compute distances */
+        unsigned int numThreads_{1u};
+
+        /** \brief Minimum number of data points for which distances are computed in parallel */
+        std::size_t minParallelSize_{4096u};
+
+        /** \brief Threads computing distances, kept between calls */
+        mutable std::unique_ptr<WorkerPool> workers_;
+
+        /** \brief Scratch space for the distance from each point to the nearest center */
+        std::vector<double> minDist_;
+
         /** Random number generator used to select first center */
         RNG rng_;
     };
@@ -126,6 +126,13 @@ namespace ompl
                 rebuildDataStructure();
         }
 
+        /// \brief Get the object that selects pivots when nodes are split,
+        /// e.g., to give it a batch distance function or more threads.
+        GreedyKCenters<_T> &getPivotSelector()
+        {
+            return pivotSelector_;
+        }
+
         void clear() override
         {
             if (tree_)
@@ -150,6 +157,15 @@ namespace ompl
             {
                 if (isRemoved(data))
                     rebuildDataStructure();
+                // Rebalancing at the root is limited to small trees, so that the cost of a single
+                // insertion stays bounded. Larger trees are rebalanced one subtree at a time.
+                else if (size_ >= rebuildSize_ && !tree_->children_.empty() &&
+                         rebuildSize_ <= maxNumPtsPerLeaf_ * degree_ * degree_)
+                {
+                    rebuildSize_ <<= 1;
+                    tree_->rebuild(*this, data);
+                    return;
+                }
                 tree_->add(*this, data);
             }
             else
@@ -165,9 +181,7 @@ namespace ompl
             else if (!data.empty())
             {
                 tree_ = new Node(degree_, maxNumPtsPerLeaf_, data[0]);
-#ifdef GNAT_SAMPLER
-                tree_->subtreeSize_ = data.size();
-#endif
+                tree_->subtreeSize_ = tree_->buildSize_ = data.size();
                 tree_->data_.insert(tree_->data_.end(), data.begin() + 1, data.end());
                 size_ += data.size();
                 if (tree_->needToSplit(*this))
@@ -184,9 +198,10 @@ namespace ompl
         }
         /// \brief Remove data from the tree.
         /// The element won't actually be removed immediately, but just marked
-        /// for removal in the removed_ cache. When the cache is full, the tree
-        /// will be rebuilt and the elements marked for removal will actually
-        /// be removed.
+        /// for removal in the removed_ cache. When the cache is full, the
+        /// elements marked for removal are purged from the leaves in place.
+        /// If data is a pivot, only the subtree rooted at the node with that
+        /// pivot is rebuilt.
         bool remove(const _T &data) override
         {
             if (size_ == 0u)
@@ -199,10 +214,17 @@ namespace ompl
                 return false;
             removed_.insert(d);
             size_--;
-            // if we removed a pivot or if the capacity of removed elements
-            // has been reached, we rebuild the entire GNAT
-            if (isPivot || removed_.size() >= removedCacheSize_)
-                rebuildDataStructure();
+            // if we removed a pivot, we rebuild the subtree that uses it;
+            // if the capacity of removed elements has been reached, we
+            // purge them from the leaves of the GNAT
+            if (isPivot)
+            {
+                std::vector<Node *> path;
+                tree_->findPivot(d, path);
+                rebuildSubtree(path, data);
+            }
+            else if (removed_.size() >= removedCacheSize_)
+                tree_->purge(*this);
             return true;
         }
 
@@ -328,6 +350,96 @@ namespace ompl
             return !removed_.empty() && removed_.find(&data) != removed_.end();
         }
 
+        /// \brief Rebuild the subtree rooted at path.back() after its pivot
+        /// \e oldPivot was removed. The element closest to \e oldPivot becomes
+        /// the new pivot, so that the ranges stored for the parent's other
+        /// children can be updated with the triangle inequality instead of
+        /// being recomputed.
+        void rebuildSubtree(const std::vector<Node *> &path, const _T &oldPivot)
+        {
+            Node *node = path.back();
+            Node *parent = path.size() > 1 ? path[path.size() - 2] : nullptr;
+            std::vector<_T> lst;
+
+            // The pivot of the root is not used to bound any distances, so it
+            // can be replaced by any element taken from a leaf.
+            if (parent == nullptr && !node->children_.empty() && node->takeElement(*this, lst))
+            {
+                auto *replacement = new Node(node->degree_, maxNumPtsPerLeaf_, lst.back());
+                replacement->minRadius_ = node->minRadius_;
+                replacement->maxRadius_ = node->maxRadius_;
+                replacement->subtreeSize_ = node->subtreeSize_;
+                replacement->buildSize_ = node->buildSize_;
+                replacement->children_.swap(node->children_);
+                removed_.erase(&node->pivot_);
+                tree_ = replacement;
+                delete node;
+                return;
+            }
+
+            node->purgeAndList(*this, lst);
+            // the ancestors of node count the elements of its subtree, including those just purged
+            for (std::size_t i = 0; i + 1 < path.size(); ++i)
+                path[i]->subtreeSize_ -= node->subtreeSize_;
+            if (lst.empty())
+            {
+                if (parent == nullptr)
+                    clear();
+                else
+                {
+                    unsigned int idx = std::find(parent->children_.begin(), parent->children_.end(), node) -
+                                       parent->children_.begin();
+                    parent->children_.erase(parent->children_.begin() + idx);
+                    for (auto &child : parent->children_)
+                    {
+                        child->minRange_.erase(child->minRange_.begin() + idx);
+                        child->maxRange_.erase(child->maxRange_.begin() + idx);
+                    }
+                    parent->degree_ = std::max(minDegree_, (unsigned int)parent->children_.size());
+                    delete node;
+                }
+                return;
+            }
+
+            std::size_t best = 0;
+            double delta = NearestNeighbors<_T>::distFun_(oldPivot, lst[0]), dist;
+            for (std::size_t i = 1; i < lst.size(); ++i)
+                if ((dist = NearestNeighbors<_T>::distFun_(oldPivot, lst[i])) < delta)
+                {
+                    delta = dist;
+                    best = i;
+                }
+            std::swap(lst[best], lst.back());
+
+            auto *replacement = new Node(node->degree_, maxNumPtsPerLeaf_, lst.back());
+            lst.pop_back();
+            replacement->minRange_ = node->minRange_;
+            replacement->maxRange_ = node->maxRange_;
+            for (unsigned int i = 0; i < replacement->minRange_.size(); ++i)
+            {
+                replacement->minRange_[i] = std::max(0., replacement->minRange_[i] - delta);
+                replacement->maxRange_[i] += delta;
+            }
+            for (const auto &d : lst)
+                replacement->updateRadius(NearestNeighbors<_T>::distFun_(replacement->pivot_, d));
+            if (replacement->minRadius_ >= std::numeric_limits<double>::infinity())
+                replacement->minRadius_ = replacement->maxRadius_ = 0.;
+            replacement->subtreeSize_ = replacement->buildSize_ = lst.size() + 1;
+            for (std::size_t i = 0; i + 1 < path.size(); ++i)
+                path[i]->subtreeSize_ += replacement->subtreeSize_;
+            replacement->data_.swap(lst);
+            // pointers into data_ are stored in removed_, so it must not be reallocated on insertion
+            replacement->data_.reserve(maxNumPtsPerLeaf_ + 1);
+
+            if (parent == nullptr)
+                tree_ = replacement;
+            else
+                *std::find(parent->children_.begin(), parent->children_.end(), node) = replacement;
+            delete node;
+            if (replacement->needToSplit(*this))
+                replacement->split(*this);
+        }
+
         /// \brief Return in nbhQueue the k nearest neighbors of data.
         /// For k=1, return true if the nearest neighbor is a pivot.
         /// (which is important during removal; removing pivots is a
@@ -396,8 +508,9 @@ namespace ompl
               , maxRadius_(-minRadius_)
               , minRange_(degree, minRadius_)
               , maxRange_(degree, maxRadius_)
-#ifdef GNAT_SAMPLER
               , subtreeSize_(1)
+              , buildSize_(1)
+#ifdef GNAT_SAMPLER
               , activity_(0)
 #endif
             {
@@ -443,24 +556,19 @@ namespace ompl
             /// Add an element to the tree rooted at this node.
             void add(GNAT &gnat, const _T &data)
             {
-#ifdef GNAT_SAMPLER
-                subtreeSize_++;
-#endif
                 if (children_.empty())
                 {
+                    subtreeSize_++;
+                    // removed_ stores pointers into data_, so they must be purged before data_ is reallocated
+                    if (data_.size() == data_.capacity())
+                        purge(gnat);
                     data_.push_back(data);
                     gnat.size_++;
                     if (needToSplit(gnat))
                     {
-                        if (!gnat.removed_.empty())
-                            gnat.rebuildDataStructure();
-                        else if (gnat.size_ >= gnat.rebuildSize_)
-                        {
-                            std::size_t rebuildSize = gnat.rebuildSize_ << 1;
-                            gnat.rebuildDataStructure();
-                            gnat.rebuildSize_ = rebuildSize;
-                        }
-                        else
+                        // elements marked for removal must not be moved to child nodes
+                        purge(gnat);
+                        if (needToSplit(gnat))
                             split(gnat);
                     }
                 }
@@ -479,7 +587,17 @@ namespace ompl
                     for (unsigned int i = 0; i < children_.size(); ++i)
                         children_[i]->updateRange(minInd, dist[i]);
                     children_[minInd]->updateRadius(minDist);
-                    children_[minInd]->add(gnat, data);
+                    // with rebalancing enabled, a subtree that has doubled in size
+                    // since it was built is rebuilt in place (keeping its pivot)
+                    Node *child = children_[minInd];
+                    const unsigned int childSize = child->subtreeSize_;
+                    if (gnat.rebuildSize_ != std::numeric_limits<std::size_t>::max() && !child->children_.empty() &&
+                        child->subtreeSize_ >= 2 * child->buildSize_)
+                        child->rebuild(gnat, data);
+                    else
+                        child->add(gnat, data);
+                    // the child grew by one, less the elements it purged
+                    subtreeSize_ = subtreeSize_ - childSize + child->subtreeSize_;
                 }
             }
             /// Return true iff the node needs to be split into child nodes.
@@ -493,8 +611,8 @@ namespace ompl
             /// child node.
             void split(GNAT &gnat)
             {
-                typename GreedyKCenters<_T>::Matrix dists(data_.size(), degree_);
-                std::vector<unsigned int> pivots;
+                typename GreedyKCenters<_T>::Matrix &dists = gnat.distances_;
+                std::vector<unsigned int> &pivots = gnat.pivots_;
 
                 children_.reserve(degree_);
                 gnat.pivotSelector_.kcenters(data_, degree_, pivots, dists);
@@ -527,11 +645,10 @@ namespace ompl
                     // singleton
                     if (child->minRadius_ >= std::numeric_limits<double>::infinity())
                         child->minRadius_ = child->maxRadius_ = 0.;
-#ifdef GNAT_SAMPLER
                     // set subtree size
-                    child->subtreeSize_ = child->data_.size() + 1;
-#endif
+                    child->subtreeSize_ = child->buildSize_ = child->data_.size() + 1;
                 }
+                buildSize_ = subtreeSize_;
                 // this does more than clear(); it also sets capacity to 0 and frees the memory
                 std::vector<_T> tmp;
                 data_.swap(tmp);
@@ -539,6 +656,9 @@ namespace ompl
                 for (auto &child : children_)
                     if (child->needToSplit(gnat))
                         child->split(gnat);
+                // don't hold on to the scratch space needed to split a large node
+                if ((std::size_t)gnat.distances_.rows() > 16 * ((std::size_t)gnat.maxNumPtsPerLeaf_ + 1))
+                    gnat.distances_.resize(0, 0);
             }
 
             /// Insert data in nbh if it is a near neighbor. Return true iff data was added to nbh.
@@ -691,6 +811,109 @@ namespace ompl
             }
 #endif
 
+            /// \brief Rebuild the subtree below this node from scratch, keeping
+            /// the pivot (and therefore the bounds stored in the parent) intact.
+            /// The element \e data is added to the subtree as well.
+            void rebuild(GNAT &gnat, const _T &data)
+            {
+                std::vector<_T> lst;
+                for (const auto &d : data_)
+                    if (gnat.removed_.erase(&d) == 0u)
+                        lst.push_back(d);
+                for (auto &child : children_)
+                {
+                    child->purgeAndList(gnat, lst);
+                    delete child;
+                }
+                children_.clear();
+                lst.push_back(data);
+                gnat.size_++;
+                data_.swap(lst);
+                data_.reserve(gnat.maxNumPtsPerLeaf_ + 1);
+                subtreeSize_ = buildSize_ = data_.size() + 1;
+                degree_ = std::max(degree_, gnat.minDegree_);
+                if (needToSplit(gnat))
+                    split(gnat);
+            }
+
+            /// \brief Remove the elements marked for removal from the data_
+            /// of this node and its descendants. Pivots are never purged.
+            void purge(GNAT &gnat)
+            {
+                if (gnat.removed_.empty())
+                    return;
+                std::size_t j = 0;
+                for (std::size_t i = 0; i < data_.size(); ++i)
+                    if (gnat.removed_.erase(&data_[i]) == 0u)
+                    {
+                        if (i != j)
+                            data_[j] = std::move(data_[i]);
+                        ++j;
+                    }
+                subtreeSize_ -= data_.size() - j;
+                data_.erase(data_.begin() + j, data_.end());
+                for (auto &child : children_)
+                {
+                    const unsigned int childSize = child->subtreeSize_;
+                    child->purge(gnat);
+                    subtreeSize_ -= childSize - child->subtreeSize_;
+                }
+            }
+
+            /// \brief Append all elements in the subtree rooted at this node to
+            /// \e data, except those marked for removal. The latter are taken
+            /// out of the removed_ cache.
+            void purgeAndList(GNAT &gnat, std::vector<_T> &data) const
+            {
+                if (gnat.removed_.erase(&pivot_) == 0u)
+                    data.push_back(pivot_);
+                for (const auto &d : data_)
+                    if (gnat.removed_.erase(&d) == 0u)
+                        data.push_back(d);
+                for (const auto &child : children_)
+                    child->purgeAndList(gnat, data);
+            }
+
+            /// \brief Move one element that is not a pivot from the subtree
+            /// rooted at this node to \e data. Return false if there is none.
+            bool takeElement(GNAT &gnat, std::vector<_T> &data)
+            {
+                if (!data_.empty())
+                    purge(gnat);
+                if (!data_.empty())
+                {
+                    data.push_back(data_.back());
+                    data_.pop_back();
+                    subtreeSize_--;
+                    return true;
+                }
+                for (auto &child : children_)
+                {
+                    // the child shrinks by the element taken and by the elements it purged
+                    const unsigned int childSize = child->subtreeSize_;
+                    const bool taken = child->takeElement(gnat, data);
+                    subtreeSize_ -= childSize - child->subtreeSize_;
+                    if (taken)
+                        return true;
+                }
+                return false;
+            }
+
+            /// \brief Find the node whose pivot is stored at address \e pivot.
+            /// On success, \e path contains the nodes from this node down to
+            /// that node.
+            bool findPivot(const _T *pivot, std::vector<Node *> &path)
+            {
+                path.push_back(this);
+                if (&pivot_ == pivot)
+                    return true;
+                for (auto &child : children_)
+                    if (child->findPivot(pivot, path))
+                        return true;
+                path.pop_back();
+                return false;
+            }
+
             void list(const GNAT &gnat, std::vector<_T> &data) const
             {
                 if (!gnat.isRemoved(pivot_))
@@ -751,9 +974,11 @@ namespace ompl
             /// \brief The child nodes of this node. By definition, only internal nodes
             /// have child nodes.
             std::vector<Node *> children_;
-#ifdef GNAT_SAMPLER
             /// Number of elements stored in the subtree rooted at this Node
             unsigned int subtreeSize_;
+            /// Number of elements stored in the subtree rooted at this Node when it was last split
+            unsigned int buildSize_;
+#ifdef GNAT_SAMPLER
             /// \brief The extent to which a Node's maxRadius_ is increasing. A value of 0
             /// means the Node's maxRadius_ was increased the last time an element was added,
             /// while a negative value i means the Node hasn't expanded the last -i times
@@ -782,16 +1007,24 @@ namespace ompl
         /// \brief Number of elements stored in the tree.
         std::size_t size_{0};
         /// \brief If size_ exceeds rebuildSize_, the tree will be rebuilt (and
-        /// automatically rebalanced), and rebuildSize_ will be doubled.
+        /// automatically rebalanced), and rebuildSize_ will be doubled. This
+        /// only happens while the tree is small; afterwards, subtrees that have
+        /// doubled in size since they were built are rebuilt individually. If
+        /// rebalancing is disabled, rebuildSize_ is std::numeric_limits<std::size_t>::max().
         std::size_t rebuildSize_;
         /// \brief Maximum number of removed elements that can be stored in the
-        /// removed_ cache. If the cache is full, the tree will be rebuilt with
-        /// the elements in removed_ actually removed from the tree.
+        /// removed_ cache. If the cache is full, the elements in removed_ are
+        /// purged from the leaves of the tree.
         std::size_t removedCacheSize_;
         /// \brief The data structure used to split data into subtrees.
         GreedyKCenters<_T> pivotSelector_;
         /// \brief Cache of removed elements.
         std::unordered_set<const _T *> removed_;
+        /// \brief Pivot indices within a vector of elements as selected by GreedyKCenters
+        /// (scratch space for splits, which only happen while adding or removing elements)
+        std::vector<unsigned int> pivots_;
+        /// \brief Matrix of distances to pivots (scratch space for splits)
+        typename GreedyKCenters<_T>::Matrix distances_;
 #ifdef GNAT_SAMPLER
         /// \brief Estimated dimension of the local free space.
         double estimatedDimension_;
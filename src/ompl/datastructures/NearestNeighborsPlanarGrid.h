@@ -0,0 +1,446 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2026, the MROR Multi-Robot OMPL contributors
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+/* Author: MROR Multi-Robot OMPL contributors */
+
+#ifndef OMPL_DATASTRUCTURES_NEAREST_NEIGHBORS_PLANAR_GRID_
+#define OMPL_DATASTRUCTURES_NEAREST_NEIGHBORS_PLANAR_GRID_
+
+#include "ompl/datastructures/NearestNeighbors.h"
+#include "ompl/util/Exception.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <queue>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ompl
+{
+    /** \brief A nearest neighbors datastructure for distances that are bounded from below by the Euclidean
+        distance between planar positions of the elements, such as Dubins and Reeds-Shepp distances. The
+        distance does not need to be a metric.
+
+        Elements are stored in a uniform grid over their positions. Queries visit the grid cells in rings of
+        increasing distance around the query and stop as soon as no element of the remaining rings can be
+        closer than the neighbors found so far. For the elements of the visited cells, the Euclidean distance
+        and an optional lower bound function are checked first; the (expensive) distance function is only
+        evaluated for elements that pass these checks. With a batch distance function, the distances of the
+        elements that pass in each ring are computed in one call. The results are exact.
+
+        The cell size is chosen from the bounding box of the elements such that cells hold a few elements
+        each. The grid is rebuilt whenever the number of elements doubles, and whenever the elements spread
+        over many more cells than there are elements (e.g., when the first elements are far apart). After
+        each rebuild of the second kind, the number of cells that triggers it doubles until the number of
+        elements doubles, so elements that keep spreading out do not cause a rebuild on every addition.
+
+        The pruning is only correct if the distance function set with setDistanceFunction() is bounded from
+        below by the Euclidean distance of the positions (and by the optional lower bound). This holds for
+        the distance of a Dubins or Reeds-Shepp space, but not, e.g., for the motion cost of an arbitrary
+        optimization objective; with such a distance function, the results may miss the nearest elements.
+
+        \li Search for nearest neighbors is O(sqrt(n)) in the worst case, and much less when the elements
+        are spread out over the plane.
+        \li Adding an element to the datastructure is O(1) amortized.
+        \li Removing an element from the datastructure is O(1) on average.
+    */
+    template <typename _T>
+    class NearestNeighborsPlanarGrid : public NearestNeighbors<_T>
+    {
+    public:
+        /** \brief The definition of the function that returns the planar position of an element */
+        using PositionFunction = std::function<std::array<double, 2>(const _T &)>;
+
+        /** \brief The definition of a lower bound of the distance function. It must not exceed the
+            distance function in either direction. */
+        using LowerBoundFunction = std::function<double(const _T &, const _T &)>;
+
+        /** \brief The definition of a function that computes the distances from each of the elements in its first
+            argument to its second argument at once. It must give the same results as the distance function. */
+        using BatchDistanceFunction = std::function<void(const std::vector<_T> &, const _T &, std::vector<double> &)>;
+
+        /** \brief Construct the datastructure. The Euclidean distance between the positions returned by
+            \e position must be a lower bound of the distance function. \e lowerBound is an optional additional
+            lower bound, checked before the distance function is evaluated. */
+        NearestNeighborsPlanarGrid(PositionFunction position, LowerBoundFunction lowerBound = LowerBoundFunction())
+          : position_(std::move(position)), lowerBound_(std::move(lowerBound))
+        {
+        }
+
+        ~NearestNeighborsPlanarGrid() override = default;
+
+        /** \brief Set a function that computes the distances of many elements to a query at once. Queries then
+            use it instead of calling the distance function for each element. */
+        void setBatchDistanceFunction(BatchDistanceFunction batchDistance)
+        {
+            batchDistance_ = std::move(batchDistance);
+        }
+
+        bool reportsSortedResults() const override
+        {
+            return true;
+        }
+
+        void clear() override
+        {
+            cells_.clear();
+            size_ = 0;
+            rebuildSize_ = MIN_REBUILD_SIZE;
+            maxCellsPerElement_ = MAX_CELLS_PER_ELEMENT;
+            cellSize_ = 1.0;
+            resetCellRange();
+        }
+
+        void add(const _T &data) override
+        {
+            std::array<double, 2> p = position_(data);
+            insert(Entry{data, p[0], p[1]});
+            if (++size_ >= rebuildSize_)
+            {
+                maxCellsPerElement_ = MAX_CELLS_PER_ELEMENT;
+                rebuild();
+            }
+            else if (tooManyCells())
+            {
+                maxCellsPerElement_ *= 2.0;
+                rebuild();
+            }
+        }
+
+        bool remove(const _T &data) override
+        {
+            if (size_ == 0)
+                return false;
+            std::array<double, 2> p = position_(data);
+            auto it = cells_.find(Cell{{cellIndex(p[0]), cellIndex(p[1])}});
+            if (it == cells_.end())
+                return false;
+            std::vector<Entry> &cell = it->second;
+            for (auto e = cell.begin(); e != cell.end(); ++e)
+                if (e->data == data)
+                {
+                    *e = cell.back();
+                    cell.pop_back();
+                    if (cell.empty())
+                        cells_.erase(it);
+                    --size_;
+                    return true;
+                }
+            return false;
+        }
+
+        _T nearest(const _T &data) const override
+        {
+            std::vector<_T> nbh;
+            nearestK(data, 1, nbh);
+            if (nbh.empty())
+                throw Exception("No elements found in nearest neighbors data structure");
+            return nbh[0];
+        }
+
+        void nearestK(const _T &data, std::size_t k, std::vector<_T> &nbh) const override
+        {
+            nbh.clear();
+            if (k == 0 || size_ == 0)
+                return;
+            // max-heap of the k closest elements found so far
+            std::priority_queue<Candidate> heap;
+            search(data, [&heap, k](const Entry &e, double d)
+                   {
+                       if (heap.size() < k)
+                           heap.emplace(d, &e.data);
+                       else if (d < heap.top().first)
+                       {
+                           heap.pop();
+                           heap.emplace(d, &e.data);
+                       }
+                   },
+                   [&heap, k]
+                   {
+                       return heap.size() == k ? heap.top().first : std::numeric_limits<double>::infinity();
+                   });
+            nbh.resize(heap.size());
+            for (std::size_t i = heap.size(); i > 0; --i)
+            {
+                nbh[i - 1] = *heap.top().second;
+                heap.pop();
+            }
+        }
+
+        void nearestR(const _T &data, double radius, std::vector<_T> &nbh) const override
+        {
+            nbh.clear();
+            if (size_ == 0)
+                return;
+            std::vector<Candidate> found;
+            search(data, [&found, radius](const Entry &e, double d)
+                   {
+                       if (d <= radius)
+                           found.emplace_back(d, &e.data);
+                   },
+                   [radius]
+                   {
+                       return radius;
+                   });
+            std::sort(found.begin(), found.end());
+            nbh.reserve(found.size());
+            for (const auto &c : found)
+                nbh.push_back(*c.second);
+        }
+
+        std::size_t size() const override
+        {
+            return size_;
+        }
+
+        void list(std::vector<_T> &data) const override
+        {
+            data.clear();
+            data.reserve(size_);
+            for (const auto &cell : cells_)
+                for (const auto &e : cell.second)
+                    data.push_back(e.data);
+        }
+
+        /** \brief Get the side length of the grid cells */
+        double getCellSize() const
+        {
+            return cellSize_;
+        }
+
+    protected:
+        /** \brief An element together with its position */
+        struct Entry
+        {
+            _T data;
+            double x, y;
+        };
+
+        /** \brief The distance of an element and a pointer to it */
+        using Candidate = std::pair<double, const _T *>;
+
+        /** \brief The number of elements at which the grid is first rebuilt */
+        static constexpr std::size_t MIN_REBUILD_SIZE = 16;
+
+        /** \brief The average number of elements per cell aimed for */
+        static constexpr double ELEMENTS_PER_CELL = 2.0;
+
+        /** \brief The number of cells per element in the range of occupied cells above which the grid is first
+            rebuilt (see maxCellsPerElement_) */
+        static constexpr double MAX_CELLS_PER_ELEMENT = 16.0;
+
+        std::int64_t cellIndex(double v) const
+        {
+            return static_cast<std::int64_t>(std::floor(v / cellSize_));
+        }
+
+        /** \brief The indices of a grid cell */
+        using Cell = std::array<std::int64_t, 2>;
+
+        struct CellHash
+        {
+            std::size_t operator()(const Cell &c) const
+            {
+                return static_cast<std::size_t>(static_cast<std::uint64_t>(c[0]) * 0x9E3779B97F4A7C15ULL ^
+                                                static_cast<std::uint64_t>(c[1]));
+            }
+        };
+
+        void resetCellRange()
+        {
+            minCell_ = {{std::numeric_limits<std::int64_t>::max(), std::numeric_limits<std::int64_t>::max()}};
+            maxCell_ = {{std::numeric_limits<std::int64_t>::min(), std::numeric_limits<std::int64_t>::min()}};
+        }
+
+        void insert(const Entry &e)
+        {
+            std::int64_t cx = cellIndex(e.x), cy = cellIndex(e.y);
+            cells_[Cell{{cx, cy}}].push_back(e);
+            minCell_[0] = std::min(minCell_[0], cx);
+            minCell_[1] = std::min(minCell_[1], cy);
+            maxCell_[0] = std::max(maxCell_[0], cx);
+            maxCell_[1] = std::max(maxCell_[1], cy);
+        }
+
+        /** \brief Return true if the range of occupied cells is so large compared to the number of elements
+            that queries scanning it would be slow, because the elements spread out beyond the bounding box
+            the cell size was chosen for */
+        bool tooManyCells() const
+        {
+            double cells = (double)(maxCell_[0] - minCell_[0] + 1) * (double)(maxCell_[1] - minCell_[1] + 1);
+            return cells > maxCellsPerElement_ * (double)size_;
+        }
+
+        /** \brief Choose the cell size from the bounding box of the elements and redistribute them */
+        void rebuild()
+        {
+            std::vector<Entry> entries;
+            entries.reserve(size_);
+            double lo[2] = {std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity()};
+            double hi[2] = {-lo[0], -lo[1]};
+            for (auto &cell : cells_)
+                for (auto &e : cell.second)
+                {
+                    lo[0] = std::min(lo[0], e.x);
+                    lo[1] = std::min(lo[1], e.y);
+                    hi[0] = std::max(hi[0], e.x);
+                    hi[1] = std::max(hi[1], e.y);
+                    entries.push_back(std::move(e));
+                }
+            double w = hi[0] - lo[0], h = hi[1] - lo[1];
+            double side = std::max(w, h);
+            if (side > 0.0)
+            {
+                // for (nearly) collinear elements, the area is that of a strip a few cells wide
+                double area = std::max(w * h, side * side / (double)size_);
+                cellSize_ = std::sqrt(area * ELEMENTS_PER_CELL / (double)size_);
+            }
+            cells_.clear();
+            resetCellRange();
+            for (const auto &e : entries)
+                insert(e);
+            rebuildSize_ = 2 * size_;
+        }
+
+        /** \brief Visit the cells in rings of increasing distance around the position of \e data, and call
+            \e visit with the distance of every element that might be closer than \e limit() */
+        template <typename Visit, typename Limit>
+        void search(const _T &data, const Visit &visit, const Limit &limit) const
+        {
+            std::array<double, 2> q = position_(data);
+            std::int64_t cx = cellIndex(q[0]), cy = cellIndex(q[1]);
+            // the distance from the query to the border of its cell
+            double fx = q[0] - cellSize_ * (double)cx, fy = q[1] - cellSize_ * (double)cy;
+            double border = std::max(0.0, std::min({fx, cellSize_ - fx, fy, cellSize_ - fy}));
+            // rings before the first one that overlaps the range of occupied cells are empty
+            std::int64_t first = std::max({minCell_[0] - cx, cx - maxCell_[0], minCell_[1] - cy, cy - maxCell_[1],
+                                           std::int64_t(0)});
+            std::int64_t rings = std::max({cx - minCell_[0], maxCell_[0] - cx, cy - minCell_[1], maxCell_[1] - cy,
+                                           std::int64_t(0)});
+
+            // with a batch distance function, the elements of a ring that pass the lower bounds are collected, and
+            // their distances are computed together once the ring is done
+            std::vector<const Entry *> candidates;
+            std::vector<_T> from;
+            std::vector<double> distances;
+
+            auto visitCell = [&](std::int64_t x, std::int64_t y) {
+                auto it = cells_.find(Cell{{x, y}});
+                if (it == cells_.end())
+                    return;
+                for (const auto &e : it->second)
+                {
+                    if (std::hypot(e.x - q[0], e.y - q[1]) > limit())
+                        continue;
+                    if (lowerBound_ && lowerBound_(e.data, data) > limit())
+                        continue;
+                    if (batchDistance_)
+                        candidates.push_back(&e);
+                    else
+                        visit(e, NearestNeighbors<_T>::distFun_(e.data, data));
+                }
+            };
+
+            auto visitCandidates = [&] {
+                if (candidates.empty())
+                    return;
+                from.clear();
+                for (const Entry *e : candidates)
+                    from.push_back(e->data);
+                batchDistance_(from, data, distances);
+                for (std::size_t i = 0; i < candidates.size(); ++i)
+                    visit(*candidates[i], distances[i]);
+                candidates.clear();
+            };
+
+            for (std::int64_t r = first; r <= rings; ++r)
+            {
+                // every element in ring r is at least this far from the query
+                if (r > 0 && cellSize_ * (double)(r - 1) + border > limit())
+                    break;
+                std::int64_t x0 = std::max(cx - r, minCell_[0]), x1 = std::min(cx + r, maxCell_[0]);
+                std::int64_t y0 = std::max(cy - r + 1, minCell_[1]), y1 = std::min(cy + r - 1, maxCell_[1]);
+                if (cy - r >= minCell_[1] && cy - r <= maxCell_[1])
+                    for (std::int64_t x = x0; x <= x1; ++x)
+                        visitCell(x, cy - r);
+                if (r > 0 && cy + r <= maxCell_[1] && cy + r >= minCell_[1])
+                    for (std::int64_t x = x0; x <= x1; ++x)
+                        visitCell(x, cy + r);
+                if (r > 0 && cx - r >= minCell_[0] && cx - r <= maxCell_[0])
+                    for (std::int64_t y = y0; y <= y1; ++y)
+                        visitCell(cx - r, y);
+                if (r > 0 && cx + r <= maxCell_[0] && cx + r >= minCell_[0])
+                    for (std::int64_t y = y0; y <= y1; ++y)
+                        visitCell(cx + r, y);
+                visitCandidates();
+            }
+        }
+
+        /** \brief The function returning the positions of elements */
+        PositionFunction position_;
+
+        /** \brief The optional additional lower bound of the distance function */
+        LowerBoundFunction lowerBound_;
+
+        /** \brief The optional function computing many distances at once */
+        BatchDistanceFunction batchDistance_;
+
+        /** \brief The elements in each (non-empty) grid cell */
+        std::unordered_map<Cell, std::vector<Entry>, CellHash> cells_;
+
+        /** \brief The number of elements in the datastructure */
+        std::size_t size_{0};
+
+        /** \brief The number of elements at which the grid is rebuilt next */
+        std::size_t rebuildSize_{MIN_REBUILD_SIZE};
+
+        /** \brief The number of cells per element in the range of occupied cells above which the grid is rebuilt
+            next; doubled after each such rebuild, and reset when the number of elements doubles */
+        double maxCellsPerElement_{MAX_CELLS_PER_ELEMENT};
+
+        /** \brief The side length of the grid cells */
+        double cellSize_{1.0};
+
+        /** \brief The smallest cell indices that (may) hold elements */
+        Cell minCell_{{std::numeric_limits<std::int64_t>::max(), std::numeric_limits<std::int64_t>::max()}};
+
+        /** \brief The largest cell indices that (may) hold elements */
+        Cell maxCell_{{std::numeric_limits<std::int64_t>::min(), std::numeric_limits<std::int64_t>::min()}};
+    };
+}
+
+#endif
@@ -45,6 +45,8 @@
 #include "ompl/util/ClassForward.h"
 
 #include <ode/ode.h>
+#include <atomic>
+#include <memory>
 #include <vector>
 #include <string>
 #include <map>
@@ -143,6 +145,40 @@ namespace ompl
 
             /** \brief Set the name of a body */
             void setGeomName(dGeomID geom, const std::string &name);
+
+            /** \brief Create an independent copy of this environment: a separate OpenDE world, collision spaces,
+                contact group and state bodies, with the state bodies listed in the same order as in stateBodies_.
+                Copies are used to simulate from multiple threads at the same time (see setWorldPoolSize()).
+                OpenDE worlds cannot be copied generically, so by default this function returns nullptr and all
+                simulations are serialized on mutex_. */
+            virtual OpenDEEnvironmentPtr clone() const;
+
+            /** \brief Create \e size copies of this environment using clone(), so that up to \e size threads
+                can propagate or collision check without waiting on mutex_. A value of 0 removes the copies.
+                Copies share nothing with this environment, so parameters changed afterwards are not seen by
+                them. This function is not thread-safe and should be called before planning starts. */
+            void setWorldPoolSize(unsigned int size);
+
+            /** \brief Get the number of copies of this environment available for parallel simulation */
+            unsigned int getWorldPoolSize() const
+            {
+                return worldPool_.size();
+            }
+
+            /** \brief Obtain an environment for exclusive use by the calling thread. A free copy from the
+                pool is taken without locking if one is available; otherwise this environment is returned
+                with mutex_ locked. The result must be given back with releaseWorld(). */
+            const OpenDEEnvironment *acquireWorld() const;
+
+            /** \brief Give back an environment obtained with acquireWorld() */
+            void releaseWorld(const OpenDEEnvironment *env) const;
+
+        private:
+            /** \brief Copies of this environment, used for parallel simulation */
+            std::vector<OpenDEEnvironmentPtr> worldPool_;
+
+            /** \brief For each copy in worldPool_, whether it is currently in use */
+            std::unique_ptr<std::atomic_flag[]> worldInUse_;
         };
     }
 }
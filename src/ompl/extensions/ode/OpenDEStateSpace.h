@@ -199,6 +199,23 @@ namespace ompl
                 simultaneously, but the results are unpredictable. */
             virtual void writeState(const base::State *state) const;
 
+            /** \brief Read the parameters of the state bodies of \e env (this
+                environment or one of its copies) and store them in \e state.
+                When \e env is this environment, the call is forwarded to
+                readState(base::State*), so existing overrides of that function
+                keep being used. Copies only exist when OpenDEEnvironment::clone()
+                is implemented; classes that override readState(base::State*) and
+                implement clone() must override this function as well. */
+            virtual void readState(base::State *state, const OpenDEEnvironment &env) const;
+
+            /** \brief Set the parameters of the state bodies of \e env (this
+                environment or one of its copies) to be the ones read from \e state.
+                When \e env is this environment, the call is forwarded to
+                writeState(const base::State*), so existing overrides of that
+                function keep being used. Classes that override writeState(const base::State*)
+                and implement OpenDEEnvironment::clone() must override this function as well. */
+            virtual void writeState(const base::State *state, const OpenDEEnvironment &env) const;
+
             /** \brief This is a convenience function provided for
                 optimization purposes. It checks whether a state
                 satisfies its bounds. Typically, in the process of
@@ -223,6 +240,12 @@ namespace ompl
             virtual bool evaluateCollision(const base::State *state) const;
 
         protected:
+            /** \brief Copy the state bodies of \e env into \e state (the default implementation of readState()) */
+            void readBodies(base::State *state, const OpenDEEnvironment &env) const;
+
+            /** \brief Copy \e state into the state bodies of \e env (the default implementation of writeState()) */
+            void writeBodies(const base::State *state, const OpenDEEnvironment &env) const;
+
             /** \brief Representation of the OpenDE parameters OMPL needs to plan */
             OpenDEEnvironmentPtr env_;
         };
@@ -35,6 +35,9 @@
 /* Author: Ioan Sucan */
 
 #include "ompl/extensions/ode/OpenDEEnvironment.h"
+#include "ompl/util/Exception.h"
+#include "ompl/util/Console.h"
+#include <thread>
 
 unsigned int ompl::control::OpenDEEnvironment::getMaxContacts(dGeomID /*geom1*/, dGeomID /*geom2*/) const
 {
@@ -69,3 +72,72 @@ void ompl::control::OpenDEEnvironment::setGeomName(dGeomID geom, const std::stri
 {
     geomNames_[geom] = name;
 }
+
+ompl::control::OpenDEEnvironmentPtr ompl::control::OpenDEEnvironment::clone() const
+{
+    return nullptr;
+}
+
+void ompl::control::OpenDEEnvironment::setWorldPoolSize(unsigned int size)
+{
+    worldPool_.clear();
+    worldInUse_.reset();
+    for (unsigned int i = 0; i < size; ++i)
+    {
+        OpenDEEnvironmentPtr env = clone();
+        if (!env)
+        {
+            OMPL_WARN("OpenDE environment cannot be cloned. Simulations will not run in parallel.");
+            worldPool_.clear();
+            return;
+        }
+        if (env->stateBodies_.size() != stateBodies_.size())
+            throw Exception("Clone of OpenDE environment has a different number of state bodies");
+        worldPool_.push_back(env);
+    }
+    if (size > 0)
+    {
+        worldInUse_.reset(new std::atomic_flag[size]);
+        for (unsigned int i = 0; i < size; ++i)
+            worldInUse_[i].clear();
+    }
+}
+
+const ompl::control::OpenDEEnvironment *ompl::control::OpenDEEnvironment::acquireWorld() const
+{
+    // start looking at a different copy in each thread, to reduce contention on the flags
+    static thread_local std::size_t start = std::hash<std::thread::id>()(std::this_thread::get_id());
+    const std::size_t n = worldPool_.size();
+    if (n > 0)
+    {
+        // OpenDE needs per-thread data for collision checking when built with thread-local storage
+        static thread_local bool odeThreadData = dAllocateODEDataForThread(dAllocateMaskAll) != 0;
+        (void)odeThreadData;
+    }
+    for (std::size_t k = 0; k < n; ++k)
+    {
+        std::size_t i = (start + k) % n;
+        if (!worldInUse_[i].test_and_set(std::memory_order_acquire))
+        {
+            start = i;
+            return worldPool_[i].get();
+        }
+    }
+    mutex_.lock();
+    return this;
+}
+
+void ompl::control::OpenDEEnvironment::releaseWorld(const OpenDEEnvironment *env) const
+{
+    if (env == this)
+    {
+        mutex_.unlock();
+        return;
+    }
+    for (std::size_t i = 0; i < worldPool_.size(); ++i)
+        if (worldPool_[i].get() == env)
+        {
+            worldInUse_[i].clear(std::memory_order_release);
+            return;
+        }
+}
@@ -101,29 +101,31 @@ namespace ompl
 void ompl::control::OpenDEStatePropagator::propagate(const base::State *state, const Control *control,
                                                      const double duration, base::State *result) const
 {
-    env_->mutex_.lock();
+    // take a copy of the OpenDE world no other thread is using (or lock the original one)
+    const OpenDEEnvironment *env = env_->acquireWorld();
+    const auto *space = si_->getStateSpace()->as<OpenDEStateSpace>();
 
     // place the OpenDE world at the start state
-    si_->getStateSpace()->as<OpenDEStateSpace>()->writeState(state);
+    space->writeState(state, *env);
 
     // apply the controls
-    env_->applyControl(control->as<RealVectorControlSpace::ControlType>()->values);
+    env->applyControl(control->as<RealVectorControlSpace::ControlType>()->values);
 
     // created contacts as needed
-    CallbackParam cp = {env_.get(), false};
-    for (auto &collisionSpace : env_->collisionSpaces_)
+    CallbackParam cp = {env, false};
+    for (auto &collisionSpace : env->collisionSpaces_)
         dSpaceCollide(collisionSpace, &cp, &nearCallback);
 
     // propagate one step forward
-    dWorldQuickStep(env_->world_, (dReal)duration);
+    dWorldQuickStep(env->world_, (dReal)duration);
 
     // remove created contacts
-    dJointGroupEmpty(env_->contactGroup_);
+    dJointGroupEmpty(env->contactGroup_);
 
     // read the final state from the OpenDE world
-    si_->getStateSpace()->as<OpenDEStateSpace>()->readState(result);
+    space->readState(result, *env);
 
-    env_->mutex_.unlock();
+    env_->releaseWorld(env);
 
     // update the collision flag for the start state, if needed
     if ((state->as<OpenDEStateSpace::StateType>()->collision & (1 << OpenDEStateSpace::STATE_COLLISION_KNOWN_BIT)) == 0)
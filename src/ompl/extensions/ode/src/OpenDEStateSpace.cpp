@@ -203,12 +203,12 @@ bool ompl::control::OpenDEStateSpace::evaluateCollision(const base::State *state
 {
     if ((state->as<StateType>()->collision & (1 << STATE_COLLISION_KNOWN_BIT)) != 0)
         return (state->as<StateType>()->collision & (1 << STATE_COLLISION_VALUE_BIT)) != 0;
-    env_->mutex_.lock();
-    writeState(state);
-    CallbackParam cp = {env_.get(), false};
-    for (unsigned int i = 0; !cp.collision && i < env_->collisionSpaces_.size(); ++i)
-        dSpaceCollide(env_->collisionSpaces_[i], &cp, &nearCallback);
-    env_->mutex_.unlock();
+    const OpenDEEnvironment *env = env_->acquireWorld();
+    writeState(state, *env);
+    CallbackParam cp = {env, false};
+    for (unsigned int i = 0; !cp.collision && i < env->collisionSpaces_.size(); ++i)
+        dSpaceCollide(env->collisionSpaces_[i], &cp, &nearCallback);
+    env_->releaseWorld(env);
     if (cp.collision)
         state->as<StateType>()->collision &= (1 << STATE_COLLISION_VALUE_BIT);
     state->as<StateType>()->collision &= (1 << STATE_COLLISION_KNOWN_BIT);
@@ -319,15 +319,29 @@ ompl::base::StateSamplerPtr ompl::control::OpenDEStateSpace::allocStateSampler()
 }
 
 void ompl::control::OpenDEStateSpace::readState(base::State *state) const
+{
+    readBodies(state, *env_);
+}
+
+void ompl::control::OpenDEStateSpace::readState(base::State *state, const OpenDEEnvironment &env) const
+{
+    // keep overrides of the single-argument version working for the original world
+    if (&env == env_.get())
+        readState(state);
+    else
+        readBodies(state, env);
+}
+
+void ompl::control::OpenDEStateSpace::readBodies(base::State *state, const OpenDEEnvironment &env) const
 {
     auto *s = state->as<StateType>();
-    for (int i = (int)env_->stateBodies_.size() - 1; i >= 0; --i)
+    for (int i = (int)env.stateBodies_.size() - 1; i >= 0; --i)
     {
         unsigned int _i4 = i * 4;
 
-        const dReal *pos = dBodyGetPosition(env_->stateBodies_[i]);
-        const dReal *vel = dBodyGetLinearVel(env_->stateBodies_[i]);
-        const dReal *ang = dBodyGetAngularVel(env_->stateBodies_[i]);
+        const dReal *pos = dBodyGetPosition(env.stateBodies_[i]);
+        const dReal *vel = dBodyGetLinearVel(env.stateBodies_[i]);
+        const dReal *ang = dBodyGetAngularVel(env.stateBodies_[i]);
         double *s_pos = s->as<base::RealVectorStateSpace::StateType>(_i4)->values;
         ++_i4;
         double *s_vel = s->as<base::RealVectorStateSpace::StateType>(_i4)->values;
@@ -342,7 +356,7 @@ void ompl::control::OpenDEStateSpace::readState(base::State *state) const
             s_ang[j] = ang[j];
         }
 
-        const dReal *rot = dBodyGetQuaternion(env_->stateBodies_[i]);
+        const dReal *rot = dBodyGetQuaternion(env.stateBodies_[i]);
         base::SO3StateSpace::StateType &s_rot = *s->as<base::SO3StateSpace::StateType>(_i4);
 
         s_rot.w = rot[0];
@@ -354,23 +368,37 @@ void ompl::control::OpenDEStateSpace::readState(base::State *state) const
 }
 
 void ompl::control::OpenDEStateSpace::writeState(const base::State *state) const
+{
+    writeBodies(state, *env_);
+}
+
+void ompl::control::OpenDEStateSpace::writeState(const base::State *state, const OpenDEEnvironment &env) const
+{
+    // keep overrides of the single-argument version working for the original world
+    if (&env == env_.get())
+        writeState(state);
+    else
+        writeBodies(state, env);
+}
+
+void ompl::control::OpenDEStateSpace::writeBodies(const base::State *state, const OpenDEEnvironment &env) const
 {
     const auto *s = state->as<StateType>();
-    for (int i = (int)env_->stateBodies_.size() - 1; i >= 0; --i)
+    for (int i = (int)env.stateBodies_.size() - 1; i >= 0; --i)
     {
         unsigned int _i4 = i * 4;
 
         double *s_pos = s->as<base::RealVectorStateSpace::StateType>(_i4)->values;
         ++_i4;
-        dBodySetPosition(env_->stateBodies_[i], s_pos[0], s_pos[1], s_pos[2]);
+        dBodySetPosition(env.stateBodies_[i], s_pos[0], s_pos[1], s_pos[2]);
 
         double *s_vel = s->as<base::RealVectorStateSpace::StateType>(_i4)->values;
         ++_i4;
-        dBodySetLinearVel(env_->stateBodies_[i], s_vel[0], s_vel[1], s_vel[2]);
+        dBodySetLinearVel(env.stateBodies_[i], s_vel[0], s_vel[1], s_vel[2]);
 
         double *s_ang = s->as<base::RealVectorStateSpace::StateType>(_i4)->values;
         ++_i4;
-        dBodySetAngularVel(env_->stateBodies_[i], s_ang[0], s_ang[1], s_ang[2]);
+        dBodySetAngularVel(env.stateBodies_[i], s_ang[0], s_ang[1], s_ang[2]);
 
         const base::SO3StateSpace::StateType &s_rot = *s->as<base::SO3StateSpace::StateType>(_i4);
         dQuaternion q;
@@ -378,6 +406,6 @@ void ompl::control::OpenDEStateSpace::writeState(const base::State *state) const
         q[1] = s_rot.x;
         q[2] = s_rot.y;
         q[3] = s_rot.z;
-        dBodySetQuaternion(env_->stateBodies_[i], q);
+        dBodySetQuaternion(env.stateBodies_[i], q);
     }
 }
@@ -69,6 +69,7 @@
 #include "ompl/geometric/PathHybridization.h"
 #include "ompl/geometric/PathSimplifier.h"
 #include "ompl/tools/config/SelfConfig.h"
+#include "ompl/tools/config/ThreadPlacement.h"
 #include "ompl/base/objectives/PathLengthOptimizationObjective.h"
 #include "ompl/util/String.h"
 
@@ -153,8 +154,13 @@ ompl::geometric::AnytimePathShortening::solve(const ompl::base::PlannerTerminati
     // Clear any previous planning data for the set of planners
     clear();
     // Spawn a thread for each planner.  This will shortcut the best path after solving.
-    for (auto &planner : planners_)
-        threads.emplace_back([this, planner, &ptc] { return threadSolve(planner.get(), ptc); });
+    const tools::ThreadPlacement::Reservation placement(planners_.size());
+    for (unsigned int i = 0; i < planners_.size(); ++i)
+        threads.emplace_back([this, i, &placement, &ptc]
+                             {
+                                 placement.pinWorker(i);
+                                 return threadSolve(planners_[i].get(), ptc);
+                             });
 
     geometric::PathSimplifier ps(si_);
     geometric::PathGeometric *sln = nullptr, *prevLastPath = nullptr;
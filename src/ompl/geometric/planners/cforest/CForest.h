@@ -41,6 +41,7 @@
 #include "ompl/geometric/planners/PlannerIncludes.h"
 #include "ompl/tools/config/SelfConfig.h"
 
+#include <atomic>
 #include <mutex>
 
 #include <vector>
@@ -186,16 +187,17 @@ namespace ompl
             /** \brief Stores the states already shared to check if a specific state has been shared. */
             std::unordered_set<const base::State *> statesShared_;
 
-            /** \brief Cost of the best path found so far among planners. */
-            base::Cost bestCost_;
+            /** \brief Value of the cost of the best path found so far among planners. Solutions that do not
+                improve it are rejected without locking. */
+            std::atomic<double> bestCost_{std::numeric_limits<double>::quiet_NaN()};
 
             /** \brief Number of paths shared among threads. */
-            unsigned int numPathsShared_{0u};
+            std::atomic<unsigned int> numPathsShared_{0u};
 
             /** \brief Number of states shared among threads. */
-            unsigned int numStatesShared_{0u};
+            std::atomic<unsigned int> numStatesShared_{0u};
 
-            /** \brief Mutex to control the access to the newSolutionFound() method. */
+            /** \brief Mutex to control the access to statesShared_. */
             std::mutex newSolutionFoundMutex_;
 
             /** \brief Mutex to control the access to samplers_ */
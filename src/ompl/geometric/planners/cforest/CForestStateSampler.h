@@ -39,7 +39,7 @@
 
 #include "ompl/base/StateSpace.h"
 
-#include <mutex>
+#include <atomic>
 #include <utility>
 
 namespace ompl
@@ -64,7 +64,8 @@ namespace ompl
             }
 
             /** \brief It will sample the next state of the vector StatesToSample_. If this is empty,
-                it will call the sampleUniform() method of the specified sampler. */
+                it will call the sampleUniform() method of the specified sampler. The sampling functions
+                are meant to be called from a single thread (the one of the planner that owns the sampler). */
             void sampleUniform(State *state) override;
 
             /** \brief It will sample the next state of the vector StatesToSample_. If this is empty,
@@ -80,24 +81,40 @@ namespace ompl
                 return space_;
             }
 
-            /** \brief Fills the vector StatesToSample_ of states to be sampled in the next
-                calls to sampleUniform(), sampleUniformNear() or sampleGaussian(). */
+            /** \brief Sets the states to be sampled in the next calls to sampleUniform(), sampleUniformNear()
+                or sampleGaussian(), replacing the ones that were not sampled yet. This can be called from any
+                thread: the states are copied into a batch that is handed over to the sampling thread without
+                locking. */
             void setStatesToSample(const std::vector<const State *> &states);
 
             void clear();
 
         protected:
-            /** \brief Extracts the next sample when statesToSample_ is not empty. */
-            void getNextSample(State *state);
+            /** \brief A batch of states to be sampled, in order */
+            struct StateBatch
+            {
+                /** \brief The states of the batch */
+                std::vector<State *> states;
+
+                /** \brief The index of the next state to be sampled */
+                std::size_t next{0};
+            };
+
+            /** \brief Extracts the next sample if there is one. Returns false otherwise. */
+            bool getNextSample(State *state);
 
-            /** \brief States to be sampled */
-            std::vector<State *> statesToSample_;
+            /** \brief Frees a batch and its states */
+            void freeBatch(StateBatch *batch) const;
+
+            /** \brief The batch being sampled from. Only accessed by the sampling thread. */
+            StateBatch *statesToSample_{nullptr};
+
+            /** \brief The batch set by the last call to setStatesToSample() that the sampling thread did
+                not take yet */
+            std::atomic<StateBatch *> pendingStates_{nullptr};
 
             /** \brief Underlying, user-specified state sampler. */
             StateSamplerPtr sampler_;
-
-            /** \brief Lock to control the access to the statesToSample_ vector. */
-            std::mutex statesLock_;
         };
     }
 }
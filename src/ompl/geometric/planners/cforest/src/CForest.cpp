@@ -38,6 +38,7 @@
 #include "ompl/geometric/planners/rrt/RRTstar.h"
 #include "ompl/base/objectives/PathLengthOptimizationObjective.h"
 #include "ompl/util/String.h"
+#include "ompl/tools/config/ThreadPlacement.h"
 #include <thread>
 
 ompl::geometric::CForest::CForest(const base::SpaceInformationPtr &si) : base::Planner(si, "CForest")
@@ -127,7 +128,7 @@ void ompl::geometric::CForest::clear()
     for (auto &planner : planners_)
         planner->clear();
 
-    bestCost_ = base::Cost(std::numeric_limits<double>::quiet_NaN());
+    bestCost_ = std::numeric_limits<double>::quiet_NaN();
     numPathsShared_ = 0;
     numStatesShared_ = 0;
 
@@ -152,7 +153,7 @@ void ompl::geometric::CForest::setup()
         opt_ = std::make_shared<base::PathLengthOptimizationObjective>(si_);
     }
 
-    bestCost_ = opt_->infiniteCost();
+    bestCost_ = opt_->infiniteCost().value();
 
     if (planners_.empty())
     {
@@ -186,14 +187,16 @@ ompl::base::PlannerStatus ompl::geometric::CForest::solve(const base::PlannerTer
         [this](const base::Planner *planner, const std::vector<const base::State *> &states, const base::Cost cost) {
             return newSolutionFound(planner, states, cost);
         });
-    bestCost_ = opt_->infiniteCost();
+    bestCost_ = opt_->infiniteCost().value();
 
     // run each planner in its own thread, with the same ptc.
+    const tools::ThreadPlacement::Reservation placement(threads.size());
     for (std::size_t i = 0; i < threads.size(); ++i)
     {
         base::Planner *planner = planners_[i].get();
-        threads[i] = new std::thread([this, planner, &ptc]
+        threads[i] = new std::thread([this, planner, i, &placement, &ptc]
                                      {
+                                         placement.pinWorker(i);
                                          return solve(planner, ptc);
                                      });
     }
@@ -212,7 +215,7 @@ ompl::base::PlannerStatus ompl::geometric::CForest::solve(const base::PlannerTer
 
 std::string ompl::geometric::CForest::getBestCost() const
 {
-    return ompl::toString(bestCost_.value());
+    return ompl::toString(bestCost_.load());
 }
 
 std::string ompl::geometric::CForest::getNumPathsShared() const
@@ -228,33 +231,40 @@ std::string ompl::geometric::CForest::getNumStatesShared() const
 void ompl::geometric::CForest::newSolutionFound(const base::Planner *planner,
                                                 const std::vector<const base::State *> &states, const base::Cost cost)
 {
-    bool change = false;
+    // Solutions that do not improve the best cost are rejected without locking.
+    double bestCost = bestCost_.load();
+    do
+    {
+        if (!opt_->isCostBetterThan(cost, base::Cost(bestCost)))
+            return;
+    } while (!bestCost_.compare_exchange_weak(bestCost, cost.value()));
+    ++numPathsShared_;
+
     std::vector<const base::State *> statesToShare;
-    newSolutionFoundMutex_.lock();
-    if (opt_->isCostBetterThan(cost, bestCost_))
     {
-        ++numPathsShared_;
-        bestCost_ = cost;
-        change = true;
+        std::lock_guard<std::mutex> lock(newSolutionFoundMutex_);
+        // A better solution may have been found meanwhile; its states are the ones to share.
+        if (bestCost_.load() != cost.value())
+            return;
 
         // Filtering the states to add only those not already added.
         statesToShare.reserve(states.size());
         for (auto state : states)
-        {
-            if (statesShared_.find(state) == statesShared_.end())
-            {
-                statesShared_.insert(state);
+            if (statesShared_.insert(state).second)
                 statesToShare.push_back(state);
-                ++numStatesShared_;
-            }
-        }
     }
-    newSolutionFoundMutex_.unlock();
+    numStatesShared_ += statesToShare.size();
 
-    if (!change || statesToShare.empty())
+    if (statesToShare.empty())
         return;
 
-    for (auto &i : samplers_)
+    std::vector<base::StateSamplerPtr> samplers;
+    {
+        std::lock_guard<std::mutex> lock(addSamplerMutex_);
+        samplers = samplers_;
+    }
+    // Each sampler receives the states as one batch, without blocking the thread that samples from it.
+    for (auto &i : samplers)
     {
         auto *sampler = static_cast<base::CForestStateSampler *>(i.get());
         const auto *space =
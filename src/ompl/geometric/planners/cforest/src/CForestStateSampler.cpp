@@ -38,58 +38,68 @@
 
 void ompl::base::CForestStateSampler::sampleUniform(State *state)
 {
-    if (!statesToSample_.empty())
-        getNextSample(state);
-    else
+    if (!getNextSample(state))
         sampler_->sampleUniform(state);
 }
 
 void ompl::base::CForestStateSampler::sampleUniformNear(State *state, const State *near, const double distance)
 {
-    if (!statesToSample_.empty())
-        getNextSample(state);
-    else
+    if (!getNextSample(state))
         sampler_->sampleUniformNear(state, near, distance);
 }
 
 void ompl::base::CForestStateSampler::sampleGaussian(State *state, const State *mean, const double stdDev)
 {
-    if (!statesToSample_.empty())
-        getNextSample(state);
-    else
+    if (!getNextSample(state))
         sampler_->sampleGaussian(state, mean, stdDev);
 }
 
 void ompl::base::CForestStateSampler::setStatesToSample(const std::vector<const State *> &states)
 {
-    std::lock_guard<std::mutex> slock(statesLock_);
-    for (auto &i : statesToSample_)
-        space_->freeState(i);
-    statesToSample_.clear();
-
-    statesToSample_.reserve(states.size());
-    // push in reverse order, so that the states are popped in order in getNextSample()
+    auto *batch = new StateBatch;
+    batch->states.reserve(states.size());
     for (auto state : states)
     {
         State *s = space_->allocState();
         space_->copyState(s, state);
-        statesToSample_.push_back(s);
+        batch->states.push_back(s);
+    }
+    // a batch that was not taken by the sampling thread yet is replaced
+    freeBatch(pendingStates_.exchange(batch, std::memory_order_acq_rel));
+}
+
+bool ompl::base::CForestStateSampler::getNextSample(State *state)
+{
+    if (pendingStates_.load(std::memory_order_relaxed) != nullptr)
+    {
+        freeBatch(statesToSample_);
+        statesToSample_ = pendingStates_.exchange(nullptr, std::memory_order_acq_rel);
+    }
+    if (statesToSample_ == nullptr)
+        return false;
+    if (statesToSample_->next == statesToSample_->states.size())
+    {
+        freeBatch(statesToSample_);
+        statesToSample_ = nullptr;
+        return false;
     }
+    space_->copyState(state, statesToSample_->states[statesToSample_->next++]);
+    return true;
 }
 
-void ompl::base::CForestStateSampler::getNextSample(State *state)
+void ompl::base::CForestStateSampler::freeBatch(StateBatch *batch) const
 {
-    std::lock_guard<std::mutex> slock(statesLock_);
-    space_->copyState(state, statesToSample_.back());
-    space_->freeState(statesToSample_.back());
-    statesToSample_.pop_back();
+    if (batch == nullptr)
+        return;
+    for (auto &s : batch->states)
+        space_->freeState(s);
+    delete batch;
 }
 
 void ompl::base::CForestStateSampler::clear()
 {
-    std::lock_guard<std::mutex> slock(statesLock_);
-    for (auto &i : statesToSample_)
-        space_->freeState(i);
-    statesToSample_.clear();
+    freeBatch(statesToSample_);
+    statesToSample_ = nullptr;
+    freeBatch(pendingStates_.exchange(nullptr, std::memory_order_acq_rel));
     sampler_.reset();
 }
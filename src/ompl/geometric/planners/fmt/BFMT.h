@@ -46,7 +46,9 @@
 #include <ompl/datastructures/NearestNeighbors.h>
 #include <ompl/datastructures/BinaryHeap.h>
 #include <ompl/base/OptimizationObjective.h>
+#include <ompl/util/WorkerPool.h>
 #include <map>
+#include <memory>
 #include <utility>
 
 namespace ompl
@@ -269,6 +271,22 @@ namespace ompl
                 return precomputeNN_;
             }
 
+            /** \brief Returns true if Nearest Neighbor precomputation is done. */
+            bool getPrecomputeNN() const
+            {
+                return precomputeNN_;
+            }
+
+            /** \brief Set the number of threads used to precompute the nearest neighbors. The default nearest
+                neighbors datastructure is then replaced by one that supports concurrent queries. The default is 1. */
+            void setNumThreads(unsigned int numThreads);
+
+            /** \brief Get the number of threads used to precompute the nearest neighbors */
+            unsigned int getNumThreads() const
+            {
+                return numThreads_;
+            }
+
             /** \brief Representation of a bidirectional motion. */
             class BiDirMotion
             {
@@ -590,6 +608,12 @@ namespace ompl
             /** \brief If true all the nearest neighbors maps are precomputed before solving. */
             bool precomputeNN_{false};
 
+            /** \brief The number of threads used to precompute the nearest neighbors */
+            unsigned int numThreads_{1u};
+
+            /** \brief The threads that precompute the nearest neighbors, kept across calls to solve() */
+            std::unique_ptr<WorkerPool> workers_;
+
             /** \brief A nearest-neighbor datastructure containing the set of all motions */
             std::shared_ptr<NearestNeighbors<BiDirMotion *>> nn_;
 
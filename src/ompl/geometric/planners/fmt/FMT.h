@@ -47,7 +47,10 @@
 #include <ompl/datastructures/NearestNeighbors.h>
 #include <ompl/datastructures/BinaryHeap.h>
 #include <ompl/base/OptimizationObjective.h>
+#include <ompl/util/WorkerPool.h>
+#include <limits>
 #include <map>
+#include <memory>
 
 namespace ompl
 {
@@ -208,6 +211,34 @@ namespace ompl
                 return extendedFMT_;
             }
 
+            /** \brief If \e precompute is true, the neighborhoods of all samples are computed before the marching
+                starts (in parallel, see setNumThreads()) and stored in a compressed sparse row array, instead of
+                being computed on demand and stored in a map. This uses much less memory per sample, but computes
+                neighborhoods that the marching may never need. Samples added by the extended FMT* still have
+                their neighborhoods computed on demand. */
+            void setPrecomputeNeighborhoods(bool precompute)
+            {
+                precomputeNeighborhoods_ = precompute;
+            }
+
+            /** \brief Returns true if the neighborhoods of all samples are computed before the marching starts */
+            bool getPrecomputeNeighborhoods() const
+            {
+                return precomputeNeighborhoods_;
+            }
+
+            /** \brief Set the number of threads used to draw the samples and, if neighborhoods are precomputed,
+                to compute the neighborhoods. The state validity checker must then support concurrent calls, and
+                the default nearest neighbors datastructure is replaced by one that supports concurrent queries.
+                The default is 1. */
+            void setNumThreads(unsigned int numThreads);
+
+            /** \brief Get the number of threads used to draw the samples and compute the neighborhoods */
+            unsigned int getNumThreads() const
+            {
+                return numThreads_;
+            }
+
         protected:
             /** \brief Representation of a motion
               */
@@ -317,6 +348,22 @@ namespace ompl
                     return children_;
                 }
 
+                /** \brief Set the row of the precomputed neighborhood of the motion */
+                void setNeighborhoodRow(unsigned int row)
+                {
+                    neighborhoodRow_ = row;
+                }
+
+                /** \brief Get the row of the precomputed neighborhood of the motion, or NO_ROW if its
+                    neighborhood was not precomputed */
+                unsigned int getNeighborhoodRow() const
+                {
+                    return neighborhoodRow_;
+                }
+
+                /** \brief The row of motions whose neighborhood was not precomputed */
+                static const unsigned int NO_ROW = std::numeric_limits<unsigned int>::max();
+
             protected:
                 /** \brief The state contained by the motion */
                 base::State *state_{nullptr};
@@ -338,6 +385,47 @@ namespace ompl
 
                 /** \brief The set of motions descending from the current motion */
                 std::vector<Motion *> children_;
+
+                /** \brief The row of the precomputed neighborhood of the motion */
+                unsigned int neighborhoodRow_{NO_ROW};
+            };
+
+            /** \brief A view of the stored neighborhood of a motion, sorted by distance */
+            class Neighborhood
+            {
+            public:
+                Neighborhood(Motion *const *begin, Motion *const *end) : begin_(begin), end_(end)
+                {
+                }
+
+                std::size_t size() const
+                {
+                    return end_ - begin_;
+                }
+
+                Motion *operator[](std::size_t i) const
+                {
+                    return begin_[i];
+                }
+
+                Motion *back() const
+                {
+                    return *(end_ - 1);
+                }
+
+                Motion *const *begin() const
+                {
+                    return begin_;
+                }
+
+                Motion *const *end() const
+                {
+                    return end_;
+                }
+
+            private:
+                Motion *const *begin_;
+                Motion *const *end_;
             };
 
             /** \brief Comparator used to order motions in a binary heap */
@@ -399,6 +487,27 @@ namespace ompl
                 used (nearestK or nearestR depends on the planner configuration */
             void saveNeighborhood(Motion *m);
 
+            /** \brief Compute the neighborhoods of the motions in nn_ that have none stored yet and append them
+                to the compressed sparse row array, so nothing is recomputed when the samples did not change. Stop
+                early (leaving the remaining neighborhoods to saveNeighborhood()) if \e ptc becomes true. */
+            void precomputeNeighborhoods(const base::PlannerTerminationCondition &ptc);
+
+            /** \brief Get the pool of numThreads_ threads, creating it if needed */
+            WorkerPool &getWorkers();
+
+            /** \brief Return true if the neighborhood of \e m is stored */
+            bool hasNeighborhood(Motion *m) const
+            {
+                return m->getNeighborhoodRow() != Motion::NO_ROW || neighborhoods_.find(m) != neighborhoods_.end();
+            }
+
+            /** \brief Get the stored neighborhood of \e m (empty if it is not stored) */
+            Neighborhood getNeighborhood(Motion *m);
+
+            /** \brief Get the stored neighborhood of \e m for modification. A precomputed neighborhood is moved
+                to neighborhoods_ first. */
+            std::vector<Motion *> &getMutableNeighborhood(Motion *m);
+
             /** \brief Trace the path from a goal state back to the start state
                 and save the result as a solution in the Problem Definiton. */
             void traceSolutionPathThroughTree(Motion *goalMotion);
@@ -433,6 +542,24 @@ namespace ompl
                 distance r of that motion */
             std::map<Motion *, std::vector<Motion *>> neighborhoods_;
 
+            /** \brief The precomputed neighborhoods, in compressed sparse row format: the neighborhood of the
+                motion with row i is stored in precomputedNeighbors_, from precomputedOffsets_[i] to
+                precomputedOffsets_[i + 1] */
+            std::vector<Motion *> precomputedNeighbors_;
+
+            /** \brief The offsets of the rows in precomputedNeighbors_ */
+            std::vector<std::size_t> precomputedOffsets_;
+
+            /** \brief Flag to compute all neighborhoods before the marching starts */
+            bool precomputeNeighborhoods_{false};
+
+            /** \brief The number of threads used to draw the samples and compute the neighborhoods */
+            unsigned int numThreads_{1u};
+
+            /** \brief The threads that draw the samples and compute the neighborhoods, kept across calls to
+                solve() */
+            std::unique_ptr<WorkerPool> workers_;
+
             /** \brief The number of samples to use when planning */
             unsigned int numSamples_{1000u};
 
@@ -8,6 +8,7 @@
 #include <ompl/base/objectives/PathLengthOptimizationObjective.h>
 #include <ompl/geometric/planners/fmt/BFMT.h>
 
+#include <algorithm>
 #include <fstream>
 #include <ompl/base/spaces/RealVectorStateSpace.h>
 
@@ -38,6 +39,12 @@ namespace ompl
             ompl::base::Planner::declareParam<bool>("cache_cc", this, &BFMT::setCacheCC, &BFMT::getCacheCC, "0,1");
             ompl::base::Planner::declareParam<bool>("extended_fmt", this, &BFMT::setExtendedFMT, &BFMT::getExtendedFMT,
                                                     "0,1");
+            // setPrecomputeNN() is overloaded by its old getter
+            ompl::base::Planner::declareParam<bool>("precompute_nn", this,
+                                                    static_cast<void (BFMT::*)(bool)>(&BFMT::setPrecomputeNN),
+                                                    &BFMT::getPrecomputeNN, "0,1");
+            ompl::base::Planner::declareParam<unsigned int>("num_threads", this, &BFMT::setNumThreads,
+                                                            &BFMT::getNumThreads, "1:64");
         }
 
         ompl::geometric::BFMT::~BFMT()
@@ -45,6 +52,19 @@ namespace ompl
             freeMemory();
         }
 
+        void BFMT::setNumThreads(unsigned int numThreads)
+        {
+            numThreads_ = std::max(numThreads, 1u);
+            specs_.multithreaded = numThreads_ > 1;
+            // The default nearest neighbors datastructure depends on whether the planner is multithreaded
+            if (nn_ && nn_->size() == 0)
+            {
+                nn_.reset();
+                if (setup_)
+                    setup();
+            }
+        }
+
         void BFMT::setup()
         {
             if (pdef_)
@@ -550,7 +570,35 @@ namespace ompl
             nn_->list(sampleNodes);
             /// \todo This precomputation is useful only if the same planner is used many times.
             /// otherwise is probably a waste of time. Do a real precomputation before calling solve().
-            if (precomputeNN_)
+            if (precomputeNN_ && numThreads_ > 1)
+            {
+                // Compute the missing neighborhoods in contiguous blocks, one per thread, then store them
+                BiDirMotionPtrs missing;
+                for (auto &sampleNode : sampleNodes)
+                    if (neighborhoods_.find(sampleNode) == neighborhoods_.end())
+                        missing.push_back(sampleNode);
+                const std::size_t n = missing.size();
+                const std::size_t numThreads = std::min<std::size_t>(numThreads_, n);
+                if (!workers_ || workers_->getNumThreads() != numThreads_)
+                    workers_ = std::make_unique<WorkerPool>(numThreads_);
+                std::vector<BiDirMotionPtrs> neighborhoods(n);
+                workers_->parallelFor(numThreads, [&](unsigned int, std::size_t t)
+                                      {
+                                          for (std::size_t i = n * t / numThreads; i < n * (t + 1) / numThreads; ++i)
+                                          {
+                                              if (nearestK_)
+                                                  nn_->nearestK(missing[i], NNk_, neighborhoods[i]);
+                                              else
+                                                  nn_->nearestR(missing[i], NNr_, neighborhoods[i]);
+                                              // Skip the first element, since it will be the motion itself
+                                              if (!neighborhoods[i].empty())
+                                                  neighborhoods[i].erase(neighborhoods[i].begin());
+                                          }
+                                      });
+                for (std::size_t i = 0; i < n; ++i)
+                    neighborhoods_[missing[i]] = std::move(neighborhoods[i]);
+            }
+            else if (precomputeNN_)
             {
                 for (auto &sampleNode : sampleNodes)
                 {
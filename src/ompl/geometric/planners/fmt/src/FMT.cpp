@@ -39,6 +39,8 @@
 /* Acknowledgements for insightful comments: Oren Salzman (Tel Aviv University),
  *                                           Joseph Starek (Stanford) */
 
+#include <algorithm>
+#include <atomic>
 #include <limits>
 #include <iostream>
 
@@ -68,6 +70,10 @@ ompl::geometric::FMT::FMT(const base::SpaceInformationPtr &si)
     ompl::base::Planner::declareParam<bool>("cache_cc", this, &FMT::setCacheCC, &FMT::getCacheCC, "0,1");
     ompl::base::Planner::declareParam<bool>("heuristics", this, &FMT::setHeuristics, &FMT::getHeuristics, "0,1");
     ompl::base::Planner::declareParam<bool>("extended_fmt", this, &FMT::setExtendedFMT, &FMT::getExtendedFMT, "0,1");
+    ompl::base::Planner::declareParam<bool>("precompute_neighborhoods", this, &FMT::setPrecomputeNeighborhoods,
+                                            &FMT::getPrecomputeNeighborhoods, "0,1");
+    ompl::base::Planner::declareParam<unsigned int>("num_threads", this, &FMT::setNumThreads, &FMT::getNumThreads,
+                                                    "1:1:64");
 }
 
 ompl::geometric::FMT::~FMT()
@@ -117,6 +123,19 @@ void ompl::geometric::FMT::setup()
     }
 }
 
+void ompl::geometric::FMT::setNumThreads(unsigned int numThreads)
+{
+    numThreads_ = std::max(numThreads, 1u);
+    specs_.multithreaded = numThreads_ > 1;
+    // The default nearest neighbors datastructure depends on whether the planner is multithreaded
+    if (nn_ && nn_->size() == 0)
+    {
+        nn_.reset();
+        if (setup_)
+            setup();
+    }
+}
+
 void ompl::geometric::FMT::freeMemory()
 {
     if (nn_)
@@ -142,6 +161,10 @@ void ompl::geometric::FMT::clear()
         nn_->clear();
     Open_.clear();
     neighborhoods_.clear();
+    precomputedNeighbors_.clear();
+    precomputedNeighbors_.shrink_to_fit();
+    precomputedOffsets_.clear();
+    precomputedOffsets_.shrink_to_fit();
 
     collisionChecks_ = 0;
 }
@@ -169,7 +192,7 @@ void ompl::geometric::FMT::getPlannerData(base::PlannerData &data) const
 void ompl::geometric::FMT::saveNeighborhood(Motion *m)
 {
     // Check to see if neighborhood has not been saved yet
-    if (neighborhoods_.find(m) == neighborhoods_.end())
+    if (!hasNeighborhood(m))
     {
         std::vector<Motion *> nbh;
         if (nearestK_)
@@ -190,6 +213,95 @@ void ompl::geometric::FMT::saveNeighborhood(Motion *m)
     }  // If neighborhood hadn't been saved yet
 }
 
+void ompl::geometric::FMT::precomputeNeighborhoods(const base::PlannerTerminationCondition &ptc)
+{
+    // Only the samples added since the last precomputation need a new row; stored neighborhoods are kept,
+    // as saveNeighborhood() does
+    std::vector<Motion *> motions;
+    nn_->list(motions);
+    motions.erase(std::remove_if(motions.begin(), motions.end(), [this](Motion *m) { return hasNeighborhood(m); }),
+                  motions.end());
+    const std::size_t n = motions.size();
+    if (n == 0)
+        return;
+    const std::size_t numThreads = std::min<std::size_t>(numThreads_, n);
+
+    // Each thread computes the neighborhoods of a contiguous block of motions
+    std::vector<std::vector<Motion *>> blockNeighbors(numThreads);
+    std::vector<std::vector<std::size_t>> blockSizes(numThreads);
+    getWorkers().parallelFor(numThreads, [&](unsigned int, std::size_t t)
+    {
+        const std::size_t first = n * t / numThreads;
+        const std::size_t last = n * (t + 1) / numThreads;
+        std::vector<Motion *> nbh;
+        blockSizes[t].reserve(last - first);
+        for (std::size_t i = first; i < last && !ptc; ++i)
+        {
+            if (nearestK_)
+                nn_->nearestK(motions[i], NNk_, nbh);
+            else
+                nn_->nearestR(motions[i], NNr_, nbh);
+            // Skip the first element, since it will be the motion itself
+            if (!nbh.empty())
+                blockNeighbors[t].insert(blockNeighbors[t].end(), nbh.begin() + 1, nbh.end());
+            blockSizes[t].push_back(nbh.empty() ? 0 : nbh.size() - 1);
+        }
+    });
+
+    // Append the blocks; motions whose neighborhood was not computed keep NO_ROW
+    std::size_t total = precomputedNeighbors_.size();
+    for (const auto &block : blockNeighbors)
+        total += block.size();
+    precomputedNeighbors_.reserve(total);
+    if (precomputedOffsets_.empty())
+        precomputedOffsets_.push_back(0);
+    precomputedOffsets_.reserve(precomputedOffsets_.size() + n);
+    for (std::size_t t = 0; t < numThreads; ++t)
+    {
+        const std::size_t first = n * t / numThreads;
+        precomputedNeighbors_.insert(precomputedNeighbors_.end(), blockNeighbors[t].begin(), blockNeighbors[t].end());
+        for (std::size_t i = 0; i < blockSizes[t].size(); ++i)
+        {
+            motions[first + i]->setNeighborhoodRow(precomputedOffsets_.size() - 1);
+            precomputedOffsets_.push_back(precomputedOffsets_.back() + blockSizes[t][i]);
+        }
+        blockNeighbors[t].clear();
+        blockNeighbors[t].shrink_to_fit();
+    }
+}
+
+ompl::WorkerPool &ompl::geometric::FMT::getWorkers()
+{
+    if (!workers_ || workers_->getNumThreads() != numThreads_)
+        workers_ = std::make_unique<WorkerPool>(numThreads_);
+    return *workers_;
+}
+
+ompl::geometric::FMT::Neighborhood ompl::geometric::FMT::getNeighborhood(Motion *m)
+{
+    const unsigned int row = m->getNeighborhoodRow();
+    if (row != Motion::NO_ROW)
+    {
+        Motion *const *data = precomputedNeighbors_.data();
+        return {data + precomputedOffsets_[row], data + precomputedOffsets_[row + 1]};
+    }
+    const std::vector<Motion *> &nbh = neighborhoods_[m];
+    return {nbh.data(), nbh.data() + nbh.size()};
+}
+
+std::vector<ompl::geometric::FMT::Motion *> &ompl::geometric::FMT::getMutableNeighborhood(Motion *m)
+{
+    std::vector<Motion *> &nbh = neighborhoods_[m];
+    const unsigned int row = m->getNeighborhoodRow();
+    if (row != Motion::NO_ROW)
+    {
+        nbh.assign(precomputedNeighbors_.begin() + precomputedOffsets_[row],
+                   precomputedNeighbors_.begin() + precomputedOffsets_[row + 1]);
+        m->setNeighborhoodRow(Motion::NO_ROW);
+    }
+    return nbh;
+}
+
 // Calculate the unit ball volume for a given dimension
 double ompl::geometric::FMT::calculateUnitBallVolume(const unsigned int dimension) const
 {
@@ -213,6 +325,51 @@ void ompl::geometric::FMT::sampleFree(const base::PlannerTerminationCondition &p
 {
     unsigned int nodeCount = 0;
     unsigned int sampleAttempts = 0;
+
+    if (numThreads_ > 1)
+    {
+        // Each thread draws samples with its own sampler until numSamples_ valid ones have been found in total
+        std::atomic<unsigned int> claimed{0};
+        std::atomic<unsigned int> attempts{0};
+        std::vector<std::vector<Motion *>> found(numThreads_);
+        // The workers check with the dynamic obstacles bound on the calling thread
+        const base::StateValidityChecker::ScopedDynamicObstacles *scope =
+            base::StateValidityChecker::ScopedDynamicObstacles::current();
+        getWorkers().parallelFor(numThreads_, [&](unsigned int, std::size_t t)
+        {
+            base::StateValidityChecker::ScopedDynamicObstacles::Inherit inherit(scope);
+            base::StateSamplerPtr sampler = si_->allocStateSampler();
+            unsigned int localAttempts = 0;
+            auto *motion = new Motion(si_);
+            while (!ptc && claimed.load(std::memory_order_relaxed) < numSamples_)
+            {
+                sampler->sampleUniform(motion->getState());
+                localAttempts++;
+                if (si_->isValid(motion->getState()))
+                {
+                    // Only keep the sample if the budget was not exhausted by another thread meanwhile
+                    if (claimed.fetch_add(1, std::memory_order_relaxed) >= numSamples_)
+                        break;
+                    found[t].push_back(motion);
+                    motion = new Motion(si_);
+                }
+            }
+            si_->freeState(motion->getState());
+            delete motion;
+            attempts.fetch_add(localAttempts, std::memory_order_relaxed);
+        });
+
+        for (auto &motions : found)
+        {
+            nodeCount += motions.size();
+            nn_->add(motions);
+        }
+        sampleAttempts = attempts;
+        freeSpaceVolume_ = boost::math::binomial_distribution<>::find_upper_bound_on_p(sampleAttempts, nodeCount, 0.05) *
+                           si_->getStateSpace()->getMeasure();
+        return;
+    }
+
     auto *motion = new Motion(si_);
 
     // Sample numSamples_ number of nodes from the free configuration space
@@ -341,6 +498,8 @@ ompl::base::PlannerStatus ompl::geometric::FMT::solve(const base::PlannerTermina
     bool plannerSuccess = false;
     bool successfulExpansion = false;
     Motion *z = initMotion;  // z <-- xinit
+    if (precomputeNeighborhoods_)
+        precomputeNeighborhoods(ptc);
     saveNeighborhood(z);
 
     while (!ptc)
@@ -389,7 +548,7 @@ ompl::base::PlannerStatus ompl::geometric::FMT::solve(const base::PlannerTermina
                             // Relies on NN datastructure returning k-nearest in sorted order
                             const base::Cost connCost = opt_->motionCost(j->getState(), m->getState());
                             const base::Cost worstCost =
-                                opt_->motionCost(neighborhoods_[j].back()->getState(), j->getState());
+                                opt_->motionCost(getNeighborhood(j).back()->getState(), j->getState());
 
                             if (opt_->isCostBetterThan(worstCost, connCost))
                                 continue;
@@ -500,7 +659,7 @@ bool ompl::geometric::FMT::expandTreeFromNode(Motion **z)
     // Find all nodes that are near z, and also in set Unvisited
 
     std::vector<Motion *> xNear;
-    const std::vector<Motion *> &zNeighborhood = neighborhoods_[*z];
+    const Neighborhood zNeighborhood = getNeighborhood(*z);
     const unsigned int zNeighborhoodSize = zNeighborhood.size();
     xNear.reserve(zNeighborhoodSize);
 
@@ -515,7 +674,7 @@ bool ompl::geometric::FMT::expandTreeFromNode(Motion **z)
                 // Only include neighbors that are mutually k-nearest
                 // Relies on NN datastructure returning k-nearest in sorted order
                 const base::Cost connCost = opt_->motionCost((*z)->getState(), x->getState());
-                const base::Cost worstCost = opt_->motionCost(neighborhoods_[x].back()->getState(), x->getState());
+                const base::Cost worstCost = opt_->motionCost(getNeighborhood(x).back()->getState(), x->getState());
 
                 if (opt_->isCostBetterThan(worstCost, connCost))
                     continue;
@@ -535,7 +694,7 @@ bool ompl::geometric::FMT::expandTreeFromNode(Motion **z)
         Motion *x = xNear[i];
 
         // Find all nodes that are near x and in set Open
-        const std::vector<Motion *> &xNeighborhood = neighborhoods_[x];
+        const Neighborhood xNeighborhood = getNeighborhood(x);
 
         const unsigned int xNeighborhoodSize = xNeighborhood.size();
         yNear.reserve(xNeighborhoodSize);
@@ -640,16 +799,16 @@ void ompl::geometric::FMT::updateNeighborhood(Motion *m, const std::vector<Motio
     {
         // If CLOSED, the neighborhood already exists. If neighborhood already exists, we have
         // to insert the node in the corresponding place of the neighborhood of the neighbor of m.
-        if (i->getSetType() == Motion::SET_CLOSED || neighborhoods_.find(i) != neighborhoods_.end())
+        if (i->getSetType() == Motion::SET_CLOSED || hasNeighborhood(i))
         {
             const base::Cost connCost = opt_->motionCost(i->getState(), m->getState());
-            const base::Cost worstCost = opt_->motionCost(neighborhoods_[i].back()->getState(), i->getState());
+            const base::Cost worstCost = opt_->motionCost(getNeighborhood(i).back()->getState(), i->getState());
 
             if (opt_->isCostBetterThan(worstCost, connCost))
                 continue;
 
             // Insert the neighbor in the vector in the correct order
-            std::vector<Motion *> &nbhToUpdate = neighborhoods_[i];
+            std::vector<Motion *> &nbhToUpdate = getMutableNeighborhood(i);
             for (std::size_t j = 0; j < nbhToUpdate.size(); ++j)
             {
                 // If connection to the new state is better than the current neighbor tested, insert.
@@ -72,6 +72,8 @@ namespace ompl
 
             void getPlannerData(base::PlannerData &data) const override;
 
+            void streamPlannerData(base::PlannerDataSink &sink) const override;
+
             base::PlannerStatus solve(const base::PlannerTerminationCondition &ptc) override;
 
             void clear() override;
@@ -39,9 +39,13 @@
 
 #include "ompl/geometric/planners/PlannerIncludes.h"
 #include "ompl/base/OptimizationObjective.h"
+#include "ompl/base/goals/GoalSampleableRegion.h"
 #include "ompl/datastructures/NearestNeighbors.h"
+#include "ompl/util/WorkerPool.h"
 
+#include <functional>
 #include <limits>
+#include <memory>
 #include <vector>
 #include <queue>
 #include <deque>
@@ -166,6 +170,41 @@ namespace ompl
                 return delayCC_;
             }
 
+            /** \brief Set the number of threads used to collision check the motions to the
+                neighbors of a new state. With more than one thread, the motions to the
+                cheapest candidate parents are checked speculatively in batches of this size
+                (if delayed collision checking is enabled), and all rewiring candidates
+                are checked concurrently before the tree is rewired. The state validity
+                checker must be thread safe. */
+            void setNumThreads(unsigned int numThreads)
+            {
+                numThreads_ = std::max(numThreads, 1u);
+            }
+
+            /** \brief Get the number of threads used for collision checking motions to neighbors */
+            unsigned int getNumThreads() const
+            {
+                return numThreads_;
+            }
+
+            /** \brief Set the number of samples whose nearest motion, motion check and neighborhood are
+                computed together on the collision checking threads before they are added to the tree one
+                after the other. A sample is connected to the motions added earlier in its batch as if they
+                had been in the tree when it was queried, so batching changes which neighbors are considered
+                only through the slightly smaller number of motions used to compute the neighborhood size.
+                The nearest neighbors datastructure is queried from several threads; the one allocated by
+                setup() allows this if the batch size is set before. */
+            void setNeighborhoodBatchSize(unsigned int batchSize)
+            {
+                neighborhoodBatchSize_ = std::max(batchSize, 1u);
+            }
+
+            /** \brief Get the number of samples whose neighborhoods are computed together */
+            unsigned int getNeighborhoodBatchSize() const
+            {
+                return neighborhoodBatchSize_;
+            }
+
             /** \brief Controls whether the tree is pruned during the search. This pruning removes
                 a vertex if and only if it \e and all its descendents passes the pruning condition.
                 The pruning condition is whether the lower-bounding estimate of a solution
@@ -361,6 +400,26 @@ namespace ompl
                 std::vector<Motion *> children;
             };
 
+            /** \brief A sample whose nearest motion, motion check and neighborhood were computed ahead of the
+                iteration that adds it to the tree (see setNeighborhoodBatchSize()) */
+            struct PreparedSample
+            {
+                /** \brief The sampled state */
+                Motion *rmotion;
+
+                /** \brief The state to add, \e rmotion moved to at most maxDistance_ from \e nmotion */
+                Motion *dmotion;
+
+                /** \brief The motion of the tree nearest to \e rmotion */
+                Motion *nmotion;
+
+                /** \brief Whether the motion from \e nmotion to \e dmotion is valid */
+                bool reachable;
+
+                /** \brief The neighbors of \e dmotion, if it is reachable */
+                std::vector<Motion *> nbh;
+            };
+
             /** \brief Create the samplers */
             void allocSampler();
 
@@ -394,12 +453,34 @@ namespace ompl
             /** \brief Gets the neighbours of a given motion, using either k-nearest of radius as appropriate. */
             void getNeighbors(Motion *motion, std::vector<Motion *> &nbh) const;
 
+            /** \brief Add the motions of \e added (inserted into the tree after \e nbh was computed) that are
+                neighbors of \e motion to \e nbh, as getNeighbors() would have found them */
+            void addNeighbors(Motion *motion, const std::vector<Motion *> &added, std::vector<Motion *> &nbh) const;
+
+            /** \brief Sample states into the first entries of \e batch and compute their nearest motions, motion
+                checks and neighborhoods on the worker threads. Returns the number of samples prepared; \e
+                failures is increased by the number of samples that could not be generated. */
+            std::size_t prepareSamples(std::vector<PreparedSample> &batch, base::GoalSampleableRegion *goal_s,
+                                       bool skipNearestEqual, unsigned int &failures);
+
+            /** \brief Check the motions for the neighbors with the given \e indices on the numThreads_
+                threads of workers_. valid[i] is set to 1 if check(i) returns true and to -1 otherwise. */
+            void checkMotionsInParallel(const std::size_t *indices, std::size_t count,
+                                        const std::function<bool(std::size_t)> &check, std::vector<int> &valid) const;
+
             /** \brief Removes the given motion from the parent's child list */
             void removeFromParent(Motion *m);
 
             /** \brief Updates the cost of the children of this node if the cost up to this node has changed */
             void updateChildCosts(Motion *m);
 
+            /** \brief Get the cost up to \e m while the motions rewired to \e rewiredParent still have to pass their
+                new costs on to their descendants */
+            base::Cost currentCost(const Motion *m, const Motion *rewiredParent) const;
+
+            /** \brief Get workers_, started with numThreads_ threads */
+            WorkerPool &workers() const;
+
             /** \brief Prunes all those states which estimated total cost is higher than pruneTreeCost.
                 Returns the number of motions pruned. Depends on the parameter set by
                setPruneStatesImprovementThreshold() */
@@ -457,6 +538,16 @@ namespace ompl
             /** \brief Option to delay and reduce collision checking within iterations */
             bool delayCC_{true};
 
+            /** \brief The number of threads used to collision check motions to neighbors */
+            unsigned int numThreads_{1u};
+
+            /** \brief The threads that check motions to neighbors, started on first use and kept until the
+                number of threads changes */
+            mutable std::unique_ptr<WorkerPool> workers_;
+
+            /** \brief The number of samples whose neighborhoods are computed together */
+            unsigned int neighborhoodBatchSize_{1u};
+
             /** \brief Objective we're optimizing */
             base::OptimizationObjectivePtr opt_;
 
@@ -250,3 +250,24 @@ void ompl::geometric::RRT::getPlannerData(base::PlannerData &data) const
             data.addEdge(base::PlannerDataVertex(motion->parent->state), base::PlannerDataVertex(motion->state));
     }
 }
+
+void ompl::geometric::RRT::streamPlannerData(base::PlannerDataSink &sink) const
+{
+    std::vector<Motion *> motions;
+    if (nn_)
+        nn_->list(motions);
+
+    sink.beginSection(getName(), si_->getStateSpace().get());
+    for (auto &motion : motions)
+    {
+        base::PlannerDataSink::VertexType type = base::PlannerDataSink::PLAIN;
+        if (motion->parent == nullptr)
+            type = base::PlannerDataSink::START;
+        else if (motion == lastGoalMotion_)
+            type = base::PlannerDataSink::GOAL;
+        sink.vertex(base::PlannerDataSink::idOf(motion->state), motion->state, type);
+        if (motion->parent != nullptr)
+            sink.edge(base::PlannerDataSink::idOf(motion->parent->state), base::PlannerDataSink::idOf(motion->state));
+    }
+    sink.endSection();
+}
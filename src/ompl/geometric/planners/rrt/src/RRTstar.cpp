@@ -62,6 +62,10 @@ ompl::geometric::RRTstar::RRTstar(const base::SpaceInformationPtr &si)
                                   "1.0:0.01:2.0");
     Planner::declareParam<bool>("use_k_nearest", this, &RRTstar::setKNearest, &RRTstar::getKNearest, "0,1");
     Planner::declareParam<bool>("delay_collision_checking", this, &RRTstar::setDelayCC, &RRTstar::getDelayCC, "0,1");
+    Planner::declareParam<unsigned int>("num_threads", this, &RRTstar::setNumThreads, &RRTstar::getNumThreads,
+                                        "1:1:64");
+    Planner::declareParam<unsigned int>("neighborhood_batch_size", this, &RRTstar::setNeighborhoodBatchSize,
+                                        &RRTstar::getNeighborhoodBatchSize, "1:1:64");
     Planner::declareParam<bool>("tree_pruning", this, &RRTstar::setTreePruning, &RRTstar::getTreePruning, "0,1");
     Planner::declareParam<double>("prune_threshold", this, &RRTstar::setPruneThreshold, &RRTstar::getPruneThreshold,
                                   "0.:.01:1.");
@@ -102,7 +106,13 @@ void ompl::geometric::RRTstar::setup()
     }
 
     if (!nn_)
-        nn_.reset(tools::SelfConfig::getDefaultNearestNeighbors<Motion *>(this));
+    {
+        // batches of samples query the tree from several threads
+        if (neighborhoodBatchSize_ > 1u && si_->getStateSpace()->isMetricSpace())
+            nn_ = std::make_shared<NearestNeighborsGNAT<Motion *>>();
+        else
+            nn_.reset(tools::SelfConfig::getDefaultNearestNeighbors<Motion *>(this));
+    }
     nn_->setDistanceFunction([this](const Motion *a, const Motion *b) { return distanceFunction(a, b); });
 
     // Setup optimization objective
@@ -223,8 +233,15 @@ ompl::base::PlannerStatus ompl::geometric::RRTstar::solve(const base::PlannerTer
     std::vector<base::Cost> costs;
     std::vector<base::Cost> incCosts;
     std::vector<std::size_t> sortedCostIndices;
+    std::vector<std::size_t> rewireIndices;
 
     std::vector<int> valid;
+
+    // samples prepared together (see setNeighborhoodBatchSize()) and the motions added to the tree since
+    std::vector<PreparedSample> batch;
+    std::size_t numPrepared = 0, nextPrepared = 0;
+    std::vector<Motion *> added;
+
     unsigned int rewireTest = 0;
     unsigned int statesGenerated = 0;
 
@@ -248,38 +265,98 @@ ompl::base::PlannerStatus ompl::geometric::RRTstar::solve(const base::PlannerTer
     {
         iterations_++;
 
-        // sample random state (with goal biasing)
-        // Goal samples are only sampled until maxSampleCount() goals are in the tree, to prohibit duplicate goal
-        // states.
-        if (goal_s && goalMotions_.size() < goal_s->maxSampleCount() && rng_.uniform01() < goalBias_ &&
-            goal_s->canSample())
-            goal_s->sampleGoal(rstate);
-        else
+        Motion *nmotion;
+        base::State *dstate;
+        bool reachable;
+        bool haveNeighbors = false;
+
+        if (neighborhoodBatchSize_ > 1u)
         {
-            // Attempt to generate a sample, if we fail (e.g., too many rejection attempts), skip the remainder of this
-            // loop and return to try again
-            if (!sampleUniform(rstate))
-                continue;
+            if (nextPrepared == numPrepared)
+            {
+                unsigned int failures = 0;
+                numPrepared = prepareSamples(batch, goal_s, static_cast<bool>(intermediateSolutionCallback), failures);
+                nextPrepared = 0;
+                added.clear();
+                iterations_ += failures;
+                if (numPrepared == 0)
+                    continue;
+            }
+            PreparedSample &sample = batch[nextPrepared++];
+
+            // a motion added since the sample was prepared may be nearer to it
+            nmotion = sample.nmotion;
+            double d = si_->distance(nmotion->state, sample.rmotion->state);
+            for (Motion *m : added)
+            {
+                double dm = si_->distance(m->state, sample.rmotion->state);
+                if (dm < d)
+                {
+                    nmotion = m;
+                    d = dm;
+                }
+            }
+            dstate = sample.dmotion->state;
+            if (nmotion == sample.nmotion)
+            {
+                reachable = sample.reachable;
+                if (reachable)
+                {
+                    addNeighbors(sample.dmotion, added, sample.nbh);
+                    nbh.swap(sample.nbh);
+                    haveNeighbors = true;
+                }
+            }
+            else
+            {
+                // the motion towards the sample changed, so extend the tree as without batching
+                if (intermediateSolutionCallback && si_->equalStates(nmotion->state, sample.rmotion->state))
+                    continue;
+                if (d > maxDistance_)
+                    si_->getStateSpace()->interpolate(nmotion->state, sample.rmotion->state, maxDistance_ / d,
+                                                      dstate);
+                else
+                    si_->copyState(dstate, sample.rmotion->state);
+                reachable = si_->checkMotion(nmotion->state, dstate);
+            }
         }
+        else
+        {
+            // sample random state (with goal biasing)
+            // Goal samples are only sampled until maxSampleCount() goals are in the tree, to prohibit duplicate goal
+            // states.
+            if (goal_s && goalMotions_.size() < goal_s->maxSampleCount() && rng_.uniform01() < goalBias_ &&
+                goal_s->canSample())
+                goal_s->sampleGoal(rstate);
+            else
+            {
+                // Attempt to generate a sample, if we fail (e.g., too many rejection attempts), skip the remainder of
+                // this loop and return to try again
+                if (!sampleUniform(rstate))
+                    continue;
+            }
 
-        // find closest state in the tree
-        Motion *nmotion = nn_->nearest(rmotion);
+            // find closest state in the tree
+            nmotion = nn_->nearest(rmotion);
 
-        if (intermediateSolutionCallback && si_->equalStates(nmotion->state, rstate))
-            continue;
+            if (intermediateSolutionCallback && si_->equalStates(nmotion->state, rstate))
+                continue;
 
-        base::State *dstate = rstate;
+            dstate = rstate;
 
-        // find state to add to the tree
-        double d = si_->distance(nmotion->state, rstate);
-        if (d > maxDistance_)
-        {
-            si_->getStateSpace()->interpolate(nmotion->state, rstate, maxDistance_ / d, xstate);
-            dstate = xstate;
+            // find state to add to the tree
+            double d = si_->distance(nmotion->state, rstate);
+            if (d > maxDistance_)
+            {
+                si_->getStateSpace()->interpolate(nmotion->state, rstate, maxDistance_ / d, xstate);
+                dstate = xstate;
+            }
+
+            // Check if the motion between the nearest state and the state to add is valid
+            reachable = si_->checkMotion(nmotion->state, dstate);
         }
 
-        // Check if the motion between the nearest state and the state to add is valid
-        if (si_->checkMotion(nmotion->state, dstate))
+        if (reachable)
         {
             // create a motion
             auto *motion = new Motion(si_);
@@ -289,7 +366,8 @@ ompl::base::PlannerStatus ompl::geometric::RRTstar::solve(const base::PlannerTer
             motion->cost = opt_->combineCosts(nmotion->cost, motion->incCost);
 
             // Find nearby neighbors of the new motion
-            getNeighbors(motion, nbh);
+            if (!haveNeighbors)
+                getNeighbors(motion, nbh);
 
             rewireTest += nbh.size();
             ++statesGenerated;
@@ -339,22 +417,48 @@ ompl::base::PlannerStatus ompl::geometric::RRTstar::solve(const base::PlannerTer
                 // neighbors are valid. This is fine, because motion
                 // already has a connection to the tree through
                 // nmotion (with populated cost fields!).
-                for (std::vector<std::size_t>::const_iterator i = sortedCostIndices.begin();
-                     i != sortedCostIndices.begin() + nbh.size(); ++i)
+                if (numThreads_ > 1u)
                 {
-                    if (nbh[*i] == nmotion ||
-                        ((!useKNearest_ || si_->distance(nbh[*i]->state, motion->state) < maxDistance_) &&
-                         si_->checkMotion(nbh[*i]->state, motion->state)))
+                    // speculatively check the next numThreads_ cheapest candidates at once
+                    auto checkParent = [&](std::size_t i)
+                    {
+                        return nbh[i] == nmotion ||
+                               ((!useKNearest_ || si_->distance(nbh[i]->state, motion->state) < maxDistance_) &&
+                                si_->checkMotion(nbh[i]->state, motion->state));
+                    };
+                    bool foundParent = false;
+                    for (std::size_t b = 0; b < nbh.size() && !foundParent; b += numThreads_)
                     {
-                        motion->incCost = incCosts[*i];
-                        motion->cost = costs[*i];
-                        motion->parent = nbh[*i];
-                        valid[*i] = 1;
-                        break;
+                        std::size_t count = std::min<std::size_t>(numThreads_, nbh.size() - b);
+                        checkMotionsInParallel(&sortedCostIndices[b], count, checkParent, valid);
+                        for (std::size_t j = b; j < b + count; ++j)
+                            if (valid[sortedCostIndices[j]] == 1)
+                            {
+                                motion->incCost = incCosts[sortedCostIndices[j]];
+                                motion->cost = costs[sortedCostIndices[j]];
+                                motion->parent = nbh[sortedCostIndices[j]];
+                                foundParent = true;
+                                break;
+                            }
                     }
-                    else
-                        valid[*i] = -1;
                 }
+                else
+                    for (std::vector<std::size_t>::const_iterator i = sortedCostIndices.begin();
+                         i != sortedCostIndices.begin() + nbh.size(); ++i)
+                    {
+                        if (nbh[*i] == nmotion ||
+                            ((!useKNearest_ || si_->distance(nbh[*i]->state, motion->state) < maxDistance_) &&
+                             si_->checkMotion(nbh[*i]->state, motion->state)))
+                        {
+                            motion->incCost = incCosts[*i];
+                            motion->cost = costs[*i];
+                            motion->parent = nbh[*i];
+                            valid[*i] = 1;
+                            break;
+                        }
+                        else
+                            valid[*i] = -1;
+                    }
             }
             else  // if not delayCC
             {
@@ -396,6 +500,8 @@ ompl::base::PlannerStatus ompl::geometric::RRTstar::solve(const base::PlannerTer
                 {
                     nn_->add(motion);
                     motion->parent->children.push_back(motion);
+                    if (neighborhoodBatchSize_ > 1u)
+                        added.push_back(motion);
                 }
                 else  // If the new motion does not improve the best cost it is ignored.
                 {
@@ -409,6 +515,30 @@ ompl::base::PlannerStatus ompl::geometric::RRTstar::solve(const base::PlannerTer
                 // add motion to the tree
                 nn_->add(motion);
                 motion->parent->children.push_back(motion);
+                if (neighborhoodBatchSize_ > 1u)
+                    added.push_back(motion);
+            }
+
+            if (numThreads_ > 1u)
+            {
+                // check all the motions that could improve a neighbor concurrently; the
+                // results are picked up from the validity cache while rewiring below
+                rewireIndices.clear();
+                for (std::size_t i = 0; i < nbh.size(); ++i)
+                    if (nbh[i] != motion->parent && valid[i] == 0 &&
+                        opt_->isCostBetterThan(
+                            opt_->combineCosts(motion->cost, symCost ? incCosts[i] :
+                                                                        opt_->motionCost(motion->state, nbh[i]->state)),
+                            nbh[i]->cost))
+                        rewireIndices.push_back(i);
+                checkMotionsInParallel(rewireIndices.data(), rewireIndices.size(),
+                                       [&](std::size_t i)
+                                       {
+                                           return (!useKNearest_ ||
+                                                   si_->distance(nbh[i]->state, motion->state) < maxDistance_) &&
+                                                  si_->checkMotion(motion->state, nbh[i]->state);
+                                       },
+                                       valid);
             }
 
             bool checkForSolution = false;
@@ -422,7 +552,8 @@ ompl::base::PlannerStatus ompl::geometric::RRTstar::solve(const base::PlannerTer
                     else
                         nbhIncCost = opt_->motionCost(motion->state, nbh[i]->state);
                     base::Cost nbhNewCost = opt_->combineCosts(motion->cost, nbhIncCost);
-                    if (opt_->isCostBetterThan(nbhNewCost, nbh[i]->cost))
+                    if (opt_->isCostBetterThan(nbhNewCost, nbh[i]->cost) &&
+                        opt_->isCostBetterThan(nbhNewCost, currentCost(nbh[i], motion)))
                     {
                         bool motionValid;
                         if (valid[i] == 0)
@@ -447,15 +578,22 @@ ompl::base::PlannerStatus ompl::geometric::RRTstar::solve(const base::PlannerTer
                             nbh[i]->cost = nbhNewCost;
                             nbh[i]->parent->children.push_back(nbh[i]);
 
-                            // Update the costs of the node's children
-                            updateChildCosts(nbh[i]);
-
                             checkForSolution = true;
                         }
                     }
                 }
             }
 
+            // Update the costs of the descendants of the rewired nodes only now, so that a subtree rewired
+            // more than once in this iteration is updated once. The rewired nodes are the children of the new
+            // motion, so their subtrees are disjoint.
+            if (numThreads_ > 1u && motion->children.size() > 1u)
+                workers().parallelFor(motion->children.size(), [&](unsigned int /*thread*/, std::size_t i)
+                                      { updateChildCosts(motion->children[i]); });
+            else
+                for (Motion *child : motion->children)
+                    updateChildCosts(child);
+
             // Add the new motion to the goalMotion_ list, if it satisfies the goal
             double distanceFromGoal;
             if (goal->isSatisfied(motion->state, &distanceFromGoal))
@@ -508,6 +646,8 @@ ompl::base::PlannerStatus ompl::geometric::RRTstar::solve(const base::PlannerTer
                     if (useTreePruning_)
                     {
                         pruneTree(bestCost_);
+                        // the prepared samples may refer to pruned motions
+                        nextPrepared = numPrepared;
                     }
 
                     if (intermediateSolutionCallback)
@@ -591,6 +731,13 @@ ompl::base::PlannerStatus ompl::geometric::RRTstar::solve(const base::PlannerTer
     if (rmotion->state)
         si_->freeState(rmotion->state);
     delete rmotion;
+    for (auto &sample : batch)
+    {
+        si_->freeState(sample.rmotion->state);
+        si_->freeState(sample.dmotion->state);
+        delete sample.rmotion;
+        delete sample.dmotion;
+    }
 
     OMPL_INFORM("%s: Created %u new states. Checked %u rewire options. %u goal states in tree. Final solution cost "
                 "%.3f",
@@ -617,6 +764,108 @@ void ompl::geometric::RRTstar::getNeighbors(Motion *motion, std::vector<Motion *
     }
 }
 
+void ompl::geometric::RRTstar::addNeighbors(Motion *motion, const std::vector<Motion *> &added,
+                                            std::vector<Motion *> &nbh) const
+{
+    if (added.empty())
+        return;
+    // the size of the neighborhood is the one getNeighbors() used before the motions were added
+    auto cardDbl = static_cast<double>(nn_->size() - added.size() + 1u);
+    if (useKNearest_)
+    {
+        auto k = static_cast<std::size_t>(std::ceil(k_rrt_ * log(cardDbl)));
+        std::vector<std::pair<double, Motion *>> candidates;
+        candidates.reserve(nbh.size() + added.size());
+        for (Motion *m : nbh)
+            candidates.emplace_back(distanceFunction(m, motion), m);
+        for (Motion *m : added)
+            candidates.emplace_back(distanceFunction(m, motion), m);
+        std::stable_sort(candidates.begin(), candidates.end(),
+                         [](const std::pair<double, Motion *> &a, const std::pair<double, Motion *> &b)
+                         { return a.first < b.first; });
+        nbh.clear();
+        for (std::size_t i = 0; i < std::min(k, candidates.size()); ++i)
+            nbh.push_back(candidates[i].second);
+    }
+    else
+    {
+        double r = std::min(
+            maxDistance_, r_rrt_ * std::pow(log(cardDbl) / cardDbl, 1 / static_cast<double>(si_->getStateDimension())));
+        for (Motion *m : added)
+            if (distanceFunction(m, motion) <= r)
+                nbh.push_back(m);
+    }
+}
+
+std::size_t ompl::geometric::RRTstar::prepareSamples(std::vector<PreparedSample> &batch,
+                                                     base::GoalSampleableRegion *goal_s, bool skipNearestEqual,
+                                                     unsigned int &failures)
+{
+    std::size_t count = 0;
+    for (unsigned int i = 0; i < neighborhoodBatchSize_; ++i)
+    {
+        if (count == batch.size())
+            batch.push_back({new Motion(si_), new Motion(si_), nullptr, false, {}});
+        base::State *rstate = batch[count].rmotion->state;
+        // sample with goal biasing, as solve() does for a single sample
+        if (goal_s && goalMotions_.size() < goal_s->maxSampleCount() && rng_.uniform01() < goalBias_ &&
+            goal_s->canSample())
+            goal_s->sampleGoal(rstate);
+        else if (!sampleUniform(rstate))
+        {
+            ++failures;
+            continue;
+        }
+        ++count;
+    }
+
+    // The workers check with the dynamic obstacles bound on the calling thread
+    const base::StateValidityChecker::ScopedDynamicObstacles *scope =
+        base::StateValidityChecker::ScopedDynamicObstacles::current();
+    workers().parallelFor(count, [&](unsigned int /*thread*/, std::size_t i)
+                          {
+                              base::StateValidityChecker::ScopedDynamicObstacles::Inherit inherit(scope);
+                              PreparedSample &sample = batch[i];
+                              sample.nmotion = nn_->nearest(sample.rmotion);
+                              sample.reachable = false;
+                              sample.nbh.clear();
+                              if (skipNearestEqual &&
+                                  si_->equalStates(sample.nmotion->state, sample.rmotion->state))
+                                  return;
+                              double d = si_->distance(sample.nmotion->state, sample.rmotion->state);
+                              if (d > maxDistance_)
+                                  si_->getStateSpace()->interpolate(sample.nmotion->state, sample.rmotion->state,
+                                                                    maxDistance_ / d, sample.dmotion->state);
+                              else
+                                  si_->copyState(sample.dmotion->state, sample.rmotion->state);
+                              sample.reachable = si_->checkMotion(sample.nmotion->state, sample.dmotion->state);
+                              if (sample.reachable)
+                                  getNeighbors(sample.dmotion, sample.nbh);
+                          });
+    return count;
+}
+
+ompl::WorkerPool &ompl::geometric::RRTstar::workers() const
+{
+    if (!workers_ || workers_->getNumThreads() != numThreads_)
+        workers_ = std::make_unique<WorkerPool>(numThreads_);
+    return *workers_;
+}
+
+void ompl::geometric::RRTstar::checkMotionsInParallel(const std::size_t *indices, std::size_t count,
+                                                      const std::function<bool(std::size_t)> &check,
+                                                      std::vector<int> &valid) const
+{
+    // The workers check with the dynamic obstacles bound on the calling thread
+    const base::StateValidityChecker::ScopedDynamicObstacles *scope =
+        base::StateValidityChecker::ScopedDynamicObstacles::current();
+    workers().parallelFor(count, [&](unsigned int /*thread*/, std::size_t j)
+                          {
+                              base::StateValidityChecker::ScopedDynamicObstacles::Inherit inherit(scope);
+                              valid[indices[j]] = check(indices[j]) ? 1 : -1;
+                          });
+}
+
 void ompl::geometric::RRTstar::removeFromParent(Motion *m)
 {
     for (auto it = m->parent->children.begin(); it != m->parent->children.end(); ++it)
@@ -638,6 +887,23 @@ void ompl::geometric::RRTstar::updateChildCosts(Motion *m)
     }
 }
 
+ompl::base::Cost ompl::geometric::RRTstar::currentCost(const Motion *m, const Motion *rewiredParent) const
+{
+    if (rewiredParent->children.empty())
+        return m->cost;
+    // find the rewired ancestor of m, if any, and add up the incremental costs from there
+    std::vector<const Motion *> path;
+    const Motion *a = m;
+    for (; a->parent != nullptr && a->parent != rewiredParent; a = a->parent)
+        path.push_back(a);
+    if (a->parent == nullptr)
+        return m->cost;
+    base::Cost cost = a->cost;
+    for (auto it = path.rbegin(); it != path.rend(); ++it)
+        cost = opt_->combineCosts(cost, (*it)->incCost);
+    return cost;
+}
+
 void ompl::geometric::RRTstar::freeMemory()
 {
     if (nn_)
@@ -37,6 +37,7 @@
 #include "ompl/geometric/planners/rrt/pRRT.h"
 #include "ompl/base/goals/GoalSampleableRegion.h"
 #include "ompl/tools/config/SelfConfig.h"
+#include "ompl/tools/config/ThreadPlacement.h"
 #include <limits>
 
 ompl::geometric::pRRT::pRRT(const base::SpaceInformationPtr &si) : base::Planner(si, "pRRT"), samplerArray_(si)
@@ -204,9 +205,11 @@ ompl::base::PlannerStatus ompl::geometric::pRRT::solve(const base::PlannerTermin
     sol.approxdif = std::numeric_limits<double>::infinity();
 
     std::vector<std::thread *> th(threadCount_);
+    const tools::ThreadPlacement::Reservation placement(threadCount_);
     for (unsigned int i = 0; i < threadCount_; ++i)
-        th[i] = new std::thread([this, i, &ptc, &sol]
+        th[i] = new std::thread([this, i, &placement, &ptc, &sol]
                                 {
+                                    placement.pinWorker(i);
                                     return threadSolve(i, ptc, &sol);
                                 });
     for (unsigned int i = 0; i < threadCount_; ++i)
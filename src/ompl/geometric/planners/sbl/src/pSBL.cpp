@@ -37,6 +37,7 @@
 #include "ompl/geometric/planners/sbl/pSBL.h"
 #include "ompl/base/goals/GoalState.h"
 #include "ompl/tools/config/SelfConfig.h"
+#include "ompl/tools/config/ThreadPlacement.h"
 #include <limits>
 #include <cassert>
 
@@ -241,8 +242,13 @@ ompl::base::PlannerStatus ompl::geometric::pSBL::solve(const base::PlannerTermin
     loopCounter_ = 0;
 
     std::vector<std::thread *> th(threadCount_);
+    const tools::ThreadPlacement::Reservation placement(threadCount_);
     for (unsigned int i = 0; i < threadCount_; ++i)
-        th[i] = new std::thread([this, i, &ptc, &sol] { threadSolve(i, ptc, &sol); });
+        th[i] = new std::thread([this, i, &placement, &ptc, &sol]
+                                {
+                                    placement.pinWorker(i);
+                                    threadSolve(i, ptc, &sol);
+                                });
     for (unsigned int i = 0; i < threadCount_; ++i)
     {
         th[i]->join();
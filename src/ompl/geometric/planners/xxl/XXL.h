@@ -37,12 +37,16 @@
 #ifndef OMPL_GEOMETRIC_PLANNERS_XXL_XXL_
 #define OMPL_GEOMETRIC_PLANNERS_XXL_XXL_
 
+#include <functional>
+#include <memory>
 #include <thread>
 #include <unordered_map>
 #include "ompl/util/Hash.h"
+#include "ompl/util/WorkerPool.h"
 #include "ompl/datastructures/AdjacencyList.h"
 #include "ompl/geometric/planners/PlannerIncludes.h"
 #include "ompl/geometric/planners/xxl/XXLDecomposition.h"
+#include "ompl/tools/config/ThreadPlacement.h"
 
 
 namespace ompl
@@ -93,6 +97,20 @@ namespace ompl
                 rand_walk_rate_ = rate;
             }
 
+            // Set the number of threads used to sample the regions along a lead and to verify the edges between the
+            // states of a region (or of two adjacent regions).  The lead computation and the roadmap updates stay on
+            // the calling thread.  With more than one thread, the state validity checker must be thread safe.
+            void setNumThreads(unsigned int numThreads);
+            unsigned int getNumThreads() const
+            {
+                return numThreads_;
+            }
+
+            // Decompositions keep scratch data while sampling, so regions are only sampled on worker threads when
+            // each worker can allocate a decomposition of its own.  The allocated decompositions must be equivalent
+            // to the one given to the planner.
+            void setDecompositionAllocator(const XXLDecompositionAllocator &alloc);
+
         protected:
             // Quickly insert, check membership, and grab a unique integer from a range [0, max)
             class PerfectSet
@@ -405,6 +423,10 @@ namespace ompl
             int steerToRegion(Layer *layer, int from, int to);
             int expandToRegion(Layer *layer, int from, int to, bool useExisting = false);
 
+            // Sample one state per (region, seed) pair on the worker threads and add the valid ones to the roadmap
+            void sampleRegions(const std::vector<std::pair<int, const base::State *>> &samples, int level,
+                               std::vector<int> &newStates);
+
             bool feasibleLead(Layer *layer, const std::vector<int> &lead,
                               const ompl::base::PlannerTerminationCondition &ptc);
             bool connectLead(Layer *layer, const std::vector<int> &lead, std::vector<int> &candidateRegions,
@@ -413,6 +435,16 @@ namespace ompl
             void connectRegions(Layer *layer, int r1, int r2, const base::PlannerTerminationCondition &ptc,
                                 bool all = false);
 
+            // Verify the lazy edges between the motions in first and second on the worker threads, in batches.  When
+            // sameRegion is true, first and second are the same list and each pair is considered once.
+            void connectMotions(Layer *layer, const std::vector<int> &first, const std::vector<int> &second,
+                                bool sameRegion, const base::PlannerTerminationCondition &ptc);
+            // Add a verified edge between m1 and m2 to the real graph and update the region storage
+            void addVerifiedEdge(Layer *layer, const Motion *m1, const Motion *m2);
+
+            // Run job(thread, i) for every i in [0, count) on the numThreads_ threads of workers_
+            void parallelFor(std::size_t count, const std::function<void(unsigned int, std::size_t)> &job) const;
+
             // Compute a new lead in the given decomposition layer from start to goal
             void computeLead(Layer *layer, std::vector<int> &lead);
 
@@ -482,6 +514,21 @@ namespace ompl
             std::vector<bool> closedList_;
 
             double rand_walk_rate_{-1.0};
+
+            // The number of threads used for region sampling and edge verification
+            unsigned int numThreads_{1u};
+
+            // The CPUs of the worker threads, released after the workers are joined
+            mutable std::unique_ptr<tools::ThreadPlacement::Reservation> placement_;
+
+            // The worker threads of parallelFor(), started on first use and placed by ThreadPlacement
+            mutable std::unique_ptr<WorkerPool> workers_;
+
+            // Allocates the decompositions of the worker threads
+            XXLDecompositionAllocator decompositionAllocator_;
+
+            // One decomposition per worker thread.  Empty unless an allocator is set and numThreads_ > 1
+            std::vector<XXLDecompositionPtr> workerDecompositions_;
         };
     }  // namespace geometric
 }  // namespace ompl
@@ -37,6 +37,7 @@
 #ifndef OMPL_GEOMETRIC_PLANNERS_XXL_XXLDECOMPOSITION_
 #define OMPL_GEOMETRIC_PLANNERS_XXL_XXLDECOMPOSITION_
 
+#include <functional>
 #include <vector>
 #include "ompl/base/State.h"
 #include "ompl/base/spaces/RealVectorBounds.h"
@@ -55,6 +56,10 @@ namespace ompl
         /** \class ompl::geometric::XXLDecompositionPtr
             \brief A shared pointer wrapper for ompl::geometric::XXLDecomposition */
 
+        /** \brief A function that allocates a new decomposition.  XXL uses it to give each of its worker threads a
+            decomposition of its own (see XXL::setDecompositionAllocator()) */
+        using XXLDecompositionAllocator = std::function<XXLDecompositionPtr()>;
+
         /** \brief */
         class XXLDecomposition
         {
@@ -40,12 +40,14 @@
 #include "ompl/base/goals/GoalLazySamples.h"
 #include "ompl/tools/config/MagicConstants.h"
 #include "ompl/tools/config/SelfConfig.h"
+#include "ompl/tools/config/ThreadPlacement.h"
 #include "ompl/util/Exception.h"
 
 ompl::geometric::XXL::XXL(const ompl::base::SpaceInformationPtr &si) : base::Planner(si, "XXL")
 {
     xstate_ = si_->allocState();
     Planner::declareParam<double>("rand_walk_rate", this, &XXL::setRandWalkRate, &XXL::getRandWalkRate, "0.:.05:1.");
+    Planner::declareParam<unsigned int>("num_threads", this, &XXL::setNumThreads, &XXL::getNumThreads, "1:1:64");
 }
 
 ompl::geometric::XXL::XXL(const ompl::base::SpaceInformationPtr &si, const XXLDecompositionPtr &decomp)
@@ -54,6 +56,7 @@ ompl::geometric::XXL::XXL(const ompl::base::SpaceInformationPtr &si, const XXLDe
     xstate_ = si_->allocState();
     setDecomposition(decomp);
     Planner::declareParam<double>("rand_walk_rate", this, &XXL::setRandWalkRate, &XXL::getRandWalkRate, "0.:.05:1.");
+    Planner::declareParam<unsigned int>("num_threads", this, &XXL::setNumThreads, &XXL::getNumThreads, "1:1:64");
 }
 
 ompl::geometric::XXL::~XXL()
@@ -137,6 +140,18 @@ void ompl::geometric::XXL::setup()
     }
 }
 
+void ompl::geometric::XXL::setNumThreads(unsigned int numThreads)
+{
+    numThreads_ = std::max(numThreads, 1u);
+    specs_.multithreaded = numThreads_ > 1;
+}
+
+void ompl::geometric::XXL::setDecompositionAllocator(const XXLDecompositionAllocator &alloc)
+{
+    decompositionAllocator_ = alloc;
+    workerDecompositions_.clear();
+}
+
 void ompl::geometric::XXL::setDecomposition(const XXLDecompositionPtr &decomp)
 {
     decomposition_ = decomp;
@@ -527,6 +542,17 @@ bool ompl::geometric::XXL::sampleAlongLead(Layer *layer, const std::vector<int>
     int numSampleAttempts = 10;
     std::vector<int> newStates;
 
+    // With worker decompositions, the (region, seed) pairs are collected here and sampled in parallel below
+    const bool parallel = !workerDecompositions_.empty();
+    std::vector<std::pair<int, const base::State *>> samples;
+    auto sampleFromRegion = [&](int region, const base::State *seed)
+    {
+        if (parallel)
+            samples.emplace_back(region, seed);
+        else if (decomposition_->sampleFromRegion(region, xstate_, seed, layer->getLevel()))
+            newStates.push_back(addState(xstate_));
+    };
+
     if (lead.size() == 1)  // always sample if lead is just one cell
     {
         std::vector<int> nbrs;
@@ -548,8 +574,7 @@ bool ompl::geometric::XXL::sampleAlongLead(Layer *layer, const std::vector<int>
                     continue;
             }
 
-            if (decomposition_->sampleFromRegion(lead[0], xstate_, seed, layer->getLevel()))
-                newStates.push_back(addState(xstate_));
+            sampleFromRegion(lead[0], seed);
         }
     }
     else  // normal lead with at least two cells
@@ -590,13 +615,15 @@ bool ompl::geometric::XXL::sampleAlongLead(Layer *layer, const std::vector<int>
                             continue;
                     }
 
-                    if (decomposition_->sampleFromRegion(lead[i], xstate_, seed, layer->getLevel()))
-                        newStates.push_back(addState(xstate_));
+                    sampleFromRegion(lead[i], seed);
                 }
             }
         }
     }
 
+    if (!samples.empty())
+        sampleRegions(samples, layer->getLevel(), newStates);
+
     // Update weights after sampling
     for (size_t i = 0; i < newStates.size(); ++i)
         updateRegionProperties(motions_[newStates[i]]->levels);
@@ -606,6 +633,26 @@ bool ompl::geometric::XXL::sampleAlongLead(Layer *layer, const std::vector<int>
     return newStates.size() > 0;
 }
 
+void ompl::geometric::XXL::sampleRegions(const std::vector<std::pair<int, const base::State *>> &samples, int level,
+                                         std::vector<int> &newStates)
+{
+    std::vector<base::State *> states(samples.size(), nullptr);
+    parallelFor(samples.size(), [&](unsigned int thread, std::size_t i)
+                {
+                    base::State *state = si_->allocState();
+                    if (workerDecompositions_[thread]->sampleFromRegion(samples[i].first, state, samples[i].second,
+                                                                         level))
+                        states[i] = state;
+                    else
+                        si_->freeState(state);
+                });
+
+    // The roadmap is only modified on this thread, in the order the samples were requested
+    for (auto *state : states)
+        if (state != nullptr)
+            newStates.push_back(addThisState(state));
+}
+
 int ompl::geometric::XXL::steerToRegion(Layer *layer, int from, int to)
 {
     if (!decomposition_->canSteer())
@@ -1021,6 +1068,14 @@ void ompl::geometric::XXL::connectRegion(Layer *layer, int reg, const base::Plan
     std::vector<int> shuffledMotions(allMotions.begin(), allMotions.end());
     rng_.shuffle(shuffledMotions.begin(), shuffledMotions.end());
 
+    if (numThreads_ > 1)
+    {
+        connectMotions(layer, shuffledMotions, shuffledMotions, true, ptc);
+        layer->connectRegion(reg);
+        updateRegionProperties(layer, reg);
+        return;
+    }
+
     // size_t maxIdx = (shuffledMotions.size() > 20 ? shuffledMotions.size() / 2 : shuffledMotions.size());
     size_t maxIdx = shuffledMotions.size();
 
@@ -1115,6 +1170,14 @@ void ompl::geometric::XXL::connectRegions(Layer *layer, int r1, int r2, const ba
     std::vector<int> shuffledMotions2(allMotions2.begin(), allMotions2.end());
     rng_.shuffle(shuffledMotions2.begin(), shuffledMotions2.end());
 
+    if (numThreads_ > 1)
+    {
+        connectMotions(layer, shuffledMotions1, shuffledMotions2, false, ptc);
+        updateRegionProperties(layer, r1);
+        updateRegionProperties(layer, r2);
+        return;
+    }
+
     size_t maxConnections = std::numeric_limits<size_t>::max();
     size_t maxIdx1 = (all ? shuffledMotions1.size() : std::min(shuffledMotions1.size(), maxConnections));
     size_t maxIdx2 = (all ? shuffledMotions2.size() : std::min(shuffledMotions2.size(), maxConnections));
@@ -1180,6 +1243,103 @@ void ompl::geometric::XXL::connectRegions(Layer *layer, int r1, int r2, const ba
     updateRegionProperties(layer, r2);
 }
 
+void ompl::geometric::XXL::connectMotions(Layer *layer, const std::vector<int> &first, const std::vector<int> &second,
+                                          bool sameRegion, const base::PlannerTerminationCondition &ptc)
+{
+    // Edges are verified a batch at a time.  Between batches, pairs that were joined by the previous batch are skipped,
+    // as in the sequential search
+    const std::size_t batchSize = 16 * numThreads_;
+    std::vector<std::pair<const Motion *, const Motion *>> batch;
+    std::vector<char> valid;
+    batch.reserve(batchSize);
+
+    std::size_t i = 0, j = sameRegion ? 1 : 0;
+    while (i < first.size() && !ptc)
+    {
+        batch.clear();
+        for (; i < first.size() && batch.size() < batchSize; ++i, j = sameRegion ? i + 1 : 0)
+        {
+            const Motion *m1 = motions_[first[i]];
+            for (; j < second.size() && batch.size() < batchSize; ++j)
+            {
+                const Motion *m2 = motions_[second[j]];
+                if (lazyGraph_.edgeExists(m1->index, m2->index) && !realGraph_.inSameComponent(m1->index, m2->index))
+                {
+                    // Remove this edge so we never try and verify this edge again
+                    lazyGraph_.removeEdge(m1->index, m2->index);
+                    batch.emplace_back(m1, m2);
+                }
+            }
+            if (j < second.size())
+                break;  // the batch is full; continue with the current motion in first
+        }
+
+        valid.assign(batch.size(), 0);
+        parallelFor(batch.size(), [&](unsigned int /*thread*/, std::size_t k)
+                    { valid[k] = si_->checkMotion(batch[k].first->state, batch[k].second->state) ? 1 : 0; });
+
+        for (std::size_t k = 0; k < batch.size(); ++k)
+            if (valid[k])
+                addVerifiedEdge(layer, batch[k].first, batch[k].second);
+    }
+}
+
+void ompl::geometric::XXL::addVerifiedEdge(Layer *layer, const Motion *m1, const Motion *m2)
+{
+    double weight = si_->distance(m1->state, m2->state);
+    realGraph_.addEdge(m1->index, m2->index, weight);
+
+    // Add newly connected states to the real graph in all layers
+    for (const Motion *m : {m1, m2})
+    {
+        if (realGraph_.numNeighbors(m->index) != 1 || isStartState(m->index) || isGoalState(m->index))
+            continue;
+
+        statesConnectedInRealGraph_++;
+        Layer *l = topLayer_;
+        for (size_t i = 0; i < m->levels.size(); ++i)
+        {
+            l->getRegion(m->levels[i]).motionsInTree.push_back(m->index);
+            if (l->hasSublayers())
+                l = l->getSublayer(m->levels[i]);
+        }
+    }
+
+    updateRegionConnectivity(m1, m2, layer->getLevel());
+}
+
+void ompl::geometric::XXL::parallelFor(std::size_t count,
+                                       const std::function<void(unsigned int, std::size_t)> &job) const
+{
+    const unsigned int numThreads = (unsigned int)std::min<std::size_t>(numThreads_, count);
+    if (numThreads <= 1)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+            job(0, i);
+        return;
+    }
+
+    // The workers are started once and kept for the following loops
+    if (!workers_ || workers_->getNumThreads() != numThreads_)
+    {
+        workers_.reset();
+        placement_ = std::make_unique<tools::ThreadPlacement::Reservation>(numThreads_);
+        const tools::ThreadPlacement::Reservation *placement = placement_.get();
+        workers_ = std::make_unique<WorkerPool>(numThreads_, [placement](unsigned int thread)
+                                                {
+                                                    placement->pinWorker(thread);
+                                                });
+    }
+    // The workers check with the dynamic obstacles bound on the calling thread
+    const base::StateValidityChecker::ScopedDynamicObstacles *scope =
+        base::StateValidityChecker::ScopedDynamicObstacles::current();
+    workers_->parallelFor(count, [&](unsigned int thread, std::size_t i)
+                          {
+                              base::StateValidityChecker::ScopedDynamicObstacles::Inherit inherit(scope);
+                              job(thread, i);
+                          });
+}
+
 void ompl::geometric::XXL::computeLead(Layer *layer, std::vector<int> &lead)
 {
     if (startMotions_.size() == 0)
@@ -1343,6 +1503,15 @@ ompl::base::PlannerStatus ompl::geometric::XXL::solve(const ompl::base::PlannerT
 
     checkValidity();
 
+    // Decompositions for the worker threads that sample regions
+    if (numThreads_ > 1 && decompositionAllocator_)
+    {
+        while (workerDecompositions_.size() < numThreads_)
+            workerDecompositions_.push_back(decompositionAllocator_());
+    }
+    else
+        workerDecompositions_.clear();
+
     // Making sure goal object is valid
     base::GoalSampleableRegion *gsr = dynamic_cast<base::GoalSampleableRegion *>(pdef_->getGoal().get());
     if (!gsr)
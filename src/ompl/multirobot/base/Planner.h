@@ -40,6 +40,7 @@
 #include "ompl/multirobot/base/SpaceInformation.h"
 #include "ompl/multirobot/base/ProblemDefinition.h"
 #include "ompl/base/PlannerData.h"
+#include "ompl/base/PlannerDataStream.h"
 #include "ompl/base/Planner.h"
 #include "ompl/base/PlannerStatus.h"
 #include "ompl/base/PlannerTerminationCondition.h"
@@ -161,6 +162,12 @@ namespace ompl
                     (without calling clear() in between).  */
                 virtual void getPlannerData(ompl::base::PlannerData &data) const;
 
+                /** \brief Send the exploration datastructures of the planner (such as the trees of the individual
+                    planners) to \e sink, one vertex and one edge at a time. By default, only the progress
+                    properties of the planner are sent, as properties of vertex 0 of a section named after the
+                    planner. */
+                virtual void streamPlannerData(ompl::base::PlannerDataSink &sink) const;
+
                 /** \brief Get the name of the planner */
                 const std::string &getName() const;
 
@@ -114,6 +114,12 @@ namespace ompl
                     return (pa_) ? true : false;
                 }
 
+                /** \brief Get the planner allocator for the system */
+                const ompl::base::PlannerAllocator &getPlannerAllocator() const
+                {
+                    return pa_;
+                }
+
                 /** \brief Get a specific subspace from the compound state space */
                 const ompl::base::SpaceInformationPtr &getIndividual(unsigned int index) const;
 
@@ -130,6 +130,14 @@ void ompl::multirobot::base::Planner::getPlannerData(ompl::base::PlannerData &da
         data.properties[plannerProgressProperty.first] = plannerProgressProperty.second();
 }
 
+void ompl::multirobot::base::Planner::streamPlannerData(ompl::base::PlannerDataSink &sink) const
+{
+    sink.beginSection(getName(), nullptr);
+    for (const auto &plannerProgressProperty : plannerProgressProperties_)
+        sink.property(0, plannerProgressProperty.first, plannerProgressProperty.second());
+    sink.endSection();
+}
+
 ompl::base::PlannerStatus ompl::multirobot::base::Planner::solve(const ompl::base::PlannerTerminationConditionFn &ptc, double checkInterval)
 {
     return solve(ompl::base::PlannerTerminationCondition(ptc, checkInterval));
@@ -162,7 +162,9 @@ namespace ompl
                 /** \brief Insert a number of states in a path so that the
                     path is made up of (approximately) the states checked
                     for validity when a discrete motion validator is
-                    used. */
+                    used. As for PathControl::interpolate(), paths that are
+                    not yet interpolated must not be shared with other
+                    threads during the call. */
                 void interpolate()
                 {
                     for (ompl::control::PathControlPtr &p: paths_)
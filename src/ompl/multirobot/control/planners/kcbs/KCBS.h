@@ -40,6 +40,7 @@
 #include "ompl/multirobot/control/planners/PlannerIncludes.h"
 #include "ompl/control/PlannerData.h"
 #include "ompl/util/Exception.h"
+#include "ompl/util/RandomNumbers.h"
 #include <boost/graph/adjacency_list.hpp>
 #include <boost/graph/graphviz.hpp>
 #include <boost/property_map/transform_value_property_map.hpp>
@@ -47,9 +48,14 @@
 #include <utility>
 #include <queue>
 #include <map>
+#include <set>
 #include <unordered_set>
+#include <atomic>
 #include <chrono>
+#include <iostream>
+#include <mutex>
 #include <thread>
+#include <tuple>
 
 
 namespace ompl
@@ -91,6 +97,12 @@ namespace ompl
 
                 void getPlannerData(ompl::base::PlannerData &data) const override;
 
+                /** \brief Send the constraint tree (a section without states, whose vertices have the index,
+                    cost and constraint of the nodes as properties), the trees of the low-level planners of the
+                    robots, the trees of the low-level planners saved in nodes of the constraint tree and the data
+                    of the merged planner (if any) to \e sink. */
+                void streamPlannerData(ompl::base::PlannerDataSink &sink) const override;
+
                 ompl::base::PlannerStatus solve(const ompl::base::PlannerTerminationCondition &ptc) override;
 
                 void clear() override;
@@ -117,6 +129,159 @@ namespace ompl
                 /** Setter function for the number of workers (threads) */
                 void setNumThreads(const unsigned int value) {numThreads_ = value;};
 
+                /** \brief Race \e n low-level planners in parallel on every replan: the usual planner and \e n - 1
+                    others, allocated by the racer allocators (see setRacerAllocators()) or, if there are none, by the
+                    planner allocator of the robot. The first exact solution is used and the other planners are
+                    stopped. Since low-level solve times are heavy-tailed, this usually shortens replans more than
+                    a longer low-level solve time. Each replan then uses \e n threads, in addition to the ones set
+                    by setNumThreads(). A value of 1 (the default) disables racing, as does deterministic mode. */
+                void setNumRacers(const unsigned int n) {numRacers_ = std::max(1u, n);};
+
+                /** \brief Get the number of low-level planners raced on every replan */
+                unsigned int getNumRacers() const {return numRacers_;};
+
+                /** \brief Set the allocators of the planners that race against the usual low-level planner (see
+                    setNumRacers()). They are used in turn, so racers can differ in type or configuration. */
+                void setRacerAllocators(const std::vector<ompl::base::PlannerAllocator> &allocators) {racerAllocators_ = allocators;};
+
+                /** \brief Get the number of replans in which a racer, not the usual low-level planner, found the solution */
+                unsigned int getNumberOfRacesWonByRacers() const {return numRacesWonByRacers_;};
+
+                /** \brief Run the search deterministically. Nodes of the constraint tree are expanded one at a time in
+                    a fixed order, and every low-level solve uses a new planner whose random seeds are derived from the
+                    seed (see setSeed()), the node and the robot. Every replan and its outcome are recorded in an event
+                    log (see writeEventLog()). Low-level solves are still bounded by the low-level solve time, so a run
+                    can only be reproduced exactly by replaying its event log (see readEventLog()). */
+                void setDeterministic(const bool deterministic) {deterministic_ = deterministic;};
+
+                /** \brief Return true if the search runs deterministically */
+                bool getDeterministic() const {return deterministic_;};
+
+                /** \brief Set the seed the low-level planner seeds are derived from in deterministic mode. A seed of 0
+                    means that the seed of ompl::RNG is used. */
+                void setSeed(const unsigned int seed) {seed_ = seed;};
+
+                /** \brief Get the seed the low-level planner seeds are derived from in deterministic mode */
+                unsigned int getSeed() const {return seed_;};
+
+                /** \brief Write the event log of the last deterministic run */
+                void writeEventLog(std::ostream &out) const;
+
+                /** \brief Read an event log written by writeEventLog(). The next calls to solve() run deterministically
+                    and replay the log: low-level solves are skipped and their outcomes are taken from the log. The log
+                    is kept until clear() is called. */
+                void readEventLog(std::istream &in);
+
+                /** \brief Return true if an event log is being replayed */
+                bool isReplaying() const {return !replayEvents_.empty();};
+
+                /** \brief Branch on the most constraining conflict of a node instead of its earliest one. Every pair
+                    of robots in conflict is classified with cheap probes of its two constraints: a constraint makes
+                    the replan of its robot more expensive if the robot is in conflict at its start, or if it already
+                    waits at the end of its path while the other robot passes through. The probes ignore that a goal
+                    region may offer other places to stop, so the classification is a heuristic. A conflict is
+                    cardinal if both replans get more expensive and semi-cardinal if one does. Cardinal conflicts are
+                    branched on first, then semi-cardinal ones, then the others; ties go to the earliest conflict.
+                    Branching on cardinal conflicts first raises the cost of the constraint tree sooner and leaves it
+                    smaller. Disabled by default. */
+                void setPrioritizeConflicts(const bool prioritize) {prioritizeConflicts_ = prioritize;};
+
+                /** \brief Return true if the search branches on the most constraining conflict of a node */
+                bool getPrioritizeConflicts() const {return prioritizeConflicts_;};
+
+                /** \brief Get the number of nodes that were expanded on a cardinal conflict */
+                unsigned int getNumberOfCardinalConflicts() const {return numCardinalConflicts_;};
+
+                /** \brief Get the number of nodes that were expanded on a semi-cardinal conflict */
+                unsigned int getNumberOfSemiCardinalConflicts() const {return numSemiCardinalConflicts_;};
+
+                /** \brief Adopt the plan of a child node into the node being expanded, instead of adding both
+                    children to the constraint tree, if the plan of the child has strictly fewer conflicts and its
+                    replanned path takes no longer than the path it replaces (see setBypassTolerance()). The node is
+                    then expanded again in place. This keeps low-level solves from being spent on subtrees that the
+                    adopted plan makes unnecessary. Disabled by default. */
+                void setBypass(const bool bypass) {bypass_ = bypass;};
+
+                /** \brief Return true if children with fewer conflicts are adopted by their parent */
+                bool getBypass() const {return bypass_;};
+
+                /** \brief Set the fraction by which the replanned path of an adopted child may take longer than the
+                    path it replaces. The default of 0 adopts only children whose path takes no longer. Kinodynamic
+                    planners practically never find paths of equal duration, so a small tolerance (such as 0.05) lets
+                    bypass apply more often, at the cost of a plan that may be slightly longer. */
+                void setBypassTolerance(const double tolerance) {bypassTolerance_ = std::max(0., tolerance);};
+
+                /** \brief Get the fraction by which the path of an adopted child may take longer */
+                double getBypassTolerance() const {return bypassTolerance_;};
+
+                /** \brief Get the number of times the plan of a child was adopted by its parent */
+                unsigned int getNumberOfBypasses() const {return numBypasses_;};
+
+                /** \brief Split the robots into independent groups before searching the constraint tree. Robots
+                    whose root paths are in conflict, directly or through other robots, form a group. Every group
+                    of more than one robot is solved as a sub-problem by its own instance of K-CBS, and the groups
+                    are solved in parallel, sharing the threads set by setNumThreads(). When the plans of two groups
+                    are in conflict, the groups are merged and solved again. If all robots end up in one group, or
+                    a group cannot be solved, the constraint tree of all robots is searched as usual. At most half
+                    as many groups as threads are solved at a time, so the groups do not use more threads than this
+                    planner. The sub-problems have no SystemMerger: a group whose conflicts reach the merge bound
+                    (see setMergeBound()) stops, and its robots are then planned for together with all others, where
+                    they can be merged. Disabled by default, and in deterministic mode. */
+                void setIndependenceDetection(const bool detect) {independenceDetection_ = detect;};
+
+                /** \brief Return true if the robots are split into independent groups */
+                bool getIndependenceDetection() const {return independenceDetection_;};
+
+                /** \brief Get the number of independent groups the robots of the last solution were planned in (1
+                    if they were planned for together) */
+                unsigned int getNumberOfGroups() const {return numGroups_;};
+
+                /** \brief Only resolve conflicts in the first \e seconds of the plan. Conflicts that occur later are
+                    neither found nor added to the constraint tree, so the plan is kept beyond the window but may
+                    be in conflict there. The time spent in the constraint tree then depends on the length of the
+                    window rather than on the length of the plan. This mode is meant to be used in a receding
+                    horizon: after executing part of the plan, set the current states of the robots as their start
+                    states, clear the solutions of the problem definition and the planner, and solve again. A
+                    window of 0 (the default) resolves the conflicts of the whole plan. */
+                void setConflictWindow(const double seconds) {conflictWindow_ = std::max(0., seconds);};
+
+                /** \brief Get the length of the time window in which conflicts are resolved (0 for the whole plan) */
+                double getConflictWindow() const {return conflictWindow_;};
+
+                /** \brief Tune the search while it runs. The low-level solve time of every robot starts at the
+                    low-level solve time (or at the value learned for the scenario class, see readTuning()) and is
+                    then adapted to the solve times observed for that robot: it shrinks towards a multiple of the
+                    90th percentile of its successful solve times and grows after every failed solve, within
+                    [0.1, 10] times the low-level solve time. If a SystemMerger is set, a pair of robots is also
+                    merged early when it is in conflict in most recently evaluated nodes, without waiting for the
+                    merge bound. Finally, the threads not used to expand nodes in parallel are used to race
+                    low-level planners (see setNumRacers()). The number of racers starts at setNumRacers() (or at
+                    the value learned for the scenario class) and is adapted to the races: it grows when a solve
+                    fails or a racer wins, and shrinks when the usual low-level planner wins, without exceeding the
+                    threads that are free. Tuning is disabled in deterministic mode. */
+                void setAutoTune(const bool autoTune) {autoTune_ = autoTune;};
+
+                /** \brief Return true if the search tunes itself while it runs */
+                bool getAutoTune() const {return autoTune_;};
+
+                /** \brief Set the name of the class of scenarios the problem belongs to. The settings learned by
+                    auto-tuning are stored per scenario class (see writeTuning()). By default, the class is given by
+                    the number of robots and the name of the low-level planner. */
+                void setScenarioClass(const std::string &scenarioClass) {scenarioClass_ = scenarioClass;};
+
+                /** \brief Get the name of the class of scenarios the problem belongs to */
+                std::string getScenarioClass() const;
+
+                /** \brief Get the low-level solve time currently used for \e robot */
+                double getRobotSolveTime(const unsigned int robot) const;
+
+                /** \brief Write the settings learned by auto-tuning for every scenario class */
+                void writeTuning(std::ostream &out) const;
+
+                /** \brief Read settings written by writeTuning(). The settings of the scenario class of the problem
+                    are used as the starting point of the next calls to solve() with auto-tuning. */
+                void readTuning(std::istream &in);
+
                 /** \brief Output the constraint tree in graphViz format. */
                 void printConstraintTree(std::ostream &out)
                 {
@@ -153,22 +318,26 @@ namespace ompl
                 OMPL_CLASS_FORWARD(Constraint);
                 /// @endcond
 
-                // A collection of dynamic obstacles for a robot
+                // A dynamic obstacle for a robot: another robot's trajectory during a window of time steps
                 struct Constraint
                 {
-                    Constraint(int r): constrainedRobot_(r), constrainingSiC_(nullptr), timeSteps_(), constrainingStates_() {}
-                    Constraint(int r, ompl::control::SpaceInformationPtr otherSiC): 
-                        constrainedRobot_(r), constrainingSiC_(otherSiC), timeSteps_(), constrainingStates_() {}
+                    Constraint(int r, ompl::control::SpaceInformationPtr otherSiC, int first, int last,
+                               ompl::base::StateValidityChecker::Trajectory trajectory):
+                        constrainedRobot_(r), constrainingSiC_(otherSiC), firstStep_(first), lastStep_(last),
+                        constrainingTrajectory_(std::move(trajectory)) {}
                     ~Constraint()
                     {
                         constrainingSiC_.reset();
-                        // for (auto &st: constrainingStates_)
-                        //     constrainingSiC_->freeState(st);
                     }
                     unsigned int constrainedRobot_;
                     ompl::control::SpaceInformationPtr constrainingSiC_;
-                    std::vector<int> timeSteps_;
-                    std::vector<ompl::base::State*> constrainingStates_;
+                    /** \brief The first time step of the window */
+                    int firstStep_;
+                    /** \brief The last time step of the window */
+                    int lastStep_;
+                    /** \brief The (interpolated) trajectory of the constraining robot, shared with the plan of the
+                        node the constraint was created from */
+                    ompl::base::StateValidityChecker::Trajectory constrainingTrajectory_;
                 };
 
                 /// @cond IGNORE
@@ -209,6 +378,15 @@ namespace ompl
 
                     void setID(const int id) {id_ = id;};
 
+                    void setIndex(const unsigned int index)
+                    {
+                        index_ = index;
+                        name_ = "n" + std::to_string(index);
+                    };
+
+                    /** \brief Return the number of the next replan attempt for this node */
+                    unsigned int nextAttempt() {return attempts_++;};
+
                     void setLowLevelSolver(ompl::base::PlannerPtr &planner) {llSolver_ = planner;};
 
                     void setConflicts(std::vector<Conflict> c) {conflicts_ = c;};
@@ -225,6 +403,8 @@ namespace ompl
 
                     int getID() const {return id_;};
 
+                    unsigned int getIndex() const {return index_;};
+
                     const std::vector<Conflict> getConflicts() const {return conflicts_;};
 
                     std::string getLabel()
@@ -239,8 +419,8 @@ namespace ompl
                         if (constraint_)
                         {
                             contstraintString = "{" + std::to_string(constraint_->constrainedRobot_) + 
-                                                ", [" + std::to_string(constraint_->timeSteps_.front()) + "," +
-                                                std::to_string(constraint_->timeSteps_.back()) + "]}";
+                                                ", [" + std::to_string(constraint_->firstStep_) + "," +
+                                                std::to_string(constraint_->lastStep_) + "]}";
                         }
                         else
                             contstraintString = "None";
@@ -291,6 +471,12 @@ namespace ompl
                     /** \brief The ID of the node is equal to the order that this* was popped from the priority queue -- used by BoostGraph */
                     int id_;
 
+                    /** \brief The order in which the node was created, used to break ties between nodes of equal cost */
+                    unsigned int index_{0};
+
+                    /** \brief The number of replan attempts made for this node */
+                    unsigned int attempts_{0};
+
                     /** \brief The PlannerPtr responsible for filling this node. Only use during retry */
                     ompl::base::PlannerPtr llSolver_;
 
@@ -303,8 +489,10 @@ namespace ompl
                 {
                     bool operator()(const NodePtr &n1, const NodePtr &n2) const
                     {
-                        // defines a min-heap on a nodes cost
-                        return n1->getCost() > n2->getCost();
+                        // defines a min-heap on a nodes cost, ties are broken in favor of the older node
+                        if (n1->getCost() != n2->getCost())
+                            return n1->getCost() > n2->getCost();
+                        return n1->getIndex() > n2->getIndex();
                     }
                 };
 
@@ -317,6 +505,80 @@ namespace ompl
                     }
                 };
 
+                /** \brief A low-level solve recorded in the event log */
+                struct Event
+                {
+                    /** \brief The index of the node the solve was made for (0 for the root) */
+                    unsigned int node_;
+                    /** \brief The index of the parent node (equal to node_ for the root) */
+                    unsigned int parent_;
+                    /** \brief The robot that was planned for */
+                    unsigned int robot_;
+                    /** \brief The replan attempt for the node */
+                    unsigned int attempt_;
+                    /** \brief The first and last time step of the constraint of the node (empty for the root) */
+                    std::vector<int> timeSteps_;
+                    /** \brief The path that was found, nullptr if the solve did not find an exact solution */
+                    ompl::control::PathControlPtr path_;
+                };
+
+                /** \brief Give a newly created node the next index */
+                void assignIndex(const NodePtr &n) {n->setIndex(nextNodeIndex_++);};
+
+                /** \brief Derive the seed of a low-level solve in deterministic mode */
+                std::uint_fast32_t deriveSeed(unsigned int node, unsigned int robot, unsigned int attempt) const;
+
+                /** \brief Allocate a new low-level planner for robot, with its own copy of the problem definition of robot */
+                ompl::base::PlannerPtr allocateLowLevelPlanner(const unsigned int robot) const;
+
+                /** \brief Allocate a new low-level planner for robot with seeds derived from node and attempt into
+                    \e planner, and solve with it. Used in deterministic mode. */
+                ompl::base::PlannerStatus seededSolve(const unsigned int robot, const unsigned int node, const unsigned int attempt, ompl::base::PlannerPtr &planner);
+
+                /** \brief Solve with \e planner, racing it against other planners if requested (see
+                    setNumRacers()). The racers check states against \e obstacles. On an exact solution, \e planner
+                    is set to the planner that found it. */
+                ompl::base::PlannerStatus raceSolve(const unsigned int robot, ompl::base::PlannerPtr &planner,
+                                                    const ompl::base::DynamicObstaclesConstPtr &obstacles);
+
+                /** \brief The settings learned by auto-tuning for a scenario class */
+                struct Tuning
+                {
+                    /** \brief The low-level solve time of every robot */
+                    std::vector<double> solveTimes_;
+                    /** \brief The number of low-level planners raced on every replan */
+                    unsigned int racers_{1};
+                };
+
+                /** \brief Return true if the search is tuned while it runs */
+                bool isTuning() const {return autoTune_ && !deterministic_;};
+
+                /** \brief Set the low-level solve times from the settings learned for the scenario class */
+                void startTuning();
+
+                /** \brief Store the settings learned during the last call to solve() for the scenario class */
+                void storeTuning();
+
+                /** \brief Update the low-level solve time of \e robot after a solve that took \e seconds */
+                void recordSolveTime(const unsigned int robot, const double seconds, const bool solved);
+
+                /** \brief Update the number of racers after a solve with \e racers planners, of which \e winner found
+                    the solution (0 for the usual low-level planner, -1 if none did) */
+                void recordRace(const unsigned int racers, const int winner);
+
+                /** \brief Solve with \e planner for at most the low-level solve time of \e robot */
+                ompl::base::PlannerStatus timedSolve(const unsigned int robot, const ompl::base::PlannerPtr &planner);
+
+                /** \brief Look up a low-level solve in the replayed event log. Returns nullptr if it is not there. */
+                const Event *findReplayEvent(unsigned int node, unsigned int robot, unsigned int attempt) const;
+
+                /** \brief Record a low-level solve in the event log */
+                void recordEvent(Event event);
+
+                /** \brief Solve for the root node one robot at a time. Used in deterministic mode. Returns false if
+                    a robot could not be solved for before ptc was triggered. */
+                bool sequentialRootSolution(PlanControlPtr plan, const ompl::base::PlannerTerminationCondition &ptc);
+
                 /** \brief A cost of a node is equivalent to the number of unique conflict pairs */
                 int evaluateCost(const std::vector<Conflict> confs);
 
@@ -327,13 +589,62 @@ namespace ompl
                 void parallelRootSolutionHelper(PlanControlPtr plan, unsigned int startIdx, unsigned int endIdx, const ompl::base::PlannerTerminationCondition &ptc);
 
                 /** \breif expand a single node from the queue, check it for conflicts, and expand it */
-                void parallelNodeExpansion(NodePtr& solution, std::vector<unsigned int>& resevered, std::pair<int, int>& merge_indices);
+                void parallelNodeExpansion(NodePtr& solution, std::pair<int, int>& merge_indices);
 
-                /** \brief The main replanning function for the high-level constraint tree. Updates data of node if replan was successful */
+                /** \brief The main replanning function for the high-level constraint tree. Updates data of node if
+                    replan was successful. The caller adds the node to the priority queue. */
                 void attemptReplan(const unsigned int robot, NodePtr node, const bool retry = false);
 
-                /** \brief Create a constraint from the conflicts */
-                const ConstraintPtr createConstraint(const unsigned int robot, std::vector<Conflict> &confs);
+                /** \brief Run a low-level solver for robot with the constraints of node as its dynamic obstacles. The
+                    obstacles and the planner (set to \e planner) belong to this replan only, so several replans for
+                    the same robot can run at once. Returns the path that was found, or nullptr if no exact solution
+                    was found. */
+                ompl::control::PathControlPtr lowLevelReplan(const unsigned int robot, const NodePtr &node, const unsigned int attempt, const bool retry, ompl::base::PlannerPtr &planner);
+
+                /** \brief The classes of conflicts, by the number of replans that resolving them makes more expensive */
+                enum ConflictType
+                {
+                    NON_CARDINAL = 0,
+                    SEMI_CARDINAL,
+                    CARDINAL
+                };
+
+                /** \brief Return the first and last time step of the conflicts between robot and other_robot */
+                std::pair<int, int> conflictWindow(const unsigned int robot, const unsigned int other_robot, const std::vector<Conflict> &confs) const;
+
+                /** \brief Probe whether avoiding the trajectory of other_robot during window makes any replan of robot
+                    more expensive than its path in plan. The probe is a heuristic: it misses constraints that only
+                    force a detour, and since it checks the last state of the path rather than the whole goal
+                    region, it may report a cost increase that a replan stopping elsewhere in the goal region avoids.
+                    Either way, only the order in which conflicts are branched on is affected. */
+                bool replanMustCostMore(const unsigned int robot, const unsigned int other_robot, const std::pair<int, int> &window, const PlanControlPtr &plan) const;
+
+                /** \brief Select the conflict to branch on (see setPrioritizeConflicts()) */
+                const Conflict &selectConflict(const std::vector<Conflict> &confs, const PlanControlPtr &plan);
+
+                /** \brief Join \e groups of robots that are in conflict in \e confs (union-find). The groups are
+                    sorted, and ordered by their first robot. */
+                std::vector<std::vector<unsigned int>> joinGroups(const std::vector<std::vector<unsigned int>> &groups, const std::vector<Conflict> &confs) const;
+
+                /** \brief Allocate an instance of K-CBS, with the settings of this one, for the sub-problem of the
+                    robots of \e group */
+                KCBSPtr allocateGroupPlanner(const std::vector<unsigned int> &group, const unsigned int numThreads) const;
+
+                /** \brief Solve the independent groups of robots given by the conflicts \e confs of the root plan
+                    \e rootPlan (see setIndependenceDetection()). Returns the plan of all robots, or nullptr if the
+                    robots cannot be planned for in groups. */
+                PlanControlPtr solveIndependentGroups(const PlanControlPtr &rootPlan, const std::vector<Conflict> &confs, const ompl::base::PlannerTerminationCondition &ptc);
+
+                /** \brief Give \e planner (of a merged or grouped sub-problem) the settings of this planner */
+                void configureSubPlanner(KCBS &planner) const;
+
+                /** \brief Return the child of \e node whose plan \e node should adopt (see setBypass()), or nullptr */
+                NodePtr findBypass(const NodePtr &node, const std::vector<NodePtr> &children) const;
+
+                /** \brief Create a constraint for the robot at \e index of \e conflict from the conflicts of plan. The
+                    constraint covers the window of time steps from the first to the last conflict between the two
+                    robots of \e conflict. */
+                const ConstraintPtr createConstraint(const unsigned int index, const Conflict &conflict, const std::vector<Conflict> &confs, const PlanControlPtr &plan);
 
                 /** Function to check if a merge is needed. */
                 std::pair<int, int> mergeNeeded();
@@ -341,13 +652,14 @@ namespace ompl
                 /** \brief Updates the conflictCounter_ given the new set of conflicts. */
                 void updateConflictCounter(const std::vector<Conflict> &conflicsts);
 
-                /** \brief Function that simulates a plan to determine if it is valid. */
+                /** \brief Function that simulates a plan to determine if it is valid. Only the steps inside the
+                    conflict window are simulated (see setConflictWindow()). */
                 std::vector<Conflict> findConflicts(const PlanControlPtr &plan) const;
 
                 /** \brief Add a node to the priority queue and the allNodes_ list */
                 void pushNode(const NodePtr &n);
 
-                /** \brief Get the top element and then pop it out of the queue */
+                /** \brief Get the top element and then pop it out of the queue (nullptr if the queue is empty) */
                 NodePtr popNode();
 
                 /** \brief Helper function for splitting a number of jobs evenly amongst a number of workers*/
@@ -359,7 +671,7 @@ namespace ompl
                 /** \brief The base::SpaceInformation cast as control::SpaceInformation, for convenience */
                 const SpaceInformation *siC_;
 
-                /** \brief An ordered container containing a solver for every individual */
+                /** \brief An ordered container containing the solver of the root solution of every individual */
                 std::vector<ompl::base::PlannerPtr> llSolvers_;
 
                 /** \brief The computation time for the low-level solver. */
@@ -387,7 +699,7 @@ namespace ompl
                 /** \brief The number of nodes expanded during the search. */
                 unsigned int numNodesExpanded_;
 
-                unsigned int numApproxSolutions_;
+                std::atomic<unsigned int> numApproxSolutions_;
 
                 double rootSolveTime_;
 
@@ -396,6 +708,105 @@ namespace ompl
 
                 /** \brief Another instance of K-CBS for solving the merged problem -- not always used but saved for memory purposes. */
                 KCBSPtr mergedPlanner_{nullptr};
+
+                /** \brief The number of low-level planners raced on every replan */
+                unsigned int numRacers_{1};
+
+                /** \brief The allocators of the racing planners */
+                std::vector<ompl::base::PlannerAllocator> racerAllocators_;
+
+                /** \brief The number of replans in which a racer found the solution */
+                std::atomic<unsigned int> numRacesWonByRacers_{0};
+
+                /** \brief The index the next node of the constraint tree is given */
+                std::atomic<unsigned int> nextNodeIndex_{0};
+
+                /** \brief Flag indicating whether the search runs deterministically */
+                bool deterministic_{false};
+
+                /** \brief The seed the low-level planner seeds are derived from in deterministic mode */
+                unsigned int seed_{0};
+
+                /** \brief The seed used by the last deterministic run */
+                unsigned int usedSeed_{0};
+
+                /** \brief The event log of the last deterministic run */
+                std::vector<Event> events_;
+
+                /** \brief Protects events_ */
+                mutable std::mutex eventsMutex_;
+
+                /** \brief The event log being replayed, indexed by node, robot and attempt */
+                std::map<std::tuple<unsigned int, unsigned int, unsigned int>, Event> replayEvents_;
+
+                /** \brief Flag indicating whether the search branches on the most constraining conflict */
+                bool prioritizeConflicts_{false};
+
+                /** \brief The number of nodes expanded on a cardinal conflict */
+                std::atomic<unsigned int> numCardinalConflicts_{0};
+
+                /** \brief The number of nodes expanded on a semi-cardinal conflict */
+                std::atomic<unsigned int> numSemiCardinalConflicts_{0};
+
+                /** \brief Flag indicating whether children with fewer conflicts are adopted by their parent */
+                bool bypass_{false};
+
+                /** \brief The fraction by which the path of an adopted child may take longer than the one it replaces */
+                double bypassTolerance_{0.};
+
+                /** \brief The number of times the plan of a child was adopted by its parent */
+                std::atomic<unsigned int> numBypasses_{0};
+
+                /** \brief Flag indicating whether the robots are split into independent groups */
+                bool independenceDetection_{false};
+
+                /** \brief The number of independent groups of the last solution */
+                unsigned int numGroups_{1};
+
+                /** \brief True for the sub-problem of an independent group, which stops instead of merging robots
+                    when the merge bound is reached (see setIndependenceDetection()) */
+                bool groupPlanner_{false};
+
+                /** \brief The instances of K-CBS that solved the groups of more than one robot */
+                std::vector<KCBSPtr> groupPlanners_;
+
+                /** \brief The length of the time window in which conflicts are resolved (0 for the whole plan) */
+                double conflictWindow_{0.};
+
+                /** \brief Flag indicating whether the search tunes itself while it runs */
+                bool autoTune_{false};
+
+                /** \brief The name of the class of scenarios the problem belongs to */
+                std::string scenarioClass_;
+
+                /** \brief The settings learned by auto-tuning, per scenario class */
+                std::map<std::string, Tuning> tunings_;
+
+                /** \brief The current low-level solve time of every robot */
+                std::vector<double> robotSolveTimes_;
+
+                /** \brief The most recent successful solve times of every robot */
+                std::vector<std::vector<double>> observedSolveTimes_;
+
+                /** \brief For every pair of robots, the moving average of the number of evaluated nodes in which the
+                    pair is in conflict, and the evaluation at which it was last updated */
+                std::map<std::pair<int, int>, std::pair<double, unsigned int>> conflictTrend_;
+
+                /** \brief The number of nodes evaluated */
+                unsigned int numEvaluations_{0};
+
+                /** \brief The number of low-level planners raced on every replan, chosen by auto-tuning */
+                std::atomic<unsigned int> tunedRacers_{1};
+
+                /** \brief The number of racers the threads not used to expand nodes allow for, when auto-tuning */
+                std::atomic<unsigned int> racerLimit_{1};
+
+                /** \brief Protects the statistics used by auto-tuning */
+                mutable std::mutex tuningMutex_;
+
+                /** \brief Protects the constraint tree, the priority queue, conflictCounter_ and the outcome of the
+                    node expansions running in parallel */
+                std::mutex treeMutex_;
                 
             };
         }
@@ -35,6 +35,32 @@
 /* Author: Justin Kottinger */
 
 #include "ompl/multirobot/control/planners/kcbs/KCBS.h"
+#include "ompl/tools/config/ThreadPlacement.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+namespace
+{
+    // the bounds of the tuned low-level solve times, relative to the low-level solve time
+    const double MIN_SOLVE_TIME_FACTOR = 0.1;
+    const double MAX_SOLVE_TIME_FACTOR = 10.;
+    // the tuned low-level solve time is this multiple of the 90th percentile of the successful solve times
+    const double SOLVE_TIME_MARGIN = 2.;
+    // the factor the tuned low-level solve time grows by after a failed solve
+    const double SOLVE_TIME_GROWTH = 1.5;
+    // the number of recent successful solve times kept per robot, and the number needed before they are used
+    const std::size_t SOLVE_TIME_WINDOW = 32;
+    const std::size_t MIN_SOLVE_TIME_SAMPLES = 5;
+    // the weight of the last evaluated node in the moving average of the conflicts of a pair of robots
+    const double CONFLICT_TREND_WEIGHT = 0.1;
+    // a pair of robots is merged early if its moving average reaches this value and it has been in conflict in at
+    // least this many nodes
+    const double MERGE_CONFLICT_TREND = 0.8;
+    const unsigned int MIN_MERGE_CONFLICTS = 20;
+}
 
 ompl::multirobot::control::KCBS::KCBS(const ompl::multirobot::control::SpaceInformationPtr &si): 
     ompl::multirobot::base::Planner(si, "K-CBS"), llSolveTime_(1.), mergeBound_(std::numeric_limits<int>::max()), numNodesExpanded_(0), numApproxSolutions_(0), rootSolveTime_(-1)
@@ -43,6 +69,15 @@ ompl::multirobot::control::KCBS::KCBS(const ompl::multirobot::control::SpaceInfo
 
     Planner::declareParam<double>("low_level_solve_time", this, &KCBS::setLowLevelSolveTime, &KCBS::getLowLevelSolveTime, "0.:1.:10000000.");
     Planner::declareParam<double>("merge_bound", this, &KCBS::setMergeBound, &KCBS::getMergeBound, "0:1:10000000");
+    Planner::declareParam<bool>("deterministic", this, &KCBS::setDeterministic, &KCBS::getDeterministic, "0,1");
+    Planner::declareParam<unsigned int>("seed", this, &KCBS::setSeed, &KCBS::getSeed, "0:1:1000000000");
+    Planner::declareParam<unsigned int>("num_racers", this, &KCBS::setNumRacers, &KCBS::getNumRacers, "1:1:64");
+    Planner::declareParam<bool>("auto_tune", this, &KCBS::setAutoTune, &KCBS::getAutoTune, "0,1");
+    Planner::declareParam<bool>("prioritize_conflicts", this, &KCBS::setPrioritizeConflicts, &KCBS::getPrioritizeConflicts, "0,1");
+    Planner::declareParam<bool>("bypass", this, &KCBS::setBypass, &KCBS::getBypass, "0,1");
+    Planner::declareParam<double>("bypass_tolerance", this, &KCBS::setBypassTolerance, &KCBS::getBypassTolerance, "0.:0.01:1.");
+    Planner::declareParam<bool>("independence_detection", this, &KCBS::setIndependenceDetection, &KCBS::getIndependenceDetection, "0,1");
+    Planner::declareParam<double>("conflict_window", this, &KCBS::setConflictWindow, &KCBS::getConflictWindow, "0.:1.:10000.");
 }
 
 ompl::multirobot::control::KCBS::~KCBS()
@@ -56,7 +91,14 @@ void ompl::multirobot::control::KCBS::clear()
     freeMemory();
     numNodesExpanded_ = 0;
     numApproxSolutions_ = 0;
+    numRacesWonByRacers_ = 0;
+    numCardinalConflicts_ = 0;
+    numSemiCardinalConflicts_ = 0;
+    numBypasses_ = 0;
+    numGroups_ = 1;
     rootSolveTime_ = -1;
+    nextNodeIndex_ = 0;
+    replayEvents_.clear();
 }
 
 void ompl::multirobot::control::KCBS::freeMemory()
@@ -82,6 +124,10 @@ void ompl::multirobot::control::KCBS::freeMemory()
     // free memory of the merged planner (if it exists)
     if (mergedPlanner_)
         mergedPlanner_.reset();
+    // free memory of the planners of independent groups
+    for (auto &p: groupPlanners_)
+        p.reset();
+    groupPlanners_.clear();
     // reset conflict counter
     conflictCounter_.clear();
     // clear the boost graph
@@ -101,7 +147,7 @@ void ompl::multirobot::control::KCBS::setup()
         if (dt != dt_other) 
         {
             OMPL_WARN("The propagation step size is different between planners. This may cause incorrect solutions.");
-            return;
+            break;
         }
     }
 
@@ -126,14 +172,22 @@ void ompl::multirobot::control::KCBS::setup()
         }
     }
 
-    // check if merger is set
-    if (!siC_->getSystemMerger())
+    if (deterministic_ && numRacers_ > 1)
+        OMPL_WARN("%s: Low-level planners do not race in deterministic mode.", getName().c_str());
+    if (deterministic_ && autoTune_)
+        OMPL_WARN("%s: The search is not tuned in deterministic mode.", getName().c_str());
+    if (deterministic_ && independenceDetection_)
+        OMPL_WARN("%s: Robots are not split into independent groups in deterministic mode.", getName().c_str());
+
+    // check if merger is set; the sub-problems of independent groups stop at the merge bound instead
+    if (!siC_->getSystemMerger() && !groupPlanner_ && mergeBound_ < (unsigned int)std::numeric_limits<int>::max())
         OMPL_WARN("%s: SystemMerger not set! Planner will fail if mergeBound_ is triggered.", getName().c_str());
 }
 
 void ompl::multirobot::control::KCBS::pushNode(const NodePtr &n)
 {
     // add a node to the tree_ and pq_
+    std::lock_guard<std::mutex> lock(treeMutex_);
     allNodesSet_.insert(n);
     if (n->getID() == -1)
     {
@@ -148,6 +202,9 @@ void ompl::multirobot::control::KCBS::pushNode(const NodePtr &n)
 ompl::multirobot::control::KCBS::NodePtr ompl::multirobot::control::KCBS::popNode()
 {
     // pop a node and assign it an ID
+    std::lock_guard<std::mutex> lock(treeMutex_);
+    if (pq_.empty())
+        return nullptr;
     NodePtr n = pq_.top();
     if (n->getID() == -1)
     {
@@ -160,7 +217,10 @@ ompl::multirobot::control::KCBS::NodePtr ompl::multirobot::control::KCBS::popNod
 
 std::vector<ompl::multirobot::control::KCBS::Conflict> ompl::multirobot::control::KCBS::findConflicts(const PlanControlPtr &plan) const
 {
-    // cast to desired type and interpolate the paths
+    // interpolate the paths. Every plan comes here before other threads can see it (a new node's plan before the node
+    // is queued, the root and group plans before expansion starts), and the paths it shares with other plans were
+    // interpolated when those plans came here. So only paths owned by this thread are changed, as
+    // PathControl::interpolate() requires, and later calls on shared paths only read them.
     plan->interpolate();
 
     // get the maximum number of steps we need to simulate
@@ -170,6 +230,13 @@ std::vector<ompl::multirobot::control::KCBS::Conflict> ompl::multirobot::control
         if (plan->getPath(r)->getStateCount() > maxSteps)
             maxSteps = plan->getPath(r)->getStateCount();
     }
+    // conflicts after the window are left for later calls (solve() checks that all robots have the same propagation
+    // step size)
+    if (conflictWindow_ > 0.)
+    {
+        const double dt = siC_->getIndividual(0)->getPropagationStepSize();
+        maxSteps = std::min(maxSteps, (unsigned int)std::floor(conflictWindow_ / dt) + 1);
+    }
 
     // initialize an empty vector of conflicts
     std::vector<Conflict> confs;
@@ -210,85 +277,369 @@ std::vector<ompl::multirobot::control::KCBS::Conflict> ompl::multirobot::control
 void ompl::multirobot::control::KCBS::updateConflictCounter(const std::vector<Conflict> &conflicts)
 {
     // update the conflictCounter map with the newly found conflicts
-	for (auto &c: conflicts)
-    	conflictCounter_[std::make_pair(c.robots_[0], c.robots_[1])] += 1;
+    {
+        std::lock_guard<std::mutex> lock(treeMutex_);
+        for (auto &c: conflicts)
+            conflictCounter_[std::make_pair(c.robots_[0], c.robots_[1])] += 1;
+    }
+
+    if (isTuning())
+    {
+        // update the moving averages of the pairs in conflict; the averages of the other pairs decay when read
+        std::lock_guard<std::mutex> lock(tuningMutex_);
+        numEvaluations_ += 1;
+        for (auto &c: conflicts)
+        {
+            auto &trend = conflictTrend_[std::make_pair(c.robots_[0], c.robots_[1])];
+            trend.first = trend.first * std::pow(1. - CONFLICT_TREND_WEIGHT, numEvaluations_ - trend.second) + CONFLICT_TREND_WEIGHT;
+            trend.second = numEvaluations_;
+        }
+    }
 }
 
 std::pair<int, int> ompl::multirobot::control::KCBS::mergeNeeded()
 {
     // iterate through all of the possible merge pairs and check if any pairs have too many conflicts. If so, return the pair. Otherwise, return (-1, -1)
+    std::lock_guard<std::mutex> lock(treeMutex_);
     for (auto itr = conflictCounter_.begin(); itr != conflictCounter_.end(); itr++)
     {
         if (itr->second > mergeBound_)
             return itr->first;
     }
+
+    // when tuning, merge a pair early if it keeps being in conflict
+    if (isTuning() && siC_->getSystemMerger())
+    {
+        std::lock_guard<std::mutex> lock(tuningMutex_);
+        for (const auto &trend: conflictTrend_)
+        {
+            const double average = trend.second.first * std::pow(1. - CONFLICT_TREND_WEIGHT, numEvaluations_ - trend.second.second);
+            if (average >= MERGE_CONFLICT_TREND && conflictCounter_[trend.first] >= MIN_MERGE_CONFLICTS)
+            {
+                OMPL_INFORM("%s: Robots %d and %d are in conflict in most recent nodes. Merging them early.", getName().c_str(), trend.first.first, trend.first.second);
+                return trend.first;
+            }
+        }
+    }
     return std::make_pair(-1, -1);
 }
 
-const ompl::multirobot::control::KCBS::ConstraintPtr ompl::multirobot::control::KCBS::createConstraint(const unsigned int index, std::vector<Conflict> &confs)
+std::pair<int, int> ompl::multirobot::control::KCBS::conflictWindow(const unsigned int robot, const unsigned int other_robot, const std::vector<Conflict> &confs) const
 {
-    // create new constraint for robot that avoids other_robot
-    unsigned int other_index = (index == 0) ? 1 : 0;
-    const ConstraintPtr constraint = std::make_shared<Constraint>(confs.front().robots_[index], siC_->getIndividual(confs.front().robots_[other_index]));
+    int first = std::numeric_limits<int>::max();
+    int last = -1;
     for (auto &c: confs)
     {
-        bool idx_exists = std::find(std::begin(c.robots_), std::end(c.robots_), confs.front().robots_[index]) != std::end(c.robots_);
-        bool other_exists = std::find(std::begin(c.robots_), std::end(c.robots_), confs.front().robots_[other_index]) != std::end(c.robots_);
+        bool idx_exists = std::find(std::begin(c.robots_), std::end(c.robots_), robot) != std::end(c.robots_);
+        bool other_exists = std::find(std::begin(c.robots_), std::end(c.robots_), other_robot) != std::end(c.robots_);
         if (idx_exists && other_exists)
         {
-            constraint->timeSteps_.push_back(c.timeStep_);
-            constraint->constrainingStates_.push_back(c.states_[other_index]);
+            first = std::min(first, (int)c.timeStep_);
+            last = std::max(last, (int)c.timeStep_);
         }
     }
-    return constraint;
+    return std::make_pair(first, last);
 }
 
-void ompl::multirobot::control::KCBS::attemptReplan(const unsigned int robot, NodePtr node, const bool retry)
+bool ompl::multirobot::control::KCBS::replanMustCostMore(const unsigned int robot, const unsigned int other_robot, const std::pair<int, int> &window, const PlanControlPtr &plan) const
 {
-    // collect all of the constraints on robot by traversing constraint tree back to root node
-    auto nCpy = node;
-    std::vector<ConstraintPtr> constraints;
-    while (nCpy->getConstraint())
+    // the start of robot cannot be moved, so a conflict at the first step cannot be avoided at all
+    if (window.first == 0)
+        return true;
+
+    // if robot is at the end of its path at the end of the window and that state is in conflict with the other
+    // robot then, since the constraint forbids that state, robot has to arrive later, unless it can stop at another
+    // state of its goal region
+    const ompl::control::PathControlPtr &path = plan->getPath(robot);
+    const ompl::control::PathControlPtr &other_path = plan->getPath(other_robot);
+    if ((int)path->getStateCount() - 1 > window.second)
+        return false;
+    const ompl::base::State *other_state = other_path->getState(std::min<std::size_t>(window.second, other_path->getStateCount() - 1));
+    return !siC_->getIndividual(robot)->getStateValidityChecker()->areStatesValid(path->getStates().back(),
+            std::make_pair(siC_->getIndividual(other_robot), other_state));
+}
+
+const ompl::multirobot::control::KCBS::Conflict &ompl::multirobot::control::KCBS::selectConflict(const std::vector<Conflict> &confs, const PlanControlPtr &plan)
+{
+    if (!prioritizeConflicts_)
+        return confs.front();
+
+    // the conflicts are ordered by time step, so the first conflict of every pair is its earliest one and ties are
+    // broken in favor of earlier conflicts
+    const Conflict *selected = &confs.front();
+    int selectedType = -1;
+    std::set<std::pair<unsigned int, unsigned int>> classified;
+    for (const auto &c: confs)
     {
-        if (nCpy->getConstraint()->constrainedRobot_ == robot)
-            constraints.push_back(nCpy->getConstraint());
-        nCpy = nCpy->getParent();
+        if (!classified.insert(std::make_pair(c.robots_[0], c.robots_[1])).second)
+            continue;
+        // a conflict is cardinal if resolving it makes both replans more expensive, semi-cardinal if it makes one
+        // of them more expensive, and non-cardinal otherwise
+        const std::pair<int, int> window = conflictWindow(c.robots_[0], c.robots_[1], confs);
+        const int type = (replanMustCostMore(c.robots_[0], c.robots_[1], window, plan) ? 1 : 0) +
+                         (replanMustCostMore(c.robots_[1], c.robots_[0], window, plan) ? 1 : 0);
+        if (type > selectedType)
+        {
+            selected = &c;
+            selectedType = type;
+            if (type == CARDINAL)
+                break;
+        }
     }
+    if (selectedType == CARDINAL)
+        numCardinalConflicts_ += 1;
+    else if (selectedType == SEMI_CARDINAL)
+        numSemiCardinalConflicts_ += 1;
+    return *selected;
+}
+
+const ompl::multirobot::control::KCBS::ConstraintPtr ompl::multirobot::control::KCBS::createConstraint(const unsigned int index, const Conflict &conflict, const std::vector<Conflict> &confs, const PlanControlPtr &plan)
+{
+    // create new constraint for robot that avoids other_robot
+    unsigned int other_index = (index == 0) ? 1 : 0;
+    const unsigned int robot = conflict.robots_[index];
+    const unsigned int other_robot = conflict.robots_[other_index];
+    const std::pair<int, int> window = conflictWindow(robot, other_robot, confs);
+    // the plan was interpolated by findConflicts() before it was shared, so time step k is state k of the trajectory
+    // and no thread changes the states of the path; the constraint shares the states (and keeps the path that owns
+    // them alive) instead of copying them. The list of states is copied, since the path may be shared by other plans
+    // that replace its list.
+    using SharedStates = std::pair<ompl::control::PathControlPtr, std::vector<ompl::base::State *>>;
+    const ompl::control::PathControlPtr &path = plan->getPath(other_robot);
+    auto states = std::make_shared<const SharedStates>(path, path->getStates());
+    ompl::base::StateValidityChecker::Trajectory trajectory(states, &states->second);
+    return std::make_shared<Constraint>(robot, siC_->getIndividual(other_robot), window.first, window.second, trajectory);
+}
 
-    // clear existing low-level planner data and existing dynamic obstacles
-    siC_->getIndividual(robot)->clearDynamicObstacles();
+std::uint_fast32_t ompl::multirobot::control::KCBS::deriveSeed(unsigned int node, unsigned int robot, unsigned int attempt) const
+{
+    std::seed_seq seq{usedSeed_, node, robot, attempt};
+    std::uint_least32_t seed;
+    seq.generate(&seed, &seed + 1);
+    return seed % 1000000000 + 1;
+}
 
-    // add the new dynamic obstacles (the constraints)
-    for (ConstraintPtr &c: constraints)
+ompl::base::PlannerPtr ompl::multirobot::control::KCBS::allocateLowLevelPlanner(const unsigned int robot) const
+{
+    // every replan has its own planner and problem definition, so the same robot can be replanned for several nodes
+    // at once
+    ompl::base::PlannerPtr planner = siC_->allocatePlannerForIndividual(robot);
+    planner->setProblemDefinition(pdef_->getIndividual(robot)->clone());
+    return planner;
+}
+
+ompl::base::PlannerStatus ompl::multirobot::control::KCBS::seededSolve(const unsigned int robot, const unsigned int node, const unsigned int attempt, ompl::base::PlannerPtr &planner)
+{
+    // every RNG the new planner (and its samplers) creates in this thread is seeded from the derived seed
+    RNG::ScopedThreadSeed seed(deriveSeed(node, robot, attempt));
+    planner = allocateLowLevelPlanner(robot);
+    return planner->solve(llSolveTime_);
+}
+
+std::string ompl::multirobot::control::KCBS::getScenarioClass() const
+{
+    if (!scenarioClass_.empty())
+        return scenarioClass_;
+    std::string planner = llSolvers_.empty() || !llSolvers_[0] ? "unknown" : llSolvers_[0]->getName();
+    return std::to_string(siC_->getIndividualCount()) + " robots, " + planner;
+}
+
+double ompl::multirobot::control::KCBS::getRobotSolveTime(const unsigned int robot) const
+{
+    std::lock_guard<std::mutex> lock(tuningMutex_);
+    if (isTuning() && robot < robotSolveTimes_.size())
+        return robotSolveTimes_[robot];
+    return llSolveTime_;
+}
+
+void ompl::multirobot::control::KCBS::startTuning()
+{
+    const std::string scenarioClass = getScenarioClass();
+    std::lock_guard<std::mutex> lock(tuningMutex_);
+    robotSolveTimes_.assign(siC_->getIndividualCount(), llSolveTime_);
+    observedSolveTimes_.assign(siC_->getIndividualCount(), {});
+    conflictTrend_.clear();
+    numEvaluations_ = 0;
+    tunedRacers_ = numRacers_;
+    racerLimit_ = 1;
+
+    auto itr = tunings_.find(scenarioClass);
+    if (itr == tunings_.end())
+        return;
+    if (itr->second.solveTimes_.size() == robotSolveTimes_.size())
     {
-        for (unsigned int k = 0; k < c->timeSteps_.size(); k++)
+        for (std::size_t r = 0; r < robotSolveTimes_.size(); r++)
+            robotSolveTimes_[r] = std::min(std::max(itr->second.solveTimes_[r], MIN_SOLVE_TIME_FACTOR * llSolveTime_), MAX_SOLVE_TIME_FACTOR * llSolveTime_);
+    }
+    tunedRacers_ = itr->second.racers_;
+    OMPL_INFORM("%s: Starting from the settings learned for \"%s\".", getName().c_str(), scenarioClass.c_str());
+}
+
+void ompl::multirobot::control::KCBS::storeTuning()
+{
+    const std::string scenarioClass = getScenarioClass();
+    std::lock_guard<std::mutex> lock(tuningMutex_);
+    Tuning &tuning = tunings_[scenarioClass];
+    tuning.solveTimes_ = robotSolveTimes_;
+    tuning.racers_ = tunedRacers_;
+}
+
+void ompl::multirobot::control::KCBS::recordSolveTime(const unsigned int robot, const double seconds, const bool solved)
+{
+    if (!isTuning())
+        return;
+    std::lock_guard<std::mutex> lock(tuningMutex_);
+    if (robot >= robotSolveTimes_.size())
+        return;
+    double &solveTime = robotSolveTimes_[robot];
+    if (solved)
+    {
+        // low-level solve times are heavy-tailed: a solve time well above most successful ones rarely pays off,
+        // since a failed replan is retried later with the same planner
+        std::vector<double> &observed = observedSolveTimes_[robot];
+        if (observed.size() == SOLVE_TIME_WINDOW)
+            observed.erase(observed.begin());
+        observed.push_back(seconds);
+        if (observed.size() >= MIN_SOLVE_TIME_SAMPLES)
         {
-            ompl::base::State* state =  c->constrainingSiC_->cloneState(c->constrainingStates_[k]);
-            const double time = c->timeSteps_[k] * siC_->getIndividual(robot)->getPropagationStepSize();
-            siC_->getIndividual(robot)->addDynamicObstacle(time, c->constrainingSiC_, state);
+            std::vector<double> sorted(observed);
+            auto percentile = sorted.begin() + (sorted.size() - 1) * 9 / 10;
+            std::nth_element(sorted.begin(), percentile, sorted.end());
+            solveTime = SOLVE_TIME_MARGIN * *percentile;
         }
     }
+    else
+        solveTime *= SOLVE_TIME_GROWTH;
+    solveTime = std::min(std::max(solveTime, MIN_SOLVE_TIME_FACTOR * llSolveTime_), MAX_SOLVE_TIME_FACTOR * llSolveTime_);
+}
+
+void ompl::multirobot::control::KCBS::recordRace(const unsigned int racers, const int winner)
+{
+    if (!isTuning())
+        return;
+    // racing pays off when the usual planner fails or is beaten; it only takes threads away when the usual planner
+    // wins anyway
+    std::lock_guard<std::mutex> lock(tuningMutex_);
+    const unsigned int tuned = tunedRacers_;
+    if (winner == 0)
+    {
+        if (racers > 1 && tuned > 1)
+            tunedRacers_ = tuned - 1;
+    }
+    else if (tuned < racerLimit_)
+        tunedRacers_ = tuned + 1;
+}
+
+ompl::base::PlannerStatus ompl::multirobot::control::KCBS::timedSolve(const unsigned int robot, const ompl::base::PlannerPtr &planner)
+{
+    auto start = std::chrono::steady_clock::now();
+    ompl::base::PlannerStatus solved = planner->solve(getRobotSolveTime(robot));
+    recordSolveTime(robot, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(),
+                    solved == ompl::base::PlannerStatus::EXACT_SOLUTION);
+    recordRace(1, solved == ompl::base::PlannerStatus::EXACT_SOLUTION ? 0 : -1);
+    return solved;
+}
 
-    llSolvers_[robot]->clear();
-    llSolvers_[robot]->getProblemDefinition()->clearSolutionPaths();
+ompl::base::PlannerStatus ompl::multirobot::control::KCBS::raceSolve(const unsigned int robot, ompl::base::PlannerPtr &planner,
+                                                                    const ompl::base::DynamicObstaclesConstPtr &obstacles)
+{
+    const unsigned int numRacers = isTuning() ? std::min(tunedRacers_.load(), racerLimit_.load()) : numRacers_;
+    if (numRacers <= 1)
+        return timedSolve(robot, planner);
 
-    // attempt to find another trajectory
-    // if successful, add the new plan to node prior to exit
-    ompl::base::PlannerStatus solved;
-    if (retry)
-        solved = node->getLowLevelSolver()->solve(llSolveTime_);
+    // the racers get their own problem definitions (with the same start and goal) so that their solutions do not mix
+    std::vector<ompl::base::PlannerPtr> planners{planner};
+    for (unsigned int i = 1; i < numRacers; i++)
+    {
+        ompl::base::PlannerPtr racer;
+        if (racerAllocators_.empty())
+            racer = siC_->allocatePlannerForIndividual(robot);
+        else
+            racer = racerAllocators_[(i - 1) % racerAllocators_.size()](siC_->getIndividual(robot));
+        racer->setProblemDefinition(pdef_->getIndividual(robot)->clone());
+        planners.push_back(racer);
+    }
+
+    // all planners stop as soon as one of them finds an exact solution
+    std::atomic<int> winner{-1};
+    const ompl::base::PlannerTerminationCondition won([&winner] { return winner.load() >= 0; });
+    const double solveTime = getRobotSolveTime(robot);
+    auto start = std::chrono::steady_clock::now();
+    const ompl::base::StateValidityChecker &checker = *siC_->getIndividual(robot)->getStateValidityChecker();
+    auto race = [&planners, &winner, &won, &checker, &obstacles, solveTime](unsigned int i)
+    {
+        // the racers check states against the obstacles of the replan, in their own threads
+        ompl::base::StateValidityChecker::ScopedDynamicObstacles scope(checker, obstacles);
+        auto ptc = ompl::base::plannerOrTerminationCondition(ompl::base::timedPlannerTerminationCondition(solveTime), won);
+        if (planners[i]->solve(ptc) == ompl::base::PlannerStatus::EXACT_SOLUTION)
+        {
+            int none = -1;
+            winner.compare_exchange_strong(none, i);
+        }
+    };
+    std::vector<std::thread> threads;
+    for (unsigned int i = 1; i < planners.size(); i++)
+        threads.emplace_back(race, i);
+    race(0);
+    for (auto &thread: threads)
+        thread.join();
+    recordSolveTime(robot, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(), winner >= 0);
+    recordRace(numRacers, winner);
+
+    if (winner < 0)
+        return ompl::base::PlannerStatus::TIMEOUT;
+    if (winner > 0)
+        numRacesWonByRacers_ += 1;
+    planner = planners[winner];
+    return ompl::base::PlannerStatus::EXACT_SOLUTION;
+}
+
+const ompl::multirobot::control::KCBS::Event *ompl::multirobot::control::KCBS::findReplayEvent(unsigned int node, unsigned int robot, unsigned int attempt) const
+{
+    auto itr = replayEvents_.find(std::make_tuple(node, robot, attempt));
+    if (itr == replayEvents_.end())
+        return nullptr;
+    return &itr->second;
+}
+
+void ompl::multirobot::control::KCBS::recordEvent(Event event)
+{
+    std::lock_guard<std::mutex> lock(eventsMutex_);
+    events_.push_back(std::move(event));
+}
+
+void ompl::multirobot::control::KCBS::attemptReplan(const unsigned int robot, NodePtr node, const bool retry)
+{
+    const unsigned int attempt = node->nextAttempt();
+
+    // when replaying, take the outcome of the low-level solve from the log
+    const Event *replayed = nullptr;
+    if (isReplaying())
+    {
+        replayed = findReplayEvent(node->getIndex(), robot, attempt);
+        if (!replayed)
+            OMPL_WARN("%s: Replan of robot %u for node %u (attempt %u) is not in the event log. Solving it instead.",
+                      getName().c_str(), robot, node->getIndex(), attempt);
+    }
+
+    ompl::control::PathControlPtr new_path = nullptr;
+    ompl::base::PlannerPtr planner = nullptr;
+    if (replayed)
+    {
+        if (replayed->path_)
+            new_path = std::make_shared<ompl::control::PathControl>(*replayed->path_);
+    }
     else
-        solved = llSolvers_[robot]->solve(llSolveTime_);
-    
-    if (solved == ompl::base::PlannerStatus::EXACT_SOLUTION)
+        new_path = lowLevelReplan(robot, node, attempt, retry, planner);
+
+    // the node's plan owns (and later interpolates) new_path, so the log keeps a copy
+    if (deterministic_)
+        recordEvent({node->getIndex(), node->getParent()->getIndex(), robot, attempt, {node->getConstraint()->firstStep_, node->getConstraint()->lastStep_},
+                     new_path ? std::make_shared<ompl::control::PathControl>(*new_path) : nullptr});
+
+    if (new_path)
     {
         PlanControlPtr new_plan = std::make_shared<PlanControl>(si_);
-        ompl::control::PathControlPtr new_path = nullptr;
-        if (retry)
-            new_path = std::make_shared<ompl::control::PathControl>(*node->getLowLevelSolver()->getProblemDefinition()->getSolutionPath()->as<ompl::control::PathControl>());
-        else
-            new_path = std::make_shared<ompl::control::PathControl>(*llSolvers_[robot]->getProblemDefinition()->getSolutionPath()->as<ompl::control::PathControl>());
-        
         for (unsigned int r = 0; r < siC_->getIndividualCount(); r++)
         {
             if (r == robot)
@@ -304,16 +655,54 @@ void ompl::multirobot::control::KCBS::attemptReplan(const unsigned int robot, No
     else
     {
         numApproxSolutions_ += 1;
-        // save the planner prior to exit only if planner not already saved
-        if (!retry)
-        {
-            // need to save the existing low-level solver to the node and create a new one for the rest of the system
-            node->setLowLevelSolver(llSolvers_[robot]);
-            llSolvers_[robot] = siC_->allocatePlannerForIndividual(robot);
-            llSolvers_[robot]->setProblemDefinition(pdef_->getIndividual(robot));
-        }
+        // save the planner to the node so that a retry continues its search
+        if (planner)
+            node->setLowLevelSolver(planner);
     }
-    pushNode(node);
+}
+
+ompl::control::PathControlPtr ompl::multirobot::control::KCBS::lowLevelReplan(const unsigned int robot, const NodePtr &node, const unsigned int attempt, const bool retry, ompl::base::PlannerPtr &planner)
+{
+    // collect all of the constraints on robot by traversing constraint tree back to root node
+    auto nCpy = node;
+    std::vector<ConstraintPtr> constraints;
+    while (nCpy->getConstraint())
+    {
+        if (nCpy->getConstraint()->constrainedRobot_ == robot)
+            constraints.push_back(nCpy->getConstraint());
+        nCpy = nCpy->getParent();
+    }
+
+    // the constraints become the dynamic obstacles of this replan only; they refer to the trajectories of the
+    // constraining robots, so the set is cheap to build and other nodes can replan for robot at the same time
+    auto obstacles = std::make_shared<ompl::base::DynamicObstacles>();
+    const double dt = siC_->getIndividual(robot)->getPropagationStepSize();
+    for (ConstraintPtr &c: constraints)
+        obstacles->add(dt, c->firstStep_, c->lastStep_, c->constrainingSiC_, c->constrainingTrajectory_);
+    ompl::base::StateValidityChecker::ScopedDynamicObstacles scope(*siC_->getIndividual(robot)->getStateValidityChecker(), obstacles);
+
+    // attempt to find another trajectory
+    // a retry continues with the planner saved in the node; in deterministic mode a new planner is seeded for every
+    // first attempt (and for retries of replayed nodes, which have no saved planner)
+    // otherwise, a new planner may race against other planners (see setNumRacers())
+    ompl::base::PlannerStatus solved;
+    if (retry && node->getLowLevelSolver())
+    {
+        planner = node->getLowLevelSolver();
+        planner->getProblemDefinition()->clearSolutionPaths();
+        solved = deterministic_ ? planner->solve(llSolveTime_) : raceSolve(robot, planner, obstacles);
+    }
+    else if (deterministic_)
+        solved = seededSolve(robot, node->getIndex(), attempt, planner);
+    else
+    {
+        planner = allocateLowLevelPlanner(robot);
+        solved = raceSolve(robot, planner, obstacles);
+    }
+
+    if (solved == ompl::base::PlannerStatus::EXACT_SOLUTION)
+        return std::make_shared<ompl::control::PathControl>(*planner->getProblemDefinition()->getSolutionPath()->as<ompl::control::PathControl>());
+    return nullptr;
 }
 
 void ompl::multirobot::control::KCBS::parallelRootSolutionHelper(PlanControlPtr plan, unsigned int startIdx, unsigned int endIdx, const ompl::base::PlannerTerminationCondition &ptc)
@@ -321,12 +710,49 @@ void ompl::multirobot::control::KCBS::parallelRootSolutionHelper(PlanControlPtr
     for (unsigned int i = startIdx; i < endIdx; i++)
     {
         while (!llSolvers_[i]->getProblemDefinition()->hasExactSolution() && !ptc)
-            llSolvers_[i]->solve(llSolveTime_);
+            timedSolve(i, llSolvers_[i]);
         auto path = std::make_shared<ompl::control::PathControl>(*llSolvers_[i]->getProblemDefinition()->getSolutionPath()->as<ompl::control::PathControl>());
         plan->replace(i, path);
     }
 }
 
+bool ompl::multirobot::control::KCBS::sequentialRootSolution(PlanControlPtr plan, const ompl::base::PlannerTerminationCondition &ptc)
+{
+    for (unsigned int r = 0; r < siC_->getIndividualCount(); r++)
+    {
+        ompl::control::PathControlPtr path = nullptr;
+        const Event *replayed = isReplaying() ? findReplayEvent(0, r, 0) : nullptr;
+        if (replayed)
+        {
+            if (replayed->path_)
+                path = std::make_shared<ompl::control::PathControl>(*replayed->path_);
+        }
+        else
+        {
+            if (isReplaying())
+                OMPL_WARN("%s: Root solution of robot %u is not in the event log. Solving it instead.", getName().c_str(), r);
+            // the planner and its samplers are created and run under the seed of the root node
+            RNG::ScopedThreadSeed seed(deriveSeed(0, r, 0));
+            llSolvers_[r] = siC_->allocatePlannerForIndividual(r);
+            llSolvers_[r]->setProblemDefinition(pdef_->getIndividual(r));
+            llSolvers_[r]->getProblemDefinition()->clearSolutionPaths();
+            while (!llSolvers_[r]->getProblemDefinition()->hasExactSolution() && !ptc)
+                llSolvers_[r]->solve(llSolveTime_);
+            if (llSolvers_[r]->getProblemDefinition()->hasExactSolution())
+                path = std::make_shared<ompl::control::PathControl>(*llSolvers_[r]->getProblemDefinition()->getSolutionPath()->as<ompl::control::PathControl>());
+        }
+        if (!path)
+        {
+            recordEvent({0, 0, r, 0, {}, nullptr});
+            return false;
+        }
+        // the plan owns (and later interpolates) path, so the log keeps a copy
+        recordEvent({0, 0, r, 0, {}, std::make_shared<ompl::control::PathControl>(*path)});
+        plan->replace(r, path);
+    }
+    return true;
+}
+
 std::vector<unsigned int> ompl::multirobot::control::KCBS::split(const unsigned int jobs, const unsigned int workers)
 {
     std::vector<unsigned int> num_jobs_per_workers;
@@ -369,12 +795,16 @@ void ompl::multirobot::control::KCBS::parallelRootSolution(PlanControlPtr plan,
     OMPL_INFORM("%s: Assigned %d workers to plan paths for %d robots.", getName().c_str(), num_workers, siC_->getIndividualCount());
 
     // Create a thread for each segment.
+    const ompl::tools::ThreadPlacement::Reservation placement(num_workers);
     unsigned int start = 0;
     unsigned int end = jobs_for_worker[0];
     for (unsigned int i = 0; i < num_workers; i++)
     {
-        threads.push_back(std::thread(&ompl::multirobot::control::KCBS::parallelRootSolutionHelper, 
-            this, plan, start, end, ptc));
+        threads.push_back(std::thread([this, plan, start, end, &ptc, i, &placement]
+            {
+                placement.pinWorker(i);
+                parallelRootSolutionHelper(plan, start, end, ptc);
+            }));
 
         // update start and end 
         start = end;
@@ -386,38 +816,37 @@ void ompl::multirobot::control::KCBS::parallelRootSolution(PlanControlPtr plan,
         thread.join();
 }
 
-void ompl::multirobot::control::KCBS::parallelNodeExpansion(NodePtr& solution, std::vector<unsigned int>& resevered, std::pair<int, int>& merge_indices)
+void ompl::multirobot::control::KCBS::parallelNodeExpansion(NodePtr& solution, std::pair<int, int>& merge_indices)
 {
-    if (solution) // another thread beat this one to a solution
-        return;
-    
-    // get the best unexplored node in the constraint tree
+    {
+        std::lock_guard<std::mutex> lock(treeMutex_);
+        if (solution) // another thread beat this one to a solution
+            return;
+    }
+
+    // get the best unexplored node in the constraint tree (other threads may have emptied the queue)
     NodePtr currentNode = popNode();
+    if (!currentNode)
+        return;
     OMPL_INFORM("%s: selected node with cost %d.", getName().c_str(), currentNode->getCost());
 
-    // if current node has not plan, then attempt to find one again
+    // if current node has not plan, then attempt to find one again with the existing tree
     if (currentNode->getCost() == std::numeric_limits<int>::max())
     {
-        // check it constrained robot is already reserved by someone else
-        auto reserved_itr = std::find(resevered.begin(), resevered.end(), currentNode->getConstraint()->constrainedRobot_);
-        if (reserved_itr == resevered.end()) // not reserved, proceed to plan for it
-        {
-            // use existing tree to attempt a replan
-            // reserve robot
-            resevered.push_back(currentNode->getConstraint()->constrainedRobot_);
-            // attempt replan    
-            attemptReplan(currentNode->getConstraint()->constrainedRobot_, currentNode, true);
-        }
-        else // already reserved, just push to queue for later use
-            pushNode(currentNode);
+        attemptReplan(currentNode->getConstraint()->constrainedRobot_, currentNode, true);
+        pushNode(currentNode);
+        return;
     }
-    else
+
+    // expand the node in place for as long as a child can be adopted (see setBypass())
+    while (true)
     {
         // find conflicts in the current plan
         std::vector<Conflict> confs = currentNode->getConflicts();
 
         // if no conflicts were found, return as solution
         if (confs.empty()) {
+            std::lock_guard<std::mutex> lock(treeMutex_);
             solution = currentNode;
             return;
         }
@@ -430,9 +859,13 @@ void ompl::multirobot::control::KCBS::parallelNodeExpansion(NodePtr& solution, s
 
         // FIXME: need to keep the merge logic somehow
         // if merge is needed, then merge and restart
-        merge_indices = mergeNeeded();
-        if (merge_indices != std::make_pair(-1, -1))
-        	return;
+        std::pair<int, int> merge = mergeNeeded();
+        if (merge != std::make_pair(-1, -1))
+        {
+            std::lock_guard<std::mutex> lock(treeMutex_);
+            merge_indices = merge;
+            return;
+        }
 
         // create a constraint for every agent in confs
         // for example, if conflicts occur between robots 0 and 2 for the interval dt=[615, 665] then
@@ -440,41 +873,229 @@ void ompl::multirobot::control::KCBS::parallelNodeExpansion(NodePtr& solution, s
         // constraint2 is given to robot 2 which forces it to avoid the states of robot 0 for all steps inside dt=[615, 665]
         // then, replan for robots 0 and 2 after adding the constraints as dynamic obstacles
 
+        // branch on the most constraining conflict (see setPrioritizeConflicts())
+        const Conflict &conflict = selectConflict(confs, currentNode->getPlan());
         std::vector<ConstraintPtr> new_constraints;
         for (unsigned int r = 0; r < 2; r++)
-        {
-            // create a new constraint
-            ConstraintPtr new_constraint = createConstraint(r, confs);
-            new_constraints.push_back(new_constraint);
-            // check it constrained robot is already reserved by someone else
-            auto reserved_itr = std::find(resevered.begin(), resevered.end(), new_constraint->constrainedRobot_);
-            if (reserved_itr != resevered.end()) // reserved and cannot expand from this node
-            {
-                // push currentNode back into the queue and end function call
-                pushNode(currentNode);
-                return;
-            }
-        }
+            new_constraints.push_back(createConstraint(r, conflict, confs, currentNode->getPlan()));
 
-        // good news! -- we can expand from this node
+        std::vector<NodePtr> children;
         std::vector<std::thread> threads;
         for (unsigned int r = 0; r < 2; r++)
         {
             // create a new node to house the new constraint, also assign a parent
             NodePtr nxtNode = std::make_shared<Node>();
+            assignIndex(nxtNode);
             nxtNode->setParent(currentNode);
             nxtNode->setConstraint(new_constraints[r]);
-            // reserve robot
-            resevered.push_back(new_constraints[r]->constrainedRobot_);
-            // attempt to replan and push node to priority queue
-            threads.push_back(std::thread(&ompl::multirobot::control::KCBS::attemptReplan, 
-                this, new_constraints[r]->constrainedRobot_, nxtNode, false)); 
+            children.push_back(nxtNode);
+            // attempt to replan
+            if (deterministic_)
+                attemptReplan(new_constraints[r]->constrainedRobot_, nxtNode, false);
+            else
+                threads.push_back(std::thread(&ompl::multirobot::control::KCBS::attemptReplan, 
+                    this, new_constraints[r]->constrainedRobot_, nxtNode, false)); 
         }
         // Join all of the threads.
         for (auto& thread : threads) {
             thread.join();
         }
+
+        // adopt the plan of a child that has fewer conflicts at no extra cost instead of branching
+        const NodePtr bypass = findBypass(currentNode, children);
+        if (!bypass)
+        {
+            for (auto &child: children)
+                pushNode(child);
+            return;
+        }
+        numBypasses_ += 1;
+        OMPL_DEBUG("%s: Adopted the plan of robot %u into node %u (%u instead of %u conflicts).", getName().c_str(),
+                   bypass->getConstraint()->constrainedRobot_, currentNode->getIndex(),
+                   (unsigned int)bypass->getConflicts().size(), (unsigned int)confs.size());
+        currentNode->setPlan(bypass->getPlan());
+        currentNode->setConflicts(bypass->getConflicts());
+        currentNode->setCost(bypass->getCost());
+    }
+}
+
+std::vector<std::vector<unsigned int>> ompl::multirobot::control::KCBS::joinGroups(const std::vector<std::vector<unsigned int>> &groups, const std::vector<Conflict> &confs) const
+{
+    // every robot points towards the representative of its group
+    std::vector<unsigned int> parents(siC_->getIndividualCount());
+    for (const auto &group: groups)
+        for (unsigned int r: group)
+            parents[r] = group.front();
+    auto find = [&parents](unsigned int r)
+    {
+        while (parents[r] != r)
+        {
+            parents[r] = parents[parents[r]];
+            r = parents[r];
+        }
+        return r;
+    };
+    for (const auto &c: confs)
+    {
+        const unsigned int a = find(c.robots_[0]);
+        const unsigned int b = find(c.robots_[1]);
+        if (a != b)
+            parents[std::max(a, b)] = std::min(a, b);
+    }
+
+    // robots are visited in order, so the groups are sorted and ordered by their first robot
+    std::vector<std::vector<unsigned int>> joined;
+    std::map<unsigned int, std::size_t> indices;
+    for (unsigned int r = 0; r < siC_->getIndividualCount(); r++)
+    {
+        auto itr = indices.insert({find(r), joined.size()});
+        if (itr.second)
+            joined.emplace_back();
+        joined[itr.first->second].push_back(r);
     }
+    return joined;
+}
+
+void ompl::multirobot::control::KCBS::configureSubPlanner(KCBS &planner) const
+{
+    planner.setLowLevelSolveTime(llSolveTime_);
+    planner.setNumThreads(numThreads_);
+    planner.setMergeBound(mergeBound_);
+    planner.setNumRacers(numRacers_);
+    planner.setRacerAllocators(racerAllocators_);
+    planner.setDeterministic(deterministic_);
+    planner.setSeed(usedSeed_);
+    planner.setAutoTune(autoTune_);
+    planner.setPrioritizeConflicts(prioritizeConflicts_);
+    planner.setBypass(bypass_);
+    planner.setBypassTolerance(bypassTolerance_);
+    planner.setConflictWindow(conflictWindow_);
+}
+
+ompl::multirobot::control::KCBSPtr ompl::multirobot::control::KCBS::allocateGroupPlanner(const std::vector<unsigned int> &group, const unsigned int numThreads) const
+{
+    // the sub-problem shares the individuals (and the root paths found for them) with this problem
+    auto groupSi = std::make_shared<SpaceInformation>();
+    auto groupPdef = std::make_shared<ompl::multirobot::base::ProblemDefinition>(groupSi);
+    for (unsigned int r: group)
+    {
+        groupSi->addIndividual(siC_->getIndividual(r));
+        groupPdef->addIndividual(pdef_->getIndividual(r));
+    }
+    groupSi->setPlannerAllocator(siC_->getPlannerAllocator());
+    groupSi->lock();
+    groupPdef->lock();
+
+    auto planner = std::make_shared<KCBS>(groupSi);
+    configureSubPlanner(*planner);
+    // the group has no SystemMerger: at the merge bound, it stops and its robots are planned for with all others
+    planner->groupPlanner_ = true;
+    planner->setNumThreads(numThreads);
+    planner->setProblemDefinition(groupPdef);
+    return planner;
+}
+
+ompl::multirobot::control::PlanControlPtr ompl::multirobot::control::KCBS::solveIndependentGroups(const PlanControlPtr &rootPlan, const std::vector<Conflict> &confs, const ompl::base::PlannerTerminationCondition &ptc)
+{
+    std::vector<std::vector<unsigned int>> groups;
+    for (unsigned int r = 0; r < siC_->getIndividualCount(); r++)
+        groups.push_back({r});
+    groups = joinGroups(groups, confs);
+
+    // the paths of the robots: single robots keep their root path, groups get the path of their solution
+    std::vector<ompl::control::PathControlPtr> paths;
+    for (unsigned int r = 0; r < siC_->getIndividualCount(); r++)
+        paths.push_back(rootPlan->getPath(r));
+    std::vector<std::vector<unsigned int>> solvedGroups;
+    for (const auto &group: groups)
+        if (group.size() == 1)
+            solvedGroups.push_back(group);
+
+    while (groups.size() > 1 && !ptc)
+    {
+        std::vector<std::vector<unsigned int>> unsolved;
+        for (const auto &group: groups)
+            if (std::find(solvedGroups.begin(), solvedGroups.end(), group) == solvedGroups.end())
+                unsolved.push_back(group);
+        OMPL_INFORM("%s: Planning for %u independent groups of robots (%u to solve).", getName().c_str(),
+                    (unsigned int)groups.size(), (unsigned int)unsolved.size());
+
+        // solve the groups in parallel, each on its share of the threads; a sub-problem needs at least two
+        // threads, since nodes are expanded by half of them, so at most half as many groups as threads are solved
+        // at a time
+        const unsigned int concurrent = std::min<unsigned int>(std::max(1u, numThreads_ / 2), unsolved.size());
+        const unsigned int numThreads = std::max(2u, numThreads_ / concurrent);
+        std::vector<KCBSPtr> planners;
+        for (const auto &group: unsolved)
+            planners.push_back(allocateGroupPlanner(group, numThreads));
+        std::vector<char> solved(unsolved.size(), false);
+        std::atomic<std::size_t> next{0};
+        std::vector<std::thread> threads;
+        for (unsigned int t = 0; t < concurrent; t++)
+            threads.push_back(std::thread([&planners, &solved, &ptc, &next]
+                {
+                    for (std::size_t g = next++; g < planners.size() && !ptc; g = next++)
+                        solved[g] = planners[g]->solve(ptc) == ompl::base::PlannerStatus::EXACT_SOLUTION;
+                }));
+        for (auto& thread : threads)
+            thread.join();
+
+        for (std::size_t g = 0; g < unsolved.size(); g++)
+        {
+            numNodesExpanded_ += planners[g]->getNumberOfNodesExpanded();
+            numApproxSolutions_ += planners[g]->getNumberOfApproximateSolutions();
+            groupPlanners_.push_back(planners[g]);
+            if (!solved[g])
+            {
+                OMPL_INFORM("%s: A group of %u robots was not solved. Planning for all robots together.",
+                            getName().c_str(), (unsigned int)unsolved[g].size());
+                return nullptr;
+            }
+            auto *groupPlan = planners[g]->getProblemDefinition()->getSolutionPlan()->as<PlanControl>();
+            for (unsigned int i = 0; i < unsolved[g].size(); i++)
+                paths[unsolved[g][i]] = groupPlan->getPath(i);
+            solvedGroups.push_back(unsolved[g]);
+        }
+
+        // the groups are independent if their plans are not in conflict; otherwise, the groups in conflict are
+        // joined and solved again
+        PlanControlPtr plan = std::make_shared<PlanControl>(si_);
+        for (auto &path: paths)
+            plan->append(path);
+        std::vector<Conflict> planConfs = findConflicts(plan);
+        if (planConfs.empty())
+        {
+            numGroups_ = groups.size();
+            return plan;
+        }
+        groups = joinGroups(groups, planConfs);
+    }
+    if (groups.size() == 1)
+        OMPL_INFORM("%s: All robots interact. Planning for all robots together.", getName().c_str());
+    return nullptr;
+}
+
+ompl::multirobot::control::KCBS::NodePtr ompl::multirobot::control::KCBS::findBypass(const NodePtr &node, const std::vector<NodePtr> &children) const
+{
+    if (!bypass_)
+        return nullptr;
+    NodePtr best = nullptr;
+    for (const auto &child: children)
+    {
+        if (child->getCost() == std::numeric_limits<int>::max())
+            continue;
+        // the replanned path must not take longer than the path it replaces (up to the tolerance set with
+        // setBypassTolerance()), and the plan must have strictly fewer conflicts
+        const unsigned int robot = child->getConstraint()->constrainedRobot_;
+        const double duration = child->getPlan()->getPath(robot)->length();
+        const double previous = node->getPlan()->getPath(robot)->length();
+        if (duration > (1. + bypassTolerance_) * previous)
+            continue;
+        const std::size_t conflicts = child->getConflicts().size();
+        if (conflicts < node->getConflicts().size() && (!best || conflicts < best->getConflicts().size()))
+            best = child;
+    }
+    return best;
 }
 
 int ompl::multirobot::control::KCBS::evaluateCost(const std::vector<Conflict> confs)
@@ -507,8 +1128,29 @@ ompl::base::PlannerStatus ompl::multirobot::control::KCBS::solve(const ompl::bas
     checkValidity();
 
     OMPL_INFORM("%s: Merge Bound set to %d", getName().c_str(), mergeBound_);
+    if (conflictWindow_ > 0.)
+    {
+        // the window is converted to steps with the step size of robot 0 (see findConflicts())
+        const double dt = siC_->getIndividual(0)->getPropagationStepSize();
+        for (unsigned int r = 1; r < siC_->getIndividualCount(); r++)
+            if (siC_->getIndividual(r)->getPropagationStepSize() != dt)
+                throw Exception(getName().c_str(), "A conflict window requires all robots to have the same propagation step size");
+        OMPL_INFORM("%s: Resolving conflicts in the first %g seconds of the plan.", getName().c_str(), conflictWindow_);
+    }
     OMPL_INFORM("%s: Starting planning. ", getName().c_str());
 
+    nextNodeIndex_ = 0;
+    numGroups_ = 1;
+    if (deterministic_)
+    {
+        usedSeed_ = seed_ != 0 ? seed_ : RNG::getSeed();
+        std::lock_guard<std::mutex> lock(eventsMutex_);
+        events_.clear();
+        OMPL_INFORM("%s: Running deterministically with seed %u%s.", getName().c_str(), usedSeed_, isReplaying() ? " (replaying event log)" : "");
+    }
+    if (isTuning())
+        startTuning();
+
     // start the timer for root solution
     auto start = std::chrono::high_resolution_clock::now();
     // initialize the initial plan and fill it with the required size
@@ -520,7 +1162,16 @@ ompl::base::PlannerStatus ompl::multirobot::control::KCBS::solve(const ompl::bas
     }
 
     // get the initial solution
-    parallelRootSolution(initalPlan, ptc);
+    if (deterministic_)
+    {
+        if (!sequentialRootSolution(initalPlan, ptc))
+        {
+            OMPL_INFORM("%s: No root solution found.", getName().c_str());
+            return {false, false};
+        }
+    }
+    else
+        parallelRootSolution(initalPlan, ptc);
     
     auto end = std::chrono::high_resolution_clock::now();
     auto duration_ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
@@ -533,6 +1184,7 @@ ompl::base::PlannerStatus ompl::multirobot::control::KCBS::solve(const ompl::bas
 
     // create root node
     NodePtr root = std::make_shared<Node>(initalPlan);
+    assignIndex(root);
     std::vector<Conflict> confs = findConflicts(root->getPlan());
     if (confs.empty())
         solution = root;  // found a solution in root node
@@ -542,9 +1194,20 @@ ompl::base::PlannerStatus ompl::multirobot::control::KCBS::solve(const ompl::bas
         root->setConflicts(confs);
         root->setCost(evaluateCost(confs)); // cost for root node is technically undefined
         pushNode(root);
-    }
 
-    std::vector<unsigned int> resevered;
+        // plan for groups of robots that do not interact separately, if possible
+        if (independenceDetection_ && !deterministic_)
+        {
+            PlanControlPtr plan = solveIndependentGroups(root->getPlan(), confs, ptc);
+            if (plan)
+            {
+                solution = std::make_shared<Node>(plan);
+                assignIndex(solution);
+                solution->setParent(root);
+                solution->setCost(0);
+            }
+        }
+    }
 
     while (!ptc && !pq_.empty() && !solution)
     {
@@ -552,22 +1215,26 @@ ompl::base::PlannerStatus ompl::multirobot::control::KCBS::solve(const ompl::bas
         const unsigned int numNodesInQueue = pq_.size();
         const unsigned int test = std::floor(numThreads_ / 2);
         const unsigned int numNodesSelect = std::min(numNodesInQueue, test);
+        // when tuning, the threads that do not expand nodes race low-level planners in the replans (two per node)
+        if (isTuning())
+            racerLimit_ = std::max(1u, numThreads_ / std::max(1u, 2 * numNodesSelect));
         std::vector<std::thread> threads;
-        for (unsigned int i = 0; i < numNodesSelect; i++)
-        {
-            threads.push_back(std::thread(&ompl::multirobot::control::KCBS::parallelNodeExpansion, this, std::ref(solution), std::ref(resevered), std::ref(merge_indices)));
-            std::this_thread::sleep_for(std::chrono::milliseconds(100)); // wait 0.1 seconds s.t. reserved is updated properly
-        }
+        if (deterministic_)
+            parallelNodeExpansion(solution, merge_indices);
+        for (unsigned int i = 0; i < numNodesSelect && !deterministic_; i++)
+            threads.push_back(std::thread(&ompl::multirobot::control::KCBS::parallelNodeExpansion, this, std::ref(solution), std::ref(merge_indices)));
         // Join all of the threads.
         for (auto& thread : threads) {
             thread.join();
         }
-        resevered.clear();
         if (solution)
             break;
         if (merge_indices != std::make_pair(-1, -1))
         {
-        	if (!siC_->getSystemMerger())
+            if (groupPlanner_)
+                OMPL_INFORM("%s: Merge bound reached in a group of robots. The robots are planned for together.",
+                            getName().c_str());
+            else if (!siC_->getSystemMerger())
                 OMPL_ERROR("%s: Merge was triggered but no SystemMerger was provided. Unable to continue planning. Please fix your system merger.", getName().c_str());
             else
             {
@@ -576,15 +1243,14 @@ ompl::base::PlannerStatus ompl::multirobot::control::KCBS::solve(const ompl::bas
                 if (new_defs.first && new_defs.second)
                 {
                     mergedPlanner_ = std::make_shared<KCBS>(new_defs.first);
-                    mergedPlanner_->setLowLevelSolveTime(llSolveTime_);
-        			mergedPlanner_->setNumThreads(numThreads_);
-        			mergedPlanner_->setMergeBound(mergeBound_); 
+                    configureSubPlanner(*mergedPlanner_);
                     mergedPlanner_->setProblemDefinition(new_defs.second);
                     bool merge_solved = mergedPlanner_->solve(ptc);
                     // create a new node to house the new constraint, also assign a parent
                     if (merge_solved)
                     {
                         solution = std::make_shared<Node>();
+                        assignIndex(solution);
                         PlanControlPtr sol_plan = std::make_shared<PlanControl>(si_);
                         for (unsigned int i = 0; i < new_defs.first->getIndividualCount(); i++)
                         sol_plan->append(new_defs.second->getSolutionPlan()->as<PlanControl>()->getPath(i));
@@ -597,6 +1263,8 @@ ompl::base::PlannerStatus ompl::multirobot::control::KCBS::solve(const ompl::bas
             break;
         }
     }
+    if (isTuning())
+        storeTuning();
     if (solution == nullptr) 
     {
         OMPL_INFORM("%s: No solution found.", getName().c_str());
@@ -621,7 +1289,266 @@ ompl::base::PlannerStatus ompl::multirobot::control::KCBS::solve(const ompl::bas
     }
 }
 
+void ompl::multirobot::control::KCBS::writeEventLog(std::ostream &out) const
+{
+    std::lock_guard<std::mutex> lock(eventsMutex_);
+    const auto precision = out.precision(std::numeric_limits<double>::max_digits10);
+    out << "KCBS-EVENT-LOG 1\n";
+    out << "seed " << usedSeed_ << "\n";
+    out << "events " << events_.size() << "\n";
+    std::vector<double> reals;
+    for (const auto &e: events_)
+    {
+        out << "event " << e.node_ << " " << e.parent_ << " " << e.robot_ << " " << e.attempt_ << "\n";
+        out << "constraint " << e.timeSteps_.size();
+        for (int t: e.timeSteps_)
+            out << " " << t;
+        out << "\n";
+        if (!e.path_)
+        {
+            out << "path none\n";
+            continue;
+        }
+        const ompl::control::SpaceInformationPtr &si = siC_->getIndividual(e.robot_);
+        const ompl::control::ControlSpacePtr &cspace = si->getControlSpace();
+        reals.clear();
+        if (e.path_->getStateCount() > 0)
+            si->getStateSpace()->copyToReals(reals, e.path_->getState(0));
+        out << "path " << e.path_->getStateCount() << " " << e.path_->getControlCount() << " " << reals.size() << "\n";
+        for (auto *state: e.path_->getStates())
+        {
+            si->getStateSpace()->copyToReals(reals, state);
+            for (std::size_t i = 0; i < reals.size(); i++)
+                out << (i > 0 ? " " : "") << reals[i];
+            out << "\n";
+        }
+        for (std::size_t c = 0; c < e.path_->getControlCount(); c++)
+        {
+            for (unsigned int i = 0; i < cspace->getDimension(); i++)
+            {
+                double *value = cspace->getValueAddressAtIndex(e.path_->getControl(c), i);
+                if (value == nullptr)
+                    throw Exception(getName().c_str(), "Unable to write the event log: the control space does not expose its values");
+                out << *value << " ";
+            }
+            out << e.path_->getControlDuration(c) << "\n";
+        }
+    }
+    out.precision(precision);
+}
+
+void ompl::multirobot::control::KCBS::readEventLog(std::istream &in)
+{
+    auto expect = [this, &in](const std::string &keyword)
+    {
+        std::string word;
+        if (!(in >> word) || word != keyword)
+            throw Exception(getName().c_str(), ("Malformed event log: expected '" + keyword + "'").c_str());
+    };
+
+    unsigned int version = 0;
+    expect("KCBS-EVENT-LOG");
+    if (!(in >> version) || version != 1)
+        throw Exception(getName().c_str(), "Unsupported event log version");
+    expect("seed");
+    unsigned int seed = 0;
+    std::size_t count = 0;
+    in >> seed;
+    expect("events");
+    in >> count;
+
+    std::map<std::tuple<unsigned int, unsigned int, unsigned int>, Event> events;
+    for (std::size_t k = 0; k < count && in; k++)
+    {
+        Event e;
+        std::size_t numSteps = 0;
+        expect("event");
+        in >> e.node_ >> e.parent_ >> e.robot_ >> e.attempt_;
+        expect("constraint");
+        in >> numSteps;
+        e.timeSteps_.resize(numSteps);
+        for (auto &t: e.timeSteps_)
+            in >> t;
+        if (!in || e.robot_ >= siC_->getIndividualCount())
+            throw Exception(getName().c_str(), "Malformed event log: bad event");
+
+        expect("path");
+        std::string word;
+        in >> word;
+        if (word != "none")
+        {
+            std::size_t numStates = 0, numControls = 0, numReals = 0;
+            std::istringstream(word) >> numStates;
+            in >> numControls >> numReals;
+            const ompl::control::SpaceInformationPtr &si = siC_->getIndividual(e.robot_);
+            const ompl::control::ControlSpacePtr &cspace = si->getControlSpace();
+            e.path_ = std::make_shared<ompl::control::PathControl>(si);
+            std::vector<double> reals(numReals);
+            for (std::size_t i = 0; i < numStates; i++)
+            {
+                for (auto &v: reals)
+                    in >> v;
+                ompl::base::State *state = si->allocState();
+                si->getStateSpace()->copyFromReals(state, reals);
+                e.path_->getStates().push_back(state);
+            }
+            for (std::size_t c = 0; c < numControls; c++)
+            {
+                ompl::control::Control *control = si->allocControl();
+                e.path_->getControls().push_back(control);
+                for (unsigned int i = 0; i < cspace->getDimension(); i++)
+                {
+                    double *value = cspace->getValueAddressAtIndex(control, i);
+                    if (value == nullptr)
+                        throw Exception(getName().c_str(), "Unable to read the event log: the control space does not expose its values");
+                    in >> *value;
+                }
+                double duration = 0.;
+                in >> duration;
+                e.path_->getControlDurations().push_back(duration);
+            }
+            if (!in)
+                throw Exception(getName().c_str(), "Malformed event log: bad path");
+        }
+        auto key = std::make_tuple(e.node_, e.robot_, e.attempt_);
+        events[key] = std::move(e);
+    }
+    if (!in)
+        throw Exception(getName().c_str(), "Malformed event log");
+
+    replayEvents_ = std::move(events);
+    seed_ = seed;
+    deterministic_ = true;
+    OMPL_INFORM("%s: Read %zu events to replay.", getName().c_str(), replayEvents_.size());
+}
+
+void ompl::multirobot::control::KCBS::writeTuning(std::ostream &out) const
+{
+    std::lock_guard<std::mutex> lock(tuningMutex_);
+    const auto precision = out.precision(std::numeric_limits<double>::max_digits10);
+    out << "KCBS-TUNING 1\n";
+    out << "classes " << tunings_.size() << "\n";
+    for (const auto &tuning: tunings_)
+    {
+        out << "class " << std::quoted(tuning.first) << "\n";
+        out << "racers " << tuning.second.racers_ << "\n";
+        out << "solve_times " << tuning.second.solveTimes_.size();
+        for (double t: tuning.second.solveTimes_)
+            out << " " << t;
+        out << "\n";
+    }
+    out.precision(precision);
+}
+
+void ompl::multirobot::control::KCBS::readTuning(std::istream &in)
+{
+    auto expect = [this, &in](const std::string &keyword)
+    {
+        std::string word;
+        if (!(in >> word) || word != keyword)
+            throw Exception(getName().c_str(), ("Malformed tuning: expected '" + keyword + "'").c_str());
+    };
+
+    unsigned int version = 0;
+    expect("KCBS-TUNING");
+    if (!(in >> version) || version != 1)
+        throw Exception(getName().c_str(), "Unsupported tuning version");
+    std::size_t count = 0;
+    expect("classes");
+    in >> count;
+
+    std::map<std::string, Tuning> tunings;
+    for (std::size_t k = 0; k < count && in; k++)
+    {
+        std::string scenarioClass;
+        Tuning tuning;
+        std::size_t numRobots = 0;
+        expect("class");
+        in >> std::quoted(scenarioClass);
+        expect("racers");
+        in >> tuning.racers_;
+        expect("solve_times");
+        in >> numRobots;
+        tuning.solveTimes_.resize(numRobots);
+        for (auto &t: tuning.solveTimes_)
+            in >> t;
+        if (!in || tuning.racers_ == 0)
+            throw Exception(getName().c_str(), "Malformed tuning: bad scenario class");
+        tunings[scenarioClass] = std::move(tuning);
+    }
+    if (!in)
+        throw Exception(getName().c_str(), "Malformed tuning");
+
+    std::lock_guard<std::mutex> lock(tuningMutex_);
+    for (auto &tuning: tunings)
+        tunings_[tuning.first] = std::move(tuning.second);
+    OMPL_INFORM("%s: Read the tuning of %zu scenario classes.", getName().c_str(), tunings.size());
+}
+
 void ompl::multirobot::control::KCBS::getPlannerData(ompl::base::PlannerData &data) const
 {
-    std::cout << "getPlannerData() called" << std::endl;
+    // the trees of K-CBS are not in the state space of data; see streamPlannerData()
+    base::Planner::getPlannerData(data);
+}
+
+void ompl::multirobot::control::KCBS::streamPlannerData(ompl::base::PlannerDataSink &sink) const
+{
+    using Sink = ompl::base::PlannerDataSink;
+    base::Planner::streamPlannerData(sink);
+
+    sink.beginSection("constraint tree", nullptr);
+    auto vertices = boost::vertices(tree_);
+    for (auto v = vertices.first; v != vertices.second; ++v)
+    {
+        const NodePtr &node = tree_[*v];
+        const std::uint64_t id = Sink::idOf(node.get());
+        Sink::VertexType type = Sink::PLAIN;
+        if (!node->getParent())
+            type = Sink::START;
+        else if (node->getCost() == 0)
+            type = Sink::GOAL;
+        sink.vertex(id, nullptr, type);
+        if (node->getParent())
+            sink.edge(Sink::idOf(node->getParent().get()), id);
+        sink.property(id, "index", std::to_string(node->getIndex()));
+        sink.property(id, "cost", std::to_string(node->getCost()));
+        if (node->getConstraint())
+        {
+            sink.property(id, "constrained robot", std::to_string(node->getConstraint()->constrainedRobot_));
+            sink.property(id, "first step", std::to_string(node->getConstraint()->firstStep_));
+            sink.property(id, "last step", std::to_string(node->getConstraint()->lastStep_));
+        }
+    }
+    sink.endSection();
+
+    for (unsigned int r = 0; r < llSolvers_.size(); r++)
+    {
+        if (!llSolvers_[r])
+            continue;
+        ompl::base::PrefixedPlannerDataSink robotSink(sink, "robot " + std::to_string(r) + ": ");
+        llSolvers_[r]->streamPlannerData(robotSink);
+    }
+
+    // the planners of failed replans, kept in the nodes to be retried
+    for (auto v = vertices.first; v != vertices.second; ++v)
+    {
+        const NodePtr &node = tree_[*v];
+        if (!node->getLowLevelSolver() || !node->getConstraint())
+            continue;
+        ompl::base::PrefixedPlannerDataSink nodeSink(sink, "node " + std::to_string(node->getIndex()) + " robot " +
+                                                               std::to_string(node->getConstraint()->constrainedRobot_) + ": ");
+        node->getLowLevelSolver()->streamPlannerData(nodeSink);
+    }
+
+    if (mergedPlanner_)
+    {
+        ompl::base::PrefixedPlannerDataSink mergedSink(sink, "merged: ");
+        mergedPlanner_->streamPlannerData(mergedSink);
+    }
+
+    for (std::size_t g = 0; g < groupPlanners_.size(); g++)
+    {
+        ompl::base::PrefixedPlannerDataSink groupSink(sink, "group " + std::to_string(g) + ": ");
+        groupPlanners_[g]->streamPlannerData(groupSink);
+    }
 }
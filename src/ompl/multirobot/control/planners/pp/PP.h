@@ -68,8 +68,45 @@ namespace ompl
 
                 void addPathAsDynamicObstacles(const unsigned int index, const ompl::control::PathControlPtr &path);
 
+                /** \brief Index the paths of higher-priority robots in a space-time grid with cells of side
+                    \e cellSize, so that each check only looks at obstacles within \e conflictRadius (in the
+                    default projection of the state spaces). A \e cellSize of 0 (the default) checks every
+                    obstacle at the same time step. */
+                void setReservationTable(double cellSize, double conflictRadius)
+                {
+                    reservationCellSize_ = cellSize;
+                    conflictRadius_ = conflictRadius;
+                }
+
+                /** \brief Get the cell size of the reservation table (0 if disabled) */
+                double getReservationCellSize() const
+                {
+                    return reservationCellSize_;
+                }
+
+                /** \brief Set the cell size of the reservation table (0 disables it) */
+                void setReservationCellSize(double cellSize)
+                {
+                    reservationCellSize_ = cellSize;
+                }
+
+                /** \brief Get the distance within which states of two robots may conflict */
+                double getConflictRadius() const
+                {
+                    return conflictRadius_;
+                }
+
+                /** \brief Set the distance within which states of two robots may conflict */
+                void setConflictRadius(double conflictRadius)
+                {
+                    conflictRadius_ = conflictRadius;
+                }
+
                 void getPlannerData(ompl::base::PlannerData &data) const override;
 
+                /** \brief Send the trees of the low-level planners of the robots to \e sink */
+                void streamPlannerData(ompl::base::PlannerDataSink &sink) const override;
+
                 ompl::base::PlannerStatus solve(const ompl::base::PlannerTerminationCondition &ptc) override;
 
                 void clear() override;
@@ -81,11 +118,24 @@ namespace ompl
                 /** \brief Free the memory allocated by this planner */
                 void freeMemory();
 
+                /** \brief Return true if \e individual can stay at the end of \e path until every robot of higher
+                    priority has reached its goal */
+                bool canWaitAtGoal(const unsigned int individual, const ompl::control::PathControlPtr &path) const;
+
                 /** \brief An ordered container containing a solver for every individual */
                 std::vector<ompl::base::PlannerPtr> llSolvers_;
 
                 /** \brief The base::SpaceInformation cast as control::SpaceInformation, for convenience */
                 const SpaceInformation *siC_;
+
+                /** \brief Cell size of the reservation table for dynamic obstacles (0 if disabled) */
+                double reservationCellSize_{0.};
+
+                /** \brief Distance within which states of two robots may conflict */
+                double conflictRadius_{0.};
+
+                /** \brief The time at which the last robot added as dynamic obstacles reaches its goal */
+                double obstacleHorizon_{0.};
             };
         }
     }
@@ -36,12 +36,18 @@
 
 #include "ompl/multirobot/control/planners/pp/PP.h"
 #include "ompl/control/planners/rrt/RRT.h"
+#include <algorithm>
 
 
 ompl::multirobot::control::PP::PP(const ompl::multirobot::control::SpaceInformationPtr &si, ompl::base::PlannerPtr solver)
   : ompl::multirobot::base::Planner(si, "PP")
 {
     siC_ = si.get();
+
+    Planner::declareParam<double>("reservation_cell_size", this, &PP::setReservationCellSize,
+                                  &PP::getReservationCellSize, "0.:1.:10000.");
+    Planner::declareParam<double>("conflict_radius", this, &PP::setConflictRadius, &PP::getConflictRadius,
+                                  "0.:1.:10000.");
 }
 
 ompl::multirobot::control::PP::~PP()
@@ -93,8 +99,11 @@ void ompl::multirobot::control::PP::addPathAsDynamicObstacles(const unsigned int
         {
             auto state =  siC_->getIndividual(individual)->cloneState(states[step]);
             siC_->getIndividual(r)->addDynamicObstacle(time, siC_->getIndividual(individual), state);
-            time += durs[step];
+            // there is one control duration less than states; the last state is where the robot stays
+            if (step < durs.size())
+                time += durs[step];
         }
+        obstacleHorizon_ = std::max(obstacleHorizon_, time);
         // add the robot staying still at goal as dynamic obstacle
         const unsigned int max_steps = 10000;
         for (unsigned int s = 0; s < max_steps; s++)
@@ -110,18 +119,47 @@ void ompl::multirobot::control::PP::addPathAsDynamicObstacles(const unsigned int
     siC_->getIndividual(individual)->clearDynamicObstacles();
 }
 
+bool ompl::multirobot::control::PP::canWaitAtGoal(const unsigned int individual, const ompl::control::PathControlPtr &path) const
+{
+    // the robots of higher priority may still pass through the goal of individual after it arrives (the length of a
+    // control path is its duration)
+    const ompl::control::SpaceInformationPtr &si = siC_->getIndividual(individual);
+    const double dt = si->getPropagationStepSize();
+    const ompl::base::State *goal = path->getStates().back();
+    for (double time = path->length(); time <= obstacleHorizon_ + dt; time += dt)
+    {
+        if (!si->isValid(goal, time))
+            return false;
+    }
+    return true;
+}
+
 ompl::base::PlannerStatus ompl::multirobot::control::PP::solve(const ompl::base::PlannerTerminationCondition &ptc)
 {
     checkValidity();
+    // index the paths of higher-priority robots by space and time, if requested
+    for (unsigned int r = 0; r < siC_->getIndividualCount(); ++r)
+        siC_->getIndividual(r)->setReservationTable(reservationCellSize_, conflictRadius_);
+    obstacleHorizon_ = 0.;
     auto plan(std::make_shared<PlanControl>(si_));
     for (unsigned int r = 0; r < siC_->getIndividualCount(); ++r)
     {
         // plan for individual r while treating individuals 1, ..., r-1 as dynamic obstacles 
         ompl::base::PlannerStatus solved = llSolvers_[r]->solve(ptc);
+        ompl::control::PathControlPtr path;
+        while (solved == ompl::base::PlannerStatus::EXACT_SOLUTION)
+        {
+            path = std::make_shared<ompl::control::PathControl>(*llSolvers_[r]->getProblemDefinition()->getSolutionPath()->as<ompl::control::PathControl>());
+            if (canWaitAtGoal(r, path))
+                break;
+            // individual r would wait at its goal in the way of a robot of higher priority, so plan again
+            llSolvers_[r]->clear();
+            llSolvers_[r]->getProblemDefinition()->clearSolutionPaths();
+            solved = llSolvers_[r]->solve(ptc);
+        }
         if (solved == ompl::base::PlannerStatus::EXACT_SOLUTION)
         {
             // add the path to the plan
-            auto path = std::make_shared<ompl::control::PathControl>(*llSolvers_[r]->getProblemDefinition()->getSolutionPath()->as<ompl::control::PathControl>());
             addPathAsDynamicObstacles(r, path);
             plan->as<PlanControl>()->append(path);
         }
@@ -139,5 +177,18 @@ ompl::base::PlannerStatus ompl::multirobot::control::PP::solve(const ompl::base:
 
 void ompl::multirobot::control::PP::getPlannerData(ompl::base::PlannerData &data) const
 {
-    std::cout << "getPlannerData() called" << std::endl;
+    // the trees of PP are not in the state space of data; see streamPlannerData()
+    base::Planner::getPlannerData(data);
+}
+
+void ompl::multirobot::control::PP::streamPlannerData(ompl::base::PlannerDataSink &sink) const
+{
+    base::Planner::streamPlannerData(sink);
+    for (unsigned int r = 0; r < llSolvers_.size(); r++)
+    {
+        if (!llSolvers_[r])
+            continue;
+        ompl::base::PrefixedPlannerDataSink robotSink(sink, "robot " + std::to_string(r) + ": ");
+        llSolvers_[r]->streamPlannerData(robotSink);
+    }
 }
@@ -68,6 +68,40 @@ namespace ompl
 
                 void addPathAsDynamicObstacles(const unsigned int index, const ompl::geometric::PathGeometricPtr path);
 
+                /** \brief Index the paths of higher-priority robots in a space-time grid with cells of side
+                    \e cellSize, so that each check only looks at obstacles within \e conflictRadius (in the
+                    default projection of the state spaces). A \e cellSize of 0 (the default) checks every
+                    obstacle at the same time step. */
+                void setReservationTable(double cellSize, double conflictRadius)
+                {
+                    reservationCellSize_ = cellSize;
+                    conflictRadius_ = conflictRadius;
+                }
+
+                /** \brief Get the cell size of the reservation table (0 if disabled) */
+                double getReservationCellSize() const
+                {
+                    return reservationCellSize_;
+                }
+
+                /** \brief Set the cell size of the reservation table (0 disables it) */
+                void setReservationCellSize(double cellSize)
+                {
+                    reservationCellSize_ = cellSize;
+                }
+
+                /** \brief Get the distance within which states of two robots may conflict */
+                double getConflictRadius() const
+                {
+                    return conflictRadius_;
+                }
+
+                /** \brief Set the distance within which states of two robots may conflict */
+                void setConflictRadius(double conflictRadius)
+                {
+                    conflictRadius_ = conflictRadius;
+                }
+
                 void getPlannerData(ompl::base::PlannerData &data) const override;
 
                 ompl::base::PlannerStatus solve(const ompl::base::PlannerTerminationCondition &ptc) override;
@@ -82,6 +116,12 @@ namespace ompl
                 void freeMemory();
 
                 ompl::base::PlannerPtr solver_;
+
+                /** \brief Cell size of the reservation table for dynamic obstacles (0 if disabled) */
+                double reservationCellSize_{0.};
+
+                /** \brief Distance within which states of two robots may conflict */
+                double conflictRadius_{0.};
             };
         }
     }
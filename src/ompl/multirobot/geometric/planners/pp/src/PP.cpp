@@ -50,6 +50,11 @@ ompl::multirobot::geometric::PP::PP(const ompl::multirobot::base::SpaceInformati
     //                             "0,1");
 
     // addIntermediateStates_ = addIntermediateStates;
+
+    Planner::declareParam<double>("reservation_cell_size", this, &PP::setReservationCellSize,
+                                  &PP::getReservationCellSize, "0.:1.:10000.");
+    Planner::declareParam<double>("conflict_radius", this, &PP::setConflictRadius, &PP::getConflictRadius,
+                                  "0.:1.:10000.");
 }
 
 ompl::multirobot::geometric::PP::~PP()
@@ -89,9 +94,11 @@ void ompl::multirobot::geometric::PP::addPathAsDynamicObstacles(const unsigned i
 {
     for (unsigned int r = individual + 1; r < si_->getIndividualCount(); r++)
     {
+        // the dynamic obstacles own their states, so they get copies of the states of path
         for (unsigned int t = 0; t < path->getStates().size(); t++)
         {
-            si_->addDynamicObstacleForIndividual(r, individual, path->getState(t), (double)t);
+            auto state = si_->getIndividual(individual)->cloneState(path->getState(t));
+            si_->addDynamicObstacleForIndividual(r, individual, state, (double)t);
         }
     }
 }
@@ -99,6 +106,9 @@ void ompl::multirobot::geometric::PP::addPathAsDynamicObstacles(const unsigned i
 ompl::base::PlannerStatus ompl::multirobot::geometric::PP::solve(const ompl::base::PlannerTerminationCondition &ptc)
 {
     checkValidity();
+    // index the paths of higher-priority robots by space and time, if requested
+    for (unsigned int r = 0; r < si_->getIndividualCount(); ++r)
+        si_->getIndividual(r)->setReservationTable(reservationCellSize_, conflictRadius_);
     auto plan(std::make_shared<PlanGeometric>(si_));
     for (unsigned int r = 0; r < si_->getIndividualCount(); ++r)
     {
@@ -132,5 +142,6 @@ ompl::base::PlannerStatus ompl::multirobot::geometric::PP::solve(const ompl::bas
 
 void ompl::multirobot::geometric::PP::getPlannerData(ompl::base::PlannerData &data) const
 {
-    std::cout << "getPlannerData() called" << std::endl;
+    // the trees of PP are not in the state space of data
+    base::Planner::getPlannerData(data);
 }
@@ -36,6 +36,7 @@
 
 #include "ompl/tools/benchmark/Benchmark.h"
 #include "ompl/tools/benchmark/MachineSpecs.h"
+#include "ompl/tools/config/ThreadPlacement.h"
 #include "ompl/util/Time.h"
 #include "ompl/config.h"
 #include "ompl/util/String.h"
@@ -58,6 +59,21 @@ namespace ompl
             return "ompl_" + exp.host + "_" + time::as_string(exp.startTime) + ".log";
         }
 
+        /** \brief The largest number of threads any of the planners runs, read from their "num_threads" or
+         * "thread_count" parameter (planners without either run one thread) */
+        static unsigned int getMaxThreadCount(const std::vector<base::PlannerPtr> &planners)
+        {
+            unsigned int threads = 1;
+            for (const auto &planner : planners)
+            {
+                std::string value;
+                if (planner->params().getParam("num_threads", value) ||
+                    planner->params().getParam("thread_count", value))
+                    threads = std::max(threads, static_cast<unsigned int>(std::stoul(value)));
+            }
+            return threads;
+        }
+
         /** \brief Propose a name for a file in which console output should be saved, based on the date and hostname of
          * the experiment */
         static std::string getConsoleFilename(const Benchmark::CompleteExperiment &exp)
@@ -461,7 +477,7 @@ void ompl::tools::Benchmark::benchmark(const Request &req)
     exp_.maxMem = req.maxMem;
     exp_.runCount = req.runCount;
     exp_.host = machine::getHostname();
-    exp_.cpuInfo = machine::getCPUInfo();
+    exp_.cpuInfo = machine::getCPUInfo() + ThreadPlacement::getInfo(getMaxThreadCount(planners_));
     exp_.seed = RNG::getSeed();
 
     exp_.startTime = time::now();
@@ -41,12 +41,18 @@
 #include "ompl/base/Goal.h"
 #include "ompl/base/Planner.h"
 #include "ompl/base/SpaceInformation.h"
+#include "ompl/base/spaces/DubinsStateSpace.h"
+#include "ompl/base/spaces/ReedsSheppStateSpace.h"
 #include "ompl/datastructures/NearestNeighborsSqrtApprox.h"
 #include "ompl/datastructures/NearestNeighborsGNAT.h"
 #include "ompl/datastructures/NearestNeighborsGNATNoThreadSafety.h"
+#include "ompl/datastructures/NearestNeighborsPlanarGrid.h"
+#include <boost/math/constants/constants.hpp>
+#include <cmath>
 #include <mutex>
 #include <iostream>
 #include <string>
+#include <type_traits>
 
 namespace ompl
 {
@@ -99,7 +105,14 @@ namespace ompl
              *   then the default is ompl::NearestNeighborsGNATNoThreadSafety.
              * - If the space is a metric space and the planner is multi-threaded,
              *   then the default is ompl::NearestNeighborsGNAT.
-             * - If the space is a not a metric space,
+             * - If the space is a Dubins or Reeds-Shepp space and the elements point
+             *   to structures with a \e state member (as the motions of most planners
+             *   do), then the default is ompl::NearestNeighborsPlanarGrid. Its pruning
+             *   assumes that the planner sets the distance of the space (between the
+             *   \e state members) as distance function, as most planners do. Planners
+             *   that use another distance, such as the motion cost of an optimization
+             *   objective, must not use this default for these spaces.
+             * - If the space is a not a metric space otherwise,
              *   then the default is ompl::NearestNeighborsSqrtApprox.
              */
             template <typename _T>
@@ -113,14 +126,79 @@ namespace ompl
                         return new NearestNeighborsGNAT<_T>();
                     return new NearestNeighborsGNATNoThreadSafety<_T>();
                 }
+                if (NearestNeighbors<_T> *nn = getTurningRadiusNearestNeighbors<_T>(space, HasStateMember<_T>()))
+                    return nn;
                 return new NearestNeighborsSqrtApprox<_T>();
             }
 
+            /** \brief Return a nearest neighbors datastructure that prunes with lower bounds of the distance
+                for elements that point to structures with a \e state member, if \e space is a Dubins or
+                Reeds-Shepp space. Return nullptr otherwise.
+
+                The bounds are the Euclidean distance of the positions, and the turning radius times the heading
+                difference (a path of length L turns by at most L divided by the turning radius). They only bound
+                the distance of \e space, so the distance function set later must be that distance. */
+            template <typename _T>
+            static NearestNeighbors<_T> *getTurningRadiusNearestNeighbors(const base::StateSpacePtr &space,
+                                                                          std::true_type /*hasStateMember*/)
+            {
+                double rho;
+                auto dubins = std::dynamic_pointer_cast<base::DubinsStateSpace>(space);
+                if (dubins)
+                    rho = dubins->getTurningRadius();
+                else if (const auto *reedsShepp = dynamic_cast<const base::ReedsSheppStateSpace *>(space.get()))
+                    rho = reedsShepp->getTurningRadius();
+                else
+                    return nullptr;
+                auto *grid = new NearestNeighborsPlanarGrid<_T>(
+                    [](const _T &data)
+                    {
+                        const auto *s = data->state->template as<base::SE2StateSpace::StateType>();
+                        return std::array<double, 2>{{s->getX(), s->getY()}};
+                    },
+                    [rho](const _T &a, const _T &b)
+                    {
+                        double d = std::fabs(a->state->template as<base::SE2StateSpace::StateType>()->getYaw() -
+                                             b->state->template as<base::SE2StateSpace::StateType>()->getYaw());
+                        d = std::fmod(d, 2.0 * boost::math::constants::pi<double>());
+                        return rho * std::min(d, 2.0 * boost::math::constants::pi<double>() - d);
+                    });
+                // the Dubins words of all candidates of a query are evaluated in one pass
+                if (dubins)
+                    grid->setBatchDistanceFunction(
+                        [dubins](const std::vector<_T> &from, const _T &to, std::vector<double> &result)
+                        {
+                            std::vector<const base::State *> states;
+                            states.reserve(from.size());
+                            for (const auto &f : from)
+                                states.push_back(f->state);
+                            dubins->distances(states, to->state, result);
+                        });
+                return grid;
+            }
+
+            template <typename _T>
+            static NearestNeighbors<_T> *getTurningRadiusNearestNeighbors(const base::StateSpacePtr & /*space*/,
+                                                                          std::false_type /*hasStateMember*/)
+            {
+                return nullptr;
+            }
+
             /** \brief Given a goal specification, decide on a planner for that goal */
             static base::PlannerPtr getDefaultPlanner(const base::GoalPtr &goal);
 
         private:
             /// @cond IGNORE
+            template <typename _T, typename = void>
+            struct HasStateMember : std::false_type
+            {
+            };
+
+            template <typename _T>
+            struct HasStateMember<_T, decltype(void(std::declval<const _T &>()->state))> : std::true_type
+            {
+            };
+
             class SelfConfigImpl;
 
             SelfConfigImpl *impl_;
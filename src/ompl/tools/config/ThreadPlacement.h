@@ -0,0 +1,138 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2026, the MROR Multi-Robot OMPL contributors
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+/* Author: MROR Multi-Robot OMPL contributors */
+
+#ifndef OMPL_TOOLS_CONFIG_THREAD_PLACEMENT_
+#define OMPL_TOOLS_CONFIG_THREAD_PLACEMENT_
+
+#include <string>
+#include <vector>
+
+namespace ompl
+{
+    namespace tools
+    {
+        /** \brief Placement of the worker threads of parallel planners on the processing units of the machine.
+            The topology of the machine (cores, shared caches, sockets and NUMA nodes) is read from /sys once.
+            Parallel planners reserve CPUs for their workers with a Reservation before starting them and call
+            Reservation::pinWorker() at the start of each thread, before the thread allocates its data, so that
+            (with the first-touch policy of Linux) the data of the thread is allocated on its NUMA node. Pools of
+            workers that run at the same time get different CPUs as long as there are enough of them. By default threads are not pinned; the policy is set with setPolicy() or with the
+            OMPL_THREAD_PLACEMENT environment variable ("none", "compact" or "scatter"). Threads created by a
+            pinned thread inherit its CPU, so workers that start threads of their own should not be pinned.
+            Pinning is only supported on Linux. */
+        class ThreadPlacement
+        {
+        public:
+            /** \brief The ways of placing worker threads */
+            enum Policy
+            {
+                /** \brief Threads are not pinned */
+                NONE,
+                /** \brief Threads are placed on as few sockets (and shared caches) as possible, one per core before
+                    using the hardware threads of a core. This minimizes the traffic between sockets. */
+                COMPACT,
+                /** \brief Threads are spread over the NUMA nodes in turn, one per core before using the hardware
+                    threads of a core. This maximizes the memory bandwidth available to the threads. */
+                SCATTER
+            };
+
+            /** \brief A processing unit (logical CPU) of the machine */
+            struct ProcessingUnit
+            {
+                /** \brief The id of the logical CPU */
+                unsigned int cpu;
+                /** \brief The id of the physical core within the socket */
+                int core;
+                /** \brief The id of the socket */
+                int socket;
+                /** \brief The id of the NUMA node */
+                int node;
+                /** \brief The id of the last-level cache */
+                int cache;
+                /** \brief The index of the processing unit among the hardware threads of its core */
+                unsigned int thread;
+            };
+
+            /** \brief Set the placement policy */
+            static void setPolicy(Policy policy);
+
+            /** \brief Get the placement policy */
+            static Policy getPolicy();
+
+            /** \brief Get the processing units the process may run on */
+            static const std::vector<ProcessingUnit> &getTopology();
+
+            /** \brief Get the logical CPUs that \e numWorkers workers are placed on with the current policy when no
+                other pool of workers holds a Reservation (empty if threads are not pinned) */
+            static std::vector<unsigned int> getPlacement(unsigned int numWorkers);
+
+            /** \brief The CPUs of a pool of workers. The CPUs are taken in the order of the current policy, skipping
+                the CPUs reserved by the other pools that are alive; only when every CPU is in use are CPUs shared,
+                the least used first. The reservation must be kept until the workers are joined. */
+            class Reservation
+            {
+            public:
+                /** \brief Reserve CPUs for \e numWorkers workers */
+                explicit Reservation(unsigned int numWorkers);
+
+                ~Reservation();
+
+                Reservation(const Reservation &) = delete;
+                Reservation &operator=(const Reservation &) = delete;
+
+                /** \brief Get the logical CPU of each worker (empty if threads are not pinned) */
+                const std::vector<unsigned int> &getPlacement() const
+                {
+                    return placement_;
+                }
+
+                /** \brief Pin the calling thread, which is worker \e worker of the pool, to its CPU. Returns true
+                    if the thread was pinned. */
+                bool pinWorker(unsigned int worker) const;
+
+            private:
+                /** \brief The CPU of each worker */
+                std::vector<unsigned int> placement_;
+            };
+
+            /** \brief Describe the topology of the machine and the placement of \e numWorkers workers (for
+                benchmark logs) */
+            static std::string getInfo(unsigned int numWorkers);
+        };
+    }
+}
+
+#endif
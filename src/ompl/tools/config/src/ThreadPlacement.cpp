@@ -0,0 +1,294 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2026, the MROR Multi-Robot OMPL contributors
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+/* Author: MROR Multi-Robot OMPL contributors */
+
+#include "ompl/tools/config/ThreadPlacement.h"
+#include "ompl/util/Console.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <thread>
+#include <tuple>
+
+#if defined __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+/// @cond IGNORE
+namespace
+{
+    ompl::tools::ThreadPlacement::Policy policyFromEnvironment()
+    {
+        const char *value = std::getenv("OMPL_THREAD_PLACEMENT");
+        if (value == nullptr)
+            return ompl::tools::ThreadPlacement::NONE;
+        std::string policy(value);
+        if (policy == "compact")
+            return ompl::tools::ThreadPlacement::COMPACT;
+        if (policy == "scatter")
+            return ompl::tools::ThreadPlacement::SCATTER;
+        if (policy != "none" && !policy.empty())
+            OMPL_WARN("Unknown thread placement policy '%s'. Threads are not pinned.", value);
+        return ompl::tools::ThreadPlacement::NONE;
+    }
+
+    std::atomic<int> &policy()
+    {
+        static std::atomic<int> policy{policyFromEnvironment()};
+        return policy;
+    }
+
+    // read a single integer from a file in /sys; return fallback if it cannot be read
+    int readId(const std::string &path, int fallback)
+    {
+        std::ifstream in(path);
+        int id;
+        if (in >> id)
+            return id;
+        return fallback;
+    }
+
+    // parse a list of CPUs such as "0-3,8-11"
+    std::vector<unsigned int> readCPUList(const std::string &path)
+    {
+        std::vector<unsigned int> cpus;
+        std::ifstream in(path);
+        std::string range;
+        while (std::getline(in, range, ','))
+        {
+            unsigned int first, last;
+            char dash;
+            std::istringstream r(range);
+            if (!(r >> first))
+                continue;
+            last = first;
+            if (r >> dash >> last && dash != '-')
+                last = first;
+            for (unsigned int cpu = first; cpu <= last; ++cpu)
+                cpus.push_back(cpu);
+        }
+        return cpus;
+    }
+
+    std::vector<ompl::tools::ThreadPlacement::ProcessingUnit> discoverTopology()
+    {
+        std::vector<unsigned int> cpus;
+#if defined __linux__
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        if (sched_getaffinity(0, sizeof(set), &set) == 0)
+            for (unsigned int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+                if (CPU_ISSET(cpu, &set))
+                    cpus.push_back(cpu);
+#endif
+        if (cpus.empty())
+            for (unsigned int cpu = 0; cpu < std::max(1u, std::thread::hardware_concurrency()); ++cpu)
+                cpus.push_back(cpu);
+
+        // the NUMA node of every CPU
+        std::map<unsigned int, int> nodes;
+        for (int node = 0; node < 1024; ++node)
+        {
+            std::vector<unsigned int> nodeCPUs = readCPUList("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+            if (nodeCPUs.empty() && node > 0 && nodes.size() >= cpus.size())
+                break;
+            for (unsigned int cpu : nodeCPUs)
+                nodes[cpu] = node;
+        }
+
+        std::vector<ompl::tools::ThreadPlacement::ProcessingUnit> units;
+        std::map<std::pair<int, int>, unsigned int> threadsPerCore;
+        for (unsigned int cpu : cpus)
+        {
+            const std::string dir = "/sys/devices/system/cpu/cpu" + std::to_string(cpu);
+            ompl::tools::ThreadPlacement::ProcessingUnit unit;
+            unit.cpu = cpu;
+            unit.core = readId(dir + "/topology/core_id", cpu);
+            unit.socket = readId(dir + "/topology/physical_package_id", 0);
+            unit.node = nodes.count(cpu) != 0u ? nodes[cpu] : 0;
+            unit.cache = readId(dir + "/cache/index3/id", unit.socket);
+            unit.thread = threadsPerCore[std::make_pair(unit.socket, unit.core)]++;
+            units.push_back(unit);
+        }
+        return units;
+    }
+
+    // the CPUs of all processing units, in the order workers are placed on them with the given policy
+    std::vector<unsigned int> placementOrder(ompl::tools::ThreadPlacement::Policy policy)
+    {
+        using ProcessingUnit = ompl::tools::ThreadPlacement::ProcessingUnit;
+        std::vector<ProcessingUnit> units = ompl::tools::ThreadPlacement::getTopology();
+        std::vector<unsigned int> order;
+        if (policy == ompl::tools::ThreadPlacement::NONE || units.empty())
+            return order;
+
+        if (policy == ompl::tools::ThreadPlacement::COMPACT)
+        {
+            // fill the cores of a socket (sharing a cache) first, then their other hardware threads, then the next socket
+            std::sort(units.begin(), units.end(), [](const ProcessingUnit &a, const ProcessingUnit &b)
+                      { return std::tie(a.node, a.socket, a.cache, a.thread, a.core, a.cpu) <
+                               std::tie(b.node, b.socket, b.cache, b.thread, b.core, b.cpu); });
+            for (const auto &unit : units)
+                order.push_back(unit.cpu);
+        }
+        else
+        {
+            // take the processing units of the NUMA nodes in turn, cores before their other hardware threads
+            std::sort(units.begin(), units.end(), [](const ProcessingUnit &a, const ProcessingUnit &b)
+                      { return std::tie(a.thread, a.node, a.cache, a.core, a.cpu) <
+                               std::tie(b.thread, b.node, b.cache, b.core, b.cpu); });
+            std::map<int, std::vector<unsigned int>> perNode;
+            for (const auto &unit : units)
+                perNode[unit.node].push_back(unit.cpu);
+            for (std::size_t i = 0; order.size() < units.size(); ++i)
+                for (const auto &node : perNode)
+                    if (i < node.second.size())
+                        order.push_back(node.second[i]);
+        }
+        return order;
+    }
+
+    // place numWorkers workers on the CPUs of order, each on the first of the least used CPUs; usage is updated
+    std::vector<unsigned int> placeWorkers(const std::vector<unsigned int> &order, unsigned int numWorkers,
+                                           std::map<unsigned int, unsigned int> &usage)
+    {
+        std::vector<unsigned int> placement;
+        if (order.empty())
+            return placement;
+        placement.reserve(numWorkers);
+        for (unsigned int w = 0; w < numWorkers; ++w)
+        {
+            unsigned int best = order[0];
+            for (unsigned int cpu : order)
+                if (usage[cpu] < usage[best])
+                    best = cpu;
+            ++usage[best];
+            placement.push_back(best);
+        }
+        return placement;
+    }
+
+    // the number of workers of the live reservations on each CPU
+    std::mutex reservationMutex;
+    std::map<unsigned int, unsigned int> reservedCPUs;
+}
+/// @endcond
+
+void ompl::tools::ThreadPlacement::setPolicy(Policy policy)
+{
+    ::policy() = policy;
+}
+
+ompl::tools::ThreadPlacement::Policy ompl::tools::ThreadPlacement::getPolicy()
+{
+    return static_cast<Policy>(::policy().load());
+}
+
+const std::vector<ompl::tools::ThreadPlacement::ProcessingUnit> &ompl::tools::ThreadPlacement::getTopology()
+{
+    static const std::vector<ProcessingUnit> topology = discoverTopology();
+    return topology;
+}
+
+std::vector<unsigned int> ompl::tools::ThreadPlacement::getPlacement(unsigned int numWorkers)
+{
+    std::map<unsigned int, unsigned int> usage;
+    return placeWorkers(placementOrder(getPolicy()), numWorkers, usage);
+}
+
+ompl::tools::ThreadPlacement::Reservation::Reservation(unsigned int numWorkers)
+{
+    const std::vector<unsigned int> order = placementOrder(getPolicy());
+    std::lock_guard<std::mutex> lock(reservationMutex);
+    placement_ = placeWorkers(order, numWorkers, reservedCPUs);
+}
+
+ompl::tools::ThreadPlacement::Reservation::~Reservation()
+{
+    std::lock_guard<std::mutex> lock(reservationMutex);
+    for (unsigned int cpu : placement_)
+        --reservedCPUs[cpu];
+}
+
+bool ompl::tools::ThreadPlacement::Reservation::pinWorker(unsigned int worker) const
+{
+    if (worker >= placement_.size())
+        return false;
+#if defined __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(placement_[worker], &set);
+    if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0)
+        return true;
+    OMPL_DEBUG("Unable to pin worker %u to CPU %u", worker, placement_[worker]);
+#endif
+    return false;
+}
+
+std::string ompl::tools::ThreadPlacement::getInfo(unsigned int numWorkers)
+{
+    static const char *POLICY_NAMES[] = {"none", "compact", "scatter"};
+    const std::vector<ProcessingUnit> &units = getTopology();
+    std::set<int> sockets, nodes, caches;
+    std::set<std::pair<int, int>> cores;
+    for (const auto &unit : units)
+    {
+        sockets.insert(unit.socket);
+        nodes.insert(unit.node);
+        caches.insert(unit.cache);
+        cores.insert(std::make_pair(unit.socket, unit.core));
+    }
+
+    std::stringstream info;
+    info << "Topology: " << units.size() << " processing units, " << cores.size() << " cores, " << caches.size()
+         << " last-level caches, " << sockets.size() << " sockets, " << nodes.size() << " NUMA nodes" << std::endl;
+    info << "Thread placement: " << POLICY_NAMES[getPolicy()];
+    const std::vector<unsigned int> placement = getPlacement(numWorkers);
+    if (!placement.empty())
+    {
+        info << " (CPU of each of " << numWorkers << " workers:";
+        for (unsigned int cpu : placement)
+            info << " " << cpu;
+        info << ")";
+    }
+    info << std::endl;
+    return info.str();
+}
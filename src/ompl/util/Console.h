@@ -37,6 +37,8 @@
 #ifndef OMPL_UTIL_CONSOLE_
 #define OMPL_UTIL_CONSOLE_
 
+#include <atomic>
+#include <memory>
 #include <string>
 
 /** \file Console.h
@@ -59,19 +61,42 @@
     \brief Log a formatted debugging string.
     \remarks This macro takes the same arguments as [printf](http://www.cplusplus.com/reference/clibrary/cstdio/printf).
 
+    \def OMPL_MIN_LOG_LEVEL
+    \brief The lowest level of messages that are compiled in. Messages of lower levels are removed at compile time,
+    together with the evaluation of their arguments. Define it (e.g., -DOMPL_MIN_LOG_LEVEL=1 to keep only
+    information, warning and error messages) to override the default, which keeps all messages.
+
     \}
 */
-#define OMPL_ERROR(fmt, ...) ompl::msg::log(__FILE__, __LINE__, ompl::msg::LOG_ERROR, fmt, ##__VA_ARGS__)
+#ifndef OMPL_MIN_LOG_LEVEL
+#define OMPL_MIN_LOG_LEVEL ompl::msg::LOG_DEV2
+#endif
+
+/// @cond IGNORE
+// every call site has its own rate limiter (see ompl::msg::setRateLimit())
+#define OMPL_LOG_AT_LEVEL(level, fmt, ...)                                                                             \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if ((level) >= OMPL_MIN_LOG_LEVEL)                                                                             \
+        {                                                                                                              \
+            static ompl::msg::RateLimiter ompl_log_rate_limiter_;                                                     \
+            if (ompl_log_rate_limiter_.allow(level))                                                                   \
+                ompl::msg::log(__FILE__, __LINE__, level, fmt, ##__VA_ARGS__);                                         \
+        }                                                                                                              \
+    } while (0)
+/// @endcond
+
+#define OMPL_ERROR(fmt, ...) OMPL_LOG_AT_LEVEL(ompl::msg::LOG_ERROR, fmt, ##__VA_ARGS__)
 
-#define OMPL_WARN(fmt, ...) ompl::msg::log(__FILE__, __LINE__, ompl::msg::LOG_WARN, fmt, ##__VA_ARGS__)
+#define OMPL_WARN(fmt, ...) OMPL_LOG_AT_LEVEL(ompl::msg::LOG_WARN, fmt, ##__VA_ARGS__)
 
-#define OMPL_INFORM(fmt, ...) ompl::msg::log(__FILE__, __LINE__, ompl::msg::LOG_INFO, fmt, ##__VA_ARGS__)
+#define OMPL_INFORM(fmt, ...) OMPL_LOG_AT_LEVEL(ompl::msg::LOG_INFO, fmt, ##__VA_ARGS__)
 
-#define OMPL_DEBUG(fmt, ...) ompl::msg::log(__FILE__, __LINE__, ompl::msg::LOG_DEBUG, fmt, ##__VA_ARGS__)
+#define OMPL_DEBUG(fmt, ...) OMPL_LOG_AT_LEVEL(ompl::msg::LOG_DEBUG, fmt, ##__VA_ARGS__)
 
-#define OMPL_DEVMSG1(fmt, ...) ompl::msg::log(__FILE__, __LINE__, ompl::msg::LOG_DEV1, fmt, ##__VA_ARGS__)
+#define OMPL_DEVMSG1(fmt, ...) OMPL_LOG_AT_LEVEL(ompl::msg::LOG_DEV1, fmt, ##__VA_ARGS__)
 
-#define OMPL_DEVMSG2(fmt, ...) ompl::msg::log(__FILE__, __LINE__, ompl::msg::LOG_DEV2, fmt, ##__VA_ARGS__)
+#define OMPL_DEVMSG2(fmt, ...) OMPL_LOG_AT_LEVEL(ompl::msg::LOG_DEV2, fmt, ##__VA_ARGS__)
 
 namespace ompl
 {
@@ -109,6 +134,13 @@ namespace ompl
             /** \brief log a message to the output handler with the given text
                 and logging level from a specific file and line number */
             virtual void log(const std::string &text, LogLevel level, const char *filename, int line) = 0;
+
+            /** \brief Return true if log() may be called from several threads at once. Otherwise, calls to
+                log() are serialized. */
+            virtual bool isThreadSafe() const
+            {
+                return false;
+            }
         };
 
         /** \brief Default implementation of OutputHandler. This sends
@@ -137,6 +169,70 @@ namespace ompl
             FILE *file_;
         };
 
+        /** \brief Implementation of OutputHandler that passes messages on to another output handler from a
+            background thread. Logging threads only copy their message into a lock-free ring buffer, so they
+            neither wait for I/O nor for each other. If the buffer is full, messages are dropped; the number
+            of dropped messages is reported with the next message that is passed on. */
+        class OutputHandlerAsync : public OutputHandler
+        {
+        public:
+            /** \brief Pass messages on to \e handler, buffering up to \e capacity of them (rounded up to a
+                power of two). \e handler must outlive this instance. */
+            OutputHandlerAsync(OutputHandler *handler, std::size_t capacity = 1024);
+
+            /** \brief Pass on the buffered messages and stop the background thread */
+            ~OutputHandlerAsync() override;
+
+            void log(const std::string &text, LogLevel level, const char *filename, int line) override;
+
+            bool isThreadSafe() const override
+            {
+                return true;
+            }
+
+            /** \brief Wait until the messages logged so far have been passed on */
+            void flush();
+
+            /** \brief Return the number of messages dropped because the buffer was full */
+            std::size_t getDroppedCount() const;
+
+        private:
+            struct Impl;
+            std::unique_ptr<Impl> impl_;
+        };
+
+        /** \brief Limits how many messages a call site of the \ref logging "logging macros" outputs per second
+            (see setRateLimit()). Every call site has its own instance. */
+        class RateLimiter
+        {
+        public:
+            constexpr RateLimiter() = default;
+
+            RateLimiter(const RateLimiter &) = delete;
+            RateLimiter &operator=(const RateLimiter &) = delete;
+
+            /** \brief Return true if a message of \e level should be output now. Errors are never limited. */
+            bool allow(LogLevel level);
+
+        private:
+            /** \brief The start of the current one-second window, in nanoseconds of a steady clock */
+            std::atomic<long long> windowStart_{0};
+
+            /** \brief The number of messages in the current window */
+            std::atomic<unsigned int> count_{0};
+        };
+
+        /** \brief Let every call site of the \ref logging "logging macros" output at most \e messagesPerSecond
+            messages per second (error messages are not limited). Further messages are discarded. 0 (the
+            default) means no limit. */
+        void setRateLimit(unsigned int messagesPerSecond);
+
+        /** \brief Get the maximum number of messages per second of a call site (0 if unlimited) */
+        unsigned int getRateLimit();
+
+        /** \brief Return the number of messages discarded by rate limiting so far */
+        std::size_t getRateLimitedCount();
+
         /** \brief This function instructs ompl that no messages should be outputted. Equivalent to
          * useOutputHandler(nullptr) */
         void noOutputHandler();
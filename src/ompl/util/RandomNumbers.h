@@ -57,6 +57,34 @@ namespace ompl
     class RNG
     {
     public:
+        /** \brief While an instance of this class exists, RNG instances that the same thread creates with the
+            default constructor take their seeds from a sequence determined by \e seed instead of from the global
+            seed generator. This makes code that creates its own RNGs (e.g., planners and their samplers)
+            repeatable even when other threads create RNGs at the same time. Instances can be nested; the most
+            recently created one is used. */
+        class ScopedThreadSeed
+        {
+        public:
+            explicit ScopedThreadSeed(std::uint_fast32_t seed);
+
+            ~ScopedThreadSeed();
+
+            ScopedThreadSeed(const ScopedThreadSeed &) = delete;
+            ScopedThreadSeed &operator=(const ScopedThreadSeed &) = delete;
+
+        private:
+            friend class RNG;
+
+            /** \brief Return the next seed of the sequence */
+            std::uint_fast32_t nextSeed();
+
+            std::ranlux24_base generator_;
+            std::uniform_int_distribution<std::uint_fast32_t> distribution_{1, 1000000000};
+
+            /** \brief The instance that was in effect when this one was created */
+            ScopedThreadSeed *previous_;
+        };
+
         /** \brief Constructor. Always sets a different random seed */
         RNG();
 
@@ -0,0 +1,124 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2026, the MROR Multi-Robot OMPL contributors
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+/* Author: MROR Multi-Robot OMPL contributors */
+
+#ifndef OMPL_UTIL_WORKER_POOL_
+#define OMPL_UTIL_WORKER_POOL_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ompl
+{
+    /** \brief A fixed set of threads that run the iterations of parallel loops. The threads are started
+        once and wait for the next loop between calls to parallelFor(), so a pool is cheap to use for loops
+        of a few iterations that run many times. The thread that calls parallelFor() takes part in the loop,
+        so a pool of \e n threads starts \e n - 1 workers. */
+    class WorkerPool
+    {
+    public:
+        /** \brief Start a pool of \e numThreads threads (including the caller of parallelFor()). If given,
+            \e onStart(thread) is called by every worker before its first loop, e.g. to place it on a core. */
+        explicit WorkerPool(unsigned int numThreads, std::function<void(unsigned int)> onStart = {});
+
+        /** \brief Stop the workers */
+        ~WorkerPool();
+
+        WorkerPool(const WorkerPool &) = delete;
+        WorkerPool &operator=(const WorkerPool &) = delete;
+
+        /** \brief Get the number of threads of the pool, including the caller of parallelFor() */
+        unsigned int getNumThreads() const
+        {
+            return workers_.size() + 1;
+        }
+
+        /** \brief Run \e job(thread, i) for every i in [0, \e count) and return once all iterations are done.
+            \e thread is in [0, getNumThreads()) and identifies the thread running the iteration; 0 is the
+            caller. Iterations are handed out one at a time, so their cost may vary. Loops started from
+            several threads run one after the other; \e job must not throw or start a loop on the same pool. */
+        void parallelFor(std::size_t count, const std::function<void(unsigned int, std::size_t)> &job);
+
+    private:
+        /** \brief The main function of worker \e thread */
+        void work(unsigned int thread);
+
+        /** \brief Run iterations of the current loop on \e thread until there are none left */
+        void runIterations(unsigned int thread);
+
+        /** \brief The worker threads */
+        std::vector<std::thread> workers_;
+
+        /** \brief Called by every worker before its first loop */
+        std::function<void(unsigned int)> onStart_;
+
+        /** \brief Held by the caller of parallelFor() for the whole loop */
+        std::mutex loopMutex_;
+
+        /** \brief Protects the state of the current loop */
+        std::mutex mutex_;
+
+        /** \brief Signals the workers that a loop started or that the pool stops */
+        std::condition_variable start_;
+
+        /** \brief Signals the caller that all workers finished the loop */
+        std::condition_variable done_;
+
+        /** \brief The job of the current loop */
+        const std::function<void(unsigned int, std::size_t)> *job_{nullptr};
+
+        /** \brief The number of iterations of the current loop */
+        std::size_t count_{0};
+
+        /** \brief The next iteration to hand out */
+        std::atomic<std::size_t> next_{0};
+
+        /** \brief The number of workers still running the current loop */
+        unsigned int busy_{0};
+
+        /** \brief The number of loops started, so that workers see each loop once */
+        unsigned long generation_{0};
+
+        /** \brief Flag telling the workers to stop */
+        bool stop_{false};
+    };
+}
+
+#endif
@@ -35,10 +35,14 @@
 /* Author: Ioan Sucan */
 
 #include "ompl/util/Console.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
 #include <mutex>
 #include <iostream>
 #include <cstdio>
 #include <cstdarg>
+#include <thread>
 #ifdef _WIN32
 #include <stdio.h>
 #include <io.h>
@@ -68,9 +72,12 @@ struct DefaultOutputHandler
     }
 
     ompl::msg::OutputHandlerSTD std_output_handler_;
-    ompl::msg::OutputHandler *output_handler_;
+    // read without holding lock_ when logging
+    std::atomic<ompl::msg::OutputHandler *> output_handler_;
     ompl::msg::OutputHandler *previous_output_handler_;
-    ompl::msg::LogLevel logLevel_;
+    std::atomic<ompl::msg::LogLevel> logLevel_;
+    std::atomic<unsigned int> rateLimit_{0};
+    std::atomic<std::size_t> rateLimited_{0};
     std::mutex lock_;  // it is likely the outputhandler does some I/O, so we serialize it
 };
 
@@ -95,21 +102,19 @@ static DefaultOutputHandler *getDOH()
 void ompl::msg::noOutputHandler()
 {
     USE_DOH;
-    doh->previous_output_handler_ = doh->output_handler_;
-    doh->output_handler_ = nullptr;
+    doh->previous_output_handler_ = doh->output_handler_.exchange(nullptr);
 }
 
 void ompl::msg::restorePreviousOutputHandler()
 {
     USE_DOH;
-    std::swap(doh->previous_output_handler_, doh->output_handler_);
+    doh->previous_output_handler_ = doh->output_handler_.exchange(doh->previous_output_handler_);
 }
 
 void ompl::msg::useOutputHandler(OutputHandler *oh)
 {
     USE_DOH;
-    doh->previous_output_handler_ = doh->output_handler_;
-    doh->output_handler_ = oh;
+    doh->previous_output_handler_ = doh->output_handler_.exchange(oh);
 }
 
 ompl::msg::OutputHandler *ompl::msg::getOutputHandler()
@@ -119,9 +124,11 @@ ompl::msg::OutputHandler *ompl::msg::getOutputHandler()
 
 void ompl::msg::log(const char *file, int line, LogLevel level, const char *m, ...)
 {
-    USE_DOH;
-    if ((doh->output_handler_ != nullptr) && level >= doh->logLevel_)
+    DefaultOutputHandler *doh = getDOH();
+    OutputHandler *oh = doh->output_handler_;
+    if ((oh != nullptr) && level >= doh->logLevel_)
     {
+        // format before serializing, so that only the output handler is serialized
         va_list __ap;
         va_start(__ap, m);
         char buf[MAX_BUFFER_SIZE];
@@ -129,7 +136,14 @@ void ompl::msg::log(const char *file, int line, LogLevel level, const char *m, .
         va_end(__ap);
         buf[MAX_BUFFER_SIZE - 1] = '\0';
 
-        doh->output_handler_->log(buf, level, file, line);
+        if (oh->isThreadSafe())
+            oh->log(buf, level, file, line);
+        else
+        {
+            std::lock_guard<std::mutex> slock(doh->lock_);
+            if ((oh = doh->output_handler_) != nullptr)
+                oh->log(buf, level, file, line);
+        }
     }
 }
 
@@ -145,6 +159,42 @@ ompl::msg::LogLevel ompl::msg::getLogLevel()
     return doh->logLevel_;
 }
 
+void ompl::msg::setRateLimit(unsigned int messagesPerSecond)
+{
+    getDOH()->rateLimit_ = messagesPerSecond;
+}
+
+unsigned int ompl::msg::getRateLimit()
+{
+    return getDOH()->rateLimit_;
+}
+
+std::size_t ompl::msg::getRateLimitedCount()
+{
+    return getDOH()->rateLimited_;
+}
+
+bool ompl::msg::RateLimiter::allow(LogLevel level)
+{
+    DefaultOutputHandler *doh = getDOH();
+    if (level < doh->logLevel_.load(std::memory_order_relaxed))
+        return false;
+    const unsigned int limit = doh->rateLimit_.load(std::memory_order_relaxed);
+    if (limit == 0 || level >= LOG_ERROR)
+        return true;
+
+    // start a new window once a second has passed since the current one started
+    const long long now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                              std::chrono::steady_clock::now().time_since_epoch()).count();
+    long long start = windowStart_.load(std::memory_order_relaxed);
+    if (now - start >= 1000000000LL && windowStart_.compare_exchange_strong(start, now, std::memory_order_relaxed))
+        count_.store(0, std::memory_order_relaxed);
+    if (count_.fetch_add(1, std::memory_order_relaxed) < limit)
+        return true;
+    doh->rateLimited_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
 static const char *LogLevelString[6] = {"Dev2:    ", "Dev1:    ", "Debug:   ", "Info:    ", "Warning: ", "Error:   "};
 static const char *LogColorString[6] = {ANSI_COLOR_MAGENTA, ANSI_COLOR_GREEN,  ANSI_COLOR_BLUE,
                                         ANSI_COLOR_CYAN,    ANSI_COLOR_YELLOW, ANSI_COLOR_RED};
@@ -156,8 +206,8 @@ void ompl::msg::OutputHandlerSTD::log(const std::string &text, LogLevel level, c
         bool isTTY(isatty(fileno(stderr)) != 0);
         if (isTTY)
             std::cerr << LogColorString[level + 2];
-        std::cerr << LogLevelString[level + 2] << text << std::endl;
-        std::cerr << "         at line " << line << " in " << filename << std::endl;
+        std::cerr << LogLevelString[level + 2] << text << '\n';
+        std::cerr << "         at line " << line << " in " << filename << '\n';
         if (isTTY)
             std::cerr << ANSI_COLOR_RESET;
         std::cerr.flush();
@@ -167,7 +217,7 @@ void ompl::msg::OutputHandlerSTD::log(const std::string &text, LogLevel level, c
         bool isTTY(isatty(fileno(stdout)) != 0);
         if (isTTY)
             std::cout << LogColorString[level + 2];
-        std::cout << LogLevelString[level + 2] << text << std::endl;
+        std::cout << LogLevelString[level + 2] << text << '\n';
         if (isTTY)
             std::cout << ANSI_COLOR_RESET;
         std::cout.flush();
@@ -198,3 +248,156 @@ void ompl::msg::OutputHandlerFile::log(const std::string &text, LogLevel level,
         fflush(file_);
     }
 }
+
+/// @cond IGNORE
+struct ompl::msg::OutputHandlerAsync::Impl
+{
+    // a slot of the ring buffer; sequence tells whether the slot is free to be written (sequence == position)
+    // or holds a message to be read (sequence == position + 1)
+    struct Slot
+    {
+        std::atomic<std::size_t> sequence;
+        std::string text;
+        LogLevel level;
+        const char *filename;
+        int line;
+    };
+
+    Impl(OutputHandler *handler, std::size_t capacity) : handler_(handler)
+    {
+        std::size_t size = 2;
+        while (size < capacity)
+            size *= 2;
+        mask_ = size - 1;
+        slots_.reset(new Slot[size]);
+        for (std::size_t i = 0; i < size; ++i)
+            slots_[i].sequence.store(i, std::memory_order_relaxed);
+        thread_ = std::thread([this] { run(); });
+    }
+
+    // called by any number of logging threads
+    void push(const std::string &text, LogLevel level, const char *filename, int line)
+    {
+        std::size_t pos = head_.load(std::memory_order_relaxed);
+        Slot *slot;
+        for (;;)
+        {
+            slot = &slots_[pos & mask_];
+            const std::size_t sequence = slot->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos);
+            if (diff == 0)
+            {
+                if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0)
+            {
+                // the buffer is full
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            else
+                pos = head_.load(std::memory_order_relaxed);
+        }
+        slot->text = text;
+        slot->level = level;
+        slot->filename = filename;
+        slot->line = line;
+        slot->sequence.store(pos + 1, std::memory_order_release);
+        wake_.notify_one();
+    }
+
+    // pass on the messages available in the buffer; called by the background thread only
+    bool drain()
+    {
+        bool any = false;
+        for (;;)
+        {
+            Slot &slot = slots_[tail_ & mask_];
+            if (slot.sequence.load(std::memory_order_acquire) != tail_ + 1)
+                break;
+            std::string text = std::move(slot.text);
+            const LogLevel level = slot.level;
+            const char *filename = slot.filename;
+            const int line = slot.line;
+            slot.sequence.store(tail_ + mask_ + 1, std::memory_order_release);
+            ++tail_;
+            any = true;
+
+            const std::size_t dropped = dropped_.load(std::memory_order_relaxed);
+            if (dropped != reportedDropped_)
+            {
+                handler_->log(std::to_string(dropped - reportedDropped_) +
+                                  " log messages were dropped because the log buffer was full",
+                              LOG_WARN, __FILE__, __LINE__);
+                reportedDropped_ = dropped;
+            }
+            handler_->log(text, level, filename, line);
+            passedOn_.store(tail_, std::memory_order_release);
+        }
+        return any;
+    }
+
+    void run()
+    {
+        for (;;)
+        {
+            if (drain())
+                continue;
+            if (stop_.load(std::memory_order_acquire))
+            {
+                drain();
+                break;
+            }
+            // producers do not take the mutex, so a notification can be missed; the timeout bounds the delay
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait_for(lock, std::chrono::milliseconds(10));
+        }
+    }
+
+    OutputHandler *handler_;
+    std::unique_ptr<Slot[]> slots_;
+    std::size_t mask_;
+    std::atomic<std::size_t> head_{0};
+    std::size_t tail_{0};
+    std::atomic<std::size_t> passedOn_{0};
+    std::atomic<std::size_t> dropped_{0};
+    std::size_t reportedDropped_{0};
+    std::atomic<bool> stop_{false};
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::thread thread_;
+};
+/// @endcond
+
+ompl::msg::OutputHandlerAsync::OutputHandlerAsync(OutputHandler *handler, std::size_t capacity)
+  : impl_(new Impl(handler, capacity))
+{
+}
+
+ompl::msg::OutputHandlerAsync::~OutputHandlerAsync()
+{
+    impl_->stop_.store(true, std::memory_order_release);
+    impl_->wake_.notify_one();
+    impl_->thread_.join();
+}
+
+void ompl::msg::OutputHandlerAsync::log(const std::string &text, LogLevel level, const char *filename, int line)
+{
+    impl_->push(text, level, filename, line);
+}
+
+void ompl::msg::OutputHandlerAsync::flush()
+{
+    const std::size_t target = impl_->head_.load(std::memory_order_relaxed);
+    while (impl_->passedOn_.load(std::memory_order_acquire) < target)
+    {
+        impl_->wake_.notify_one();
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+}
+
+std::size_t ompl::msg::OutputHandlerAsync::getDroppedCount() const
+{
+    return impl_->dropped_.load(std::memory_order_relaxed);
+}
@@ -125,6 +125,9 @@ namespace
         std::call_once(g_once, &initRNGSeedGenerator);
         return *g_RNGSeedGenerator;
     }
+
+    // the seed sequence in effect for RNGs created by the current thread, if any
+    thread_local ompl::RNG::ScopedThreadSeed *g_threadSeed = nullptr;
 }  // namespace
 /// @endcond
 
@@ -215,8 +218,23 @@ void ompl::RNG::setSeed(std::uint_fast32_t seed)
     getRNGSeedGenerator().setSeed(seed);
 }
 
+ompl::RNG::ScopedThreadSeed::ScopedThreadSeed(std::uint_fast32_t seed) : generator_(seed), previous_(g_threadSeed)
+{
+    g_threadSeed = this;
+}
+
+ompl::RNG::ScopedThreadSeed::~ScopedThreadSeed()
+{
+    g_threadSeed = previous_;
+}
+
+std::uint_fast32_t ompl::RNG::ScopedThreadSeed::nextSeed()
+{
+    return distribution_(generator_);
+}
+
 ompl::RNG::RNG()
-  : localSeed_(getRNGSeedGenerator().nextSeed())
+  : localSeed_(g_threadSeed != nullptr ? g_threadSeed->nextSeed() : getRNGSeedGenerator().nextSeed())
   , generator_(localSeed_)
   , sphericalDataPtr_(std::make_shared<SphericalData>(&generator_))
 {
@@ -0,0 +1,110 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2026, the MROR Multi-Robot OMPL contributors
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+/* Author: MROR Multi-Robot OMPL contributors */
+
+#include "ompl/util/WorkerPool.h"
+
+ompl::WorkerPool::WorkerPool(unsigned int numThreads, std::function<void(unsigned int)> onStart)
+  : onStart_(std::move(onStart))
+{
+    for (unsigned int t = 1; t < numThreads; ++t)
+        workers_.emplace_back(&WorkerPool::work, this, t);
+}
+
+ompl::WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    start_.notify_all();
+    for (auto &worker : workers_)
+        worker.join();
+}
+
+void ompl::WorkerPool::parallelFor(std::size_t count, const std::function<void(unsigned int, std::size_t)> &job)
+{
+    if (workers_.empty() || count <= 1)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+            job(0, i);
+        return;
+    }
+
+    std::lock_guard<std::mutex> loop(loopMutex_);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        job_ = &job;
+        count_ = count;
+        next_ = 0;
+        busy_ = workers_.size();
+        ++generation_;
+    }
+    start_.notify_all();
+    runIterations(0);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this] { return busy_ == 0; });
+    job_ = nullptr;
+}
+
+void ompl::WorkerPool::work(unsigned int thread)
+{
+    if (onStart_)
+        onStart_(thread);
+    unsigned long seen = 0;
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            start_.wait(lock, [this, seen] { return stop_ || generation_ != seen; });
+            if (stop_)
+                return;
+            seen = generation_;
+        }
+        runIterations(thread);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (--busy_ == 0)
+                done_.notify_one();
+        }
+    }
+}
+
+void ompl::WorkerPool::runIterations(unsigned int thread)
+{
+    for (std::size_t i = next_++; i < count_; i = next_++)
+        (*job_)(thread, i);
+}
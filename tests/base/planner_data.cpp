@@ -38,10 +38,12 @@
 #include <boost/test/unit_test.hpp>
 #include <boost/serialization/export.hpp>
 #include <iostream>
+#include <sstream>
 #include <vector>
 
 #include "ompl/base/PlannerData.h"
 #include "ompl/base/PlannerDataStorage.h"
+#include "ompl/base/PlannerDataStream.h"
 #include "ompl/base/spaces/RealVectorStateSpace.h"
 
 using namespace ompl;
@@ -563,3 +565,111 @@ BOOST_AUTO_TEST_CASE(Serialization)
     for (auto & state : states)
         space->freeState(state);
 }
+
+/* A sink that records what it receives */
+class RecordingSink : public base::PlannerDataSink
+{
+public:
+    void beginSection(const std::string &name, const base::StateSpace *space) override
+    {
+        sections.push_back(name);
+        space_ = space;
+    }
+
+    void vertex(std::uint64_t id, const base::State *state, VertexType type) override
+    {
+        ids.push_back(id);
+        types.push_back(type);
+        values.push_back(state != nullptr ? state->as<base::RealVectorStateSpace::StateType>()->values[0] : -1.);
+    }
+
+    void edge(std::uint64_t from, std::uint64_t to) override
+    {
+        edges.emplace_back(from, to);
+    }
+
+    void property(std::uint64_t id, const std::string &name, const std::string &value) override
+    {
+        properties.push_back(std::to_string(id) + " " + name + "=" + value);
+    }
+
+    void endSection() override
+    {
+        ++ended;
+    }
+
+    std::vector<std::string> sections;
+    std::vector<std::uint64_t> ids;
+    std::vector<VertexType> types;
+    std::vector<double> values;
+    std::vector<std::pair<std::uint64_t, std::uint64_t>> edges;
+    std::vector<std::string> properties;
+    unsigned int ended{0};
+
+private:
+    const base::StateSpace *space_{nullptr};
+};
+
+BOOST_AUTO_TEST_CASE(BinaryStream)
+{
+    auto space(std::make_shared<base::RealVectorStateSpace>(2));
+    space->setBounds(-1000., 1000.);
+    space->setup();
+    auto si(std::make_shared<base::SpaceInformation>(space));
+    base::PlannerData data(si);
+    std::vector<base::State *> states;
+    for (unsigned int i = 0; i < 100; ++i)
+    {
+        states.push_back(space->allocState());
+        states.back()->as<base::RealVectorStateSpace::StateType>()->values[0] = i;
+        states.back()->as<base::RealVectorStateSpace::StateType>()->values[1] = -(double)i;
+    }
+    data.addStartVertex(base::PlannerDataVertex(states[0]));
+    for (unsigned int i = 1; i < states.size(); ++i)
+        data.addEdge(base::PlannerDataVertex(states[i - 1]), base::PlannerDataVertex(states[i]));
+    data.markGoalState(states.back());
+
+    std::stringstream stream;
+    {
+        base::PlannerDataBinaryWriter writer(stream);
+        base::PrefixedPlannerDataSink prefixed(writer, "robot 0: ");
+        prefixed.write("tree", data);
+        writer.beginSection("constraint tree", nullptr);
+        writer.vertex(7, nullptr, base::PlannerDataSink::START);
+        writer.property(7, "cost", "3");
+        writer.endSection();
+    }
+
+    RecordingSink sink;
+    base::PlannerDataBinaryReader reader(stream);
+    BOOST_REQUIRE(reader.read(sink, [&](const std::string &name) {
+        return name == space->getName() ? base::StateSpacePtr(space) : base::StateSpacePtr();
+    }));
+    BOOST_REQUIRE_EQUAL(sink.sections.size(), 2u);
+    BOOST_CHECK_EQUAL(sink.sections[0], "robot 0: tree");
+    BOOST_CHECK_EQUAL(sink.sections[1], "constraint tree");
+    BOOST_CHECK_EQUAL(sink.ended, 2u);
+    BOOST_REQUIRE_EQUAL(sink.ids.size(), states.size() + 1);
+    BOOST_CHECK_EQUAL(sink.edges.size(), states.size() - 1);
+    for (unsigned int i = 0; i < states.size(); ++i)
+    {
+        BOOST_CHECK_EQUAL(sink.ids[i], base::PlannerDataSink::idOf(states[i]));
+        BOOST_CHECK_EQUAL(sink.values[i], (double)i);
+    }
+    BOOST_CHECK_EQUAL(sink.types[0], base::PlannerDataSink::START);
+    BOOST_CHECK_EQUAL(sink.types[states.size() - 1], base::PlannerDataSink::GOAL);
+    BOOST_CHECK_EQUAL(sink.types[1], base::PlannerDataSink::PLAIN);
+    BOOST_CHECK_EQUAL(sink.values.back(), -1.);
+    BOOST_REQUIRE_EQUAL(sink.properties.size(), 1u);
+    BOOST_CHECK_EQUAL(sink.properties[0], "7 cost=3");
+
+    // a truncated stream is rejected
+    std::string truncated = stream.str().substr(0, stream.str().size() / 2);
+    std::stringstream in(truncated);
+    RecordingSink other;
+    base::PlannerDataBinaryReader truncatedReader(in);
+    BOOST_CHECK(!truncatedReader.read(other, {}));
+
+    for (auto &state : states)
+        space->freeState(state);
+}
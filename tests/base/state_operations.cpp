@@ -36,12 +36,15 @@
 
 #define BOOST_TEST_MODULE "State"
 #include <boost/test/unit_test.hpp>
+#include <cmath>
 #include <thread>
 #include <iostream>
 
 #include "ompl/base/ScopedState.h"
 #include "ompl/base/spaces/SE3StateSpace.h"
+#include "ompl/base/spaces/RealVectorStateSpace.h"
 #include "ompl/base/SpaceInformation.h"
+#include "ompl/base/goals/BatchGoalRegion.h"
 #include "ompl/util/Time.h"
 
 using namespace ompl;
@@ -321,3 +324,219 @@ BOOST_AUTO_TEST_CASE(PartialCopy)
         BOOST_CHECK(copyStateData(q, dummy.get(), r3, state[r3].get()) == base::NO_DATA_COPIED);
     }
 }
+
+BOOST_AUTO_TEST_CASE(BatchValidity)
+{
+    auto m(std::make_shared<base::RealVectorStateSpace>(2));
+    m->setBounds(0, 1);
+    auto si1(std::make_shared<base::SpaceInformation>(m));
+    auto si2(std::make_shared<base::SpaceInformation>(m));
+    // a wall at 0.4 <= x <= 0.6
+    si1->setStateValidityChecker([](const base::State *state)
+        {
+            double x = state->as<base::RealVectorStateSpace::StateType>()->values[0];
+            return x < 0.4 || x > 0.6;
+        });
+    unsigned int calls = 0;
+    si2->setBatchStateValidityChecker(
+        [&calls](const Eigen::Ref<const Eigen::MatrixXd> &states, Eigen::Ref<Eigen::VectorXd> valid)
+        {
+            ++calls;
+            BOOST_CHECK_EQUAL(states.cols(), 2);
+            valid = ((states.col(0).array() < 0.4) || (states.col(0).array() > 0.6)).cast<double>();
+        });
+    si1->setup();
+    si2->setup();
+    BOOST_CHECK(si2->getStateValidityChecker()->getSpecs().hasBatchValidityComputation);
+
+    base::ScopedState<> s1(m), s2(m), last1(m), last2(m);
+    for (int i = 0 ; i < 100 ; ++i)
+    {
+        do
+            s1.random();
+        while (!si1->isValid(s1.get()));
+        s2.random();
+        BOOST_CHECK_EQUAL(si1->isValid(s2.get()), si2->isValid(s2.get()));
+        BOOST_CHECK_EQUAL(si1->checkMotion(s1.get(), s2.get()), si2->checkMotion(s1.get(), s2.get()));
+
+        std::pair<base::State *, double> lastValid1(last1.get(), 0.), lastValid2(last2.get(), 0.);
+        bool valid = si1->checkMotion(s1.get(), s2.get(), lastValid1);
+        BOOST_CHECK_EQUAL(valid, si2->checkMotion(s1.get(), s2.get(), lastValid2));
+        if (!valid)
+        {
+            BOOST_CHECK_CLOSE(lastValid1.second, lastValid2.second, 1e-9);
+            BOOST_CHECK(last1 == last2);
+        }
+    }
+    // one call per state and one per motion
+    BOOST_CHECK_EQUAL(calls, 300u);
+}
+
+BOOST_AUTO_TEST_CASE(TimedBatchValidity)
+{
+    auto m(std::make_shared<base::RealVectorStateSpace>(2));
+    m->setBounds(0, 1);
+    auto si(std::make_shared<base::SpaceInformation>(m));
+    // a wall at 0.4 <= x <= 0.6 that only exists from time 1 on
+    unsigned int calls = 0;
+    si->setBatchStateValidityChecker(
+        [&calls](const Eigen::Ref<const Eigen::MatrixXd> &states, const Eigen::Ref<const Eigen::VectorXd> &times,
+                 Eigen::Ref<Eigen::VectorXd> valid)
+        {
+            ++calls;
+            BOOST_CHECK_EQUAL(states.rows(), times.size());
+            for (int i = 0; i < states.rows(); ++i)
+                valid[i] = (!std::isnan(times[i]) && times[i] < 1.) || states(i, 0) < 0.4 || states(i, 0) > 0.6;
+        });
+    si->setup();
+    const base::StateValidityCheckerPtr &checker = si->getStateValidityChecker();
+    BOOST_CHECK(checker->getSpecs().hasBatchValidityComputation);
+
+    base::ScopedState<> inWall(m), outside(m);
+    inWall[0] = inWall[1] = outside[1] = 0.5;
+    outside[0] = 0.1;
+    // without a time, the wall is there
+    BOOST_CHECK(!si->isValid(inWall.get()));
+    BOOST_CHECK(si->isValid(outside.get()));
+
+    std::vector<const base::State *> states{inWall.get(), outside.get(), inWall.get(), outside.get()};
+    std::vector<double> times{0.5, 0.5, 1.5, 1.5};
+    std::vector<int> valid;
+    checker->areValid(states, times, valid);
+    BOOST_CHECK(valid == std::vector<int>({1, 1, 0, 1}));
+    BOOST_CHECK_EQUAL(calls, 3u);
+}
+
+/* A state conflicts with a dynamic obstacle closer than 0.1 */
+class DiskValidityChecker : public base::StateValidityChecker
+{
+public:
+    DiskValidityChecker(const base::SpaceInformationPtr &si) : base::StateValidityChecker(si)
+    {
+    }
+
+    bool isValid(const base::State *) const override
+    {
+        return true;
+    }
+
+    bool areStatesValid(const base::State *state1,
+                        const std::pair<const base::SpaceInformationPtr, const base::State *> state2) const override
+    {
+        return si_->distance(state1, state2.second) > 0.1;
+    }
+};
+
+BOOST_AUTO_TEST_CASE(DynamicTrajectoryWindow)
+{
+    auto m(std::make_shared<base::RealVectorStateSpace>(1));
+    m->setBounds(0, 10);
+    auto si(std::make_shared<base::SpaceInformation>(m));
+    si->setStateValidityChecker(std::make_shared<DiskValidityChecker>(si));
+    si->setup();
+
+    // the obstacle moves from 0 to 4 in steps of 1, one step every 0.5 time units
+    auto trajectory = std::make_shared<std::vector<base::State *>>();
+    for (int i = 0; i < 5; ++i)
+    {
+        trajectory->push_back(si->allocState());
+        trajectory->back()->as<base::RealVectorStateSpace::StateType>()->values[0] = i;
+    }
+    si->addDynamicObstacle(0.5, 2, 6, si, trajectory);
+
+    base::ScopedState<> s(m);
+    auto checker = si->getStateValidityChecker();
+    s[0] = 1.;
+    BOOST_CHECK(checker->isValid(s.get(), 0.5));  // before the window
+    s[0] = 2.;
+    BOOST_CHECK(!checker->isValid(s.get(), 1.0)); // step 2
+    BOOST_CHECK(checker->isValid(s.get(), 1.5));
+    s[0] = 4.;
+    BOOST_CHECK(!checker->isValid(s.get(), 3.0)); // step 6: past the end of the trajectory, at its last state
+    BOOST_CHECK(checker->isValid(s.get(), 3.5));  // after the window
+
+    // obstacles share the states, clearing them does not free the trajectory
+    si->clearDynamicObstacles();
+    BOOST_CHECK(checker->isValid(s.get(), 2.0));
+    BOOST_CHECK_EQUAL(trajectory.use_count(), 1);
+    for (auto *state : *trajectory)
+        si->freeState(state);
+}
+
+BOOST_AUTO_TEST_CASE(InheritedDynamicObstacles)
+{
+    auto m(std::make_shared<base::RealVectorStateSpace>(1));
+    m->setBounds(0, 10);
+    auto si(std::make_shared<base::SpaceInformation>(m));
+    si->setStateValidityChecker(std::make_shared<DiskValidityChecker>(si));
+    si->setup();
+    auto checker = si->getStateValidityChecker();
+
+    // the scoped obstacle is at 2 at time 1
+    auto obstacles(std::make_shared<base::DynamicObstacles>());
+    base::State *obstacle = si->allocState();
+    obstacle->as<base::RealVectorStateSpace::StateType>()->values[0] = 2.;
+    obstacles->add(1., si, obstacle);
+    base::ScopedState<> s(m);
+    s[0] = 2.;
+
+    base::StateValidityChecker::ScopedDynamicObstacles scope(*checker, obstacles);
+    BOOST_CHECK(!checker->isValid(s.get(), 1.));
+    const base::StateValidityChecker::ScopedDynamicObstacles *current =
+        base::StateValidityChecker::ScopedDynamicObstacles::current();
+    BOOST_CHECK(current == &scope);
+
+    // another thread only sees the scoped obstacles while it inherits them
+    bool before = false, inherited = true, after = false;
+    std::thread worker([&]
+                       {
+                           before = checker->isValid(s.get(), 1.);
+                           {
+                               base::StateValidityChecker::ScopedDynamicObstacles::Inherit inherit(current);
+                               inherited = checker->isValid(s.get(), 1.);
+                           }
+                           after = checker->isValid(s.get(), 1.);
+                       });
+    worker.join();
+    BOOST_CHECK(before);
+    BOOST_CHECK(!inherited);
+    BOOST_CHECK(after);
+}
+
+BOOST_AUTO_TEST_CASE(BatchGoal)
+{
+    auto m(std::make_shared<base::RealVectorStateSpace>(2));
+    m->setBounds(0, 1);
+    auto si(std::make_shared<base::SpaceInformation>(m));
+    si->setup();
+    unsigned int calls = 0;
+    // the goal is the band 0.4 < x < 0.6
+    base::BatchGoalRegion goal(si,
+        [&calls](const Eigen::Ref<const Eigen::MatrixXd> &states, Eigen::Ref<Eigen::VectorXd> distances)
+        {
+            ++calls;
+            distances = (states.col(0).array() - 0.5).abs().matrix();
+        });
+    goal.setThreshold(0.1);
+
+    std::vector<base::State *> states(50);
+    si->allocStates(states);
+    base::StateSamplerPtr sampler = m->allocDefaultStateSampler();
+    for (auto &state : states)
+        sampler->sampleUniform(state);
+    std::vector<int> satisfied;
+    std::vector<double> distances;
+    goal.areSatisfied(std::vector<const base::State *>(states.begin(), states.end()), satisfied, distances);
+    BOOST_CHECK_EQUAL(calls, 1u);
+    for (std::size_t i = 0; i < states.size(); ++i)
+    {
+        double d = std::fabs(states[i]->as<base::RealVectorStateSpace::StateType>()->values[0] - 0.5);
+        BOOST_CHECK_CLOSE(distances[i], d, 1e-9);
+        BOOST_CHECK_EQUAL(satisfied[i] != 0, d < 0.1);
+        double distance;
+        BOOST_CHECK_EQUAL(goal.isSatisfied(states[i], &distance), d < 0.1);
+        BOOST_CHECK_CLOSE(distance, d, 1e-9);
+    }
+    BOOST_CHECK_EQUAL(calls, 1u + states.size());
+    si->freeStates(states);
+}
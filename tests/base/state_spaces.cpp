@@ -85,6 +85,100 @@ BOOST_AUTO_TEST_CASE(Dubins_Simple)
     dsym->sanityChecks();
 }
 
+BOOST_AUTO_TEST_CASE(Dubins_PathCache)
+{
+    for (bool symmetric : {false, true})
+    {
+        auto d(std::make_shared<base::DubinsStateSpace>(.7, symmetric));
+        base::RealVectorBounds bounds2(2);
+        bounds2.setLow(-3);
+        bounds2.setHigh(3);
+        d->setBounds(bounds2);
+        d->setup();
+
+        base::StateSamplerPtr sampler = d->allocDefaultStateSampler();
+        base::State *from = d->allocState();
+        std::vector<base::State *> to(50);
+        for (auto &s : to)
+        {
+            s = d->allocState();
+            sampler->sampleUniform(s);
+        }
+        // include the start itself and a state that only differs in heading
+        d->copyState(to[0], from);
+        for (int i = 0; i < 20; ++i)
+        {
+            sampler->sampleUniform(from);
+            d->copyState(to[1], from);
+            to[1]->as<base::SE2StateSpace::StateType>()->setYaw(from->as<base::SE2StateSpace::StateType>()->getYaw() + 1.);
+            for (std::size_t j = 0; j < to.size(); ++j)
+            {
+                double expected = .7 * d->dubins(from, to[j]).length();
+                if (symmetric)
+                    expected = std::min(expected, .7 * d->dubins(to[j], from).length());
+                BOOST_OMPL_EXPECT_NEAR(d->distance(from, to[j]), expected, 1e-6);
+            }
+        }
+
+        // the cached path must not be reused once a state changes
+        double before = d->distance(from, to[2]);
+        BOOST_OMPL_EXPECT_NEAR(d->distance(from, to[2]), before, 1e-12);
+        to[2]->as<base::SE2StateSpace::StateType>()->setX(to[2]->as<base::SE2StateSpace::StateType>()->getX() + 1.);
+        double after = .7 * d->dubins(from, to[2]).length();
+        if (symmetric)
+            after = std::min(after, .7 * d->dubins(to[2], from).length());
+        BOOST_OMPL_EXPECT_NEAR(d->distance(from, to[2]), after, 1e-12);
+
+        d->freeState(from);
+        for (auto &s : to)
+            d->freeState(s);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(Dubins_Distances)
+{
+    for (bool symmetric : {false, true})
+    {
+        auto d(std::make_shared<base::DubinsStateSpace>(.7, symmetric));
+        base::RealVectorBounds bounds2(2);
+        bounds2.setLow(-3);
+        bounds2.setHigh(3);
+        d->setBounds(bounds2);
+        d->setup();
+
+        base::StateSamplerPtr sampler = d->allocDefaultStateSampler();
+        base::State *state = d->allocState();
+        std::vector<base::State *> others(50);
+        std::vector<double> from, to;
+        for (int i = 0; i < 20; ++i)
+        {
+            sampler->sampleUniform(state);
+            // include the state itself and a state that only differs in heading
+            for (std::size_t j = 0; j < others.size(); ++j)
+            {
+                others[j] = d->allocState();
+                if (j < 2)
+                    d->copyState(others[j], state);
+                else
+                    sampler->sampleUniform(others[j]);
+            }
+            others[1]->as<base::SE2StateSpace::StateType>()->setYaw(state->as<base::SE2StateSpace::StateType>()->getYaw() + 1.);
+            const std::vector<const base::State *> batch(others.begin(), others.end());
+            d->distances(state, batch, from);
+            d->distances(batch, state, to);
+            BOOST_REQUIRE_EQUAL(from.size(), others.size());
+            BOOST_REQUIRE_EQUAL(to.size(), others.size());
+            for (std::size_t j = 0; j < others.size(); ++j)
+            {
+                BOOST_OMPL_EXPECT_NEAR(from[j], d->distance(state, others[j]), 1e-6);
+                BOOST_OMPL_EXPECT_NEAR(to[j], d->distance(others[j], state), 1e-6);
+                d->freeState(others[j]);
+            }
+        }
+        d->freeState(state);
+    }
+}
+
 BOOST_AUTO_TEST_CASE(ReedsShepp_Simple)
 {
     auto d(std::make_shared<base::ReedsSheppStateSpace>());
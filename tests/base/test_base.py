@@ -92,10 +92,82 @@ class TestSO3(unittest.TestCase):
             si.freeState(state)
 
 
+class TestBatchValidity(unittest.TestCase):
+    def testSimple(self):
+        if not 'BatchStateValidityCheckerFn' in globals():
+            self.skipTest('NumPy support not available')
+        m = RealVectorStateSpace(2)
+        m.setBounds(0, 1)
+        calls = []
+
+        def areValid(states, valid):
+            # states is a NumPy view of all the states, one per row
+            calls.append(states.shape[0])
+            valid[:] = (states[:, 0] < 0.4) | (states[:, 0] > 0.6)
+
+        si = SpaceInformation(m)
+        si.setBatchStateValidityChecker(BatchStateValidityCheckerFn(areValid))
+        si.setup()
+        s1 = State(m)
+        s2 = State(m)
+        s1[0] = s1[1] = s2[1] = 0.1
+        s2[0] = 0.9
+        self.assertTrue(si.isValid(s1()))
+        self.assertFalse(si.checkMotion(s1(), s2()))
+        s2[0] = 0.3
+        self.assertTrue(si.checkMotion(s1(), s2()))
+        self.assertEqual(calls[0], 1)
+        self.assertTrue(all(n > 1 for n in calls[1:]))
+
+    def testTimed(self):
+        if not 'TimedBatchStateValidityCheckerFn' in globals():
+            self.skipTest('NumPy support not available')
+        m = RealVectorStateSpace(2)
+        m.setBounds(0, 1)
+
+        def areValid(states, times, valid):
+            # times are NaN for checks that do not know the time
+            valid[:] = (times < 1) | (states[:, 0] < 0.4) | (states[:, 0] > 0.6)
+
+        si = SpaceInformation(m)
+        si.setBatchStateValidityChecker(TimedBatchStateValidityCheckerFn(areValid))
+        si.setup()
+        s = State(m)
+        s[0] = s[1] = 0.5
+        self.assertFalse(si.isValid(s()))
+
+
+class TestBatchGoal(unittest.TestCase):
+    def testSimple(self):
+        if not 'BatchGoalFn' in globals():
+            self.skipTest('NumPy support not available')
+        m = RealVectorStateSpace(2)
+        m.setBounds(0, 1)
+        calls = []
+
+        def distances(states, dist):
+            # states is a NumPy view of all the states, one per row
+            calls.append(states.shape[0])
+            dist[:] = abs(states[:, 0] - 0.5)
+
+        si = SpaceInformation(m)
+        si.setup()
+        goal = BatchGoalRegion(si, BatchGoalFn(distances))
+        goal.setThreshold(0.1)
+        s = State(m)
+        s[0] = s[1] = 0.45
+        self.assertTrue(goal.isSatisfied(s()))
+        s[0] = 0.2
+        self.assertFalse(goal.isSatisfied(s()))
+        self.assertEqual(calls, [1, 1])
+
+
 def suite():
     suites = (
         unittest.makeSuite(TestSO2),
-        unittest.makeSuite(TestSO3))
+        unittest.makeSuite(TestSO3),
+        unittest.makeSuite(TestBatchValidity),
+        unittest.makeSuite(TestBatchGoal))
     return unittest.TestSuite(suites)
 
 if __name__ == '__main__':
@@ -37,9 +37,11 @@
 #define BOOST_TEST_MODULE "ControlPlanning"
 #include <boost/test/unit_test.hpp>
 #include <boost/filesystem.hpp>
+#include <algorithm>
 #include <iostream>
 
 #include "ompl/base/goals/GoalState.h"
+#include "ompl/control/SimpleDirectedControlSampler.h"
 #include "ompl/base/spaces/RealVectorStateSpace.h"
 #include "ompl/control/spaces/RealVectorControlSpace.h"
 #include "ompl/control/planners/rrt/RRT.h"
@@ -138,6 +140,23 @@ public:
     }
 };
 
+/** The motion model of myStatePropagator for many states at once */
+control::BatchStatePropagatorFn myBatchStatePropagator(const control::SpaceInformationPtr &si, unsigned int *calls)
+{
+    const base::RealVectorBounds &bounds = si->getStateSpace()->as<base::RealVectorStateSpace>()->getBounds();
+    return [bounds, calls](const Eigen::Ref<const Eigen::MatrixXd> &states,
+                           const Eigen::Ref<const Eigen::MatrixXd> &controls, double duration,
+                           Eigen::Ref<Eigen::MatrixXd> results)
+    {
+        if (calls != nullptr)
+            ++*calls;
+        results.leftCols(2) = states.leftCols(2) + duration * controls;
+        results.rightCols(2) = controls;
+        for (unsigned int i = 0; i < bounds.low.size(); ++i)
+            results.col(i) = results.col(i).cwiseMax(bounds.low[i]).cwiseMin(bounds.high[i]);
+    };
+}
+
 class myProjectionEvaluator : public base::ProjectionEvaluator
 {
 public:
@@ -338,6 +357,23 @@ protected:
     }
 };
 
+class RRTBatchTest : public TestPlanner
+{
+protected:
+    base::PlannerPtr newPlanner(const control::SpaceInformationPtr &si) override
+    {
+        // propagate the controls tried towards a sample together
+        si->setBatchStatePropagator(myBatchStatePropagator(si, nullptr));
+        si->setDirectedControlSamplerAllocator([](const control::SpaceInformation *si)
+            {
+                return std::make_shared<control::SimpleDirectedControlSampler>(si, 4);
+            });
+        auto rrt(std::make_shared<control::RRT>(si));
+        rrt->setIntermediateStates(true);
+        return rrt;
+    }
+};
+
 // A 2D workspace grid-decomposition for Syclop planners
 class SyclopDecomposition : public control::GridDecomposition
 {
@@ -532,10 +568,67 @@ BOOST_FIXTURE_TEST_SUITE(MyPlanTestFixture, PlanTest)
 
 OMPL_PLANNER_TEST(RRT, 99.0, 0.05)
 OMPL_PLANNER_TEST(RRTIntermediate, 99.0, 0.25)
+OMPL_PLANNER_TEST(RRTBatch, 99.0, 0.25)
 OMPL_PLANNER_TEST(KPIECE, 99.0, 0.05)
 OMPL_PLANNER_TEST(EST, 99.0, 0.05)
 OMPL_PLANNER_TEST(SyclopRRT, 99.0, 0.05)
 OMPL_PLANNER_TEST(SyclopEST, 99.0, 0.05)
 OMPL_PLANNER_TEST(PDST, 99.0, 0.05)
 
+BOOST_AUTO_TEST_CASE(control_BatchPropagation)
+{
+    control::SpaceInformationPtr si = mySpaceInformation(env);
+    unsigned int calls = 0;
+    si->setBatchStatePropagator(myBatchStatePropagator(si, &calls));
+    BOOST_CHECK(si->getStatePropagator()->canPropagateBatch());
+
+    const unsigned int n = 10;
+    control::ControlSamplerPtr cs = si->allocControlSampler();
+    base::ValidStateSamplerPtr vs = si->allocValidStateSampler();
+    std::vector<control::Control *> controls(n);
+    std::vector<base::State *> results(n);
+    si->allocStates(results);
+    base::State *start = si->allocState();
+    base::State *single = si->allocState();
+    for (auto &control : controls)
+        control = si->allocControl();
+
+    for (unsigned int t = 0; t < 20; ++t)
+    {
+        vs->sample(start);
+        std::vector<unsigned int> steps(n);
+        for (unsigned int i = 0; i < n; ++i)
+        {
+            cs->sample(controls[i]);
+            steps[i] = cs->sampleStepCount(si->getMinControlDuration(), si->getMaxControlDuration());
+        }
+        std::vector<const control::Control *> applied(controls.begin(), controls.end());
+
+        // one call per step of the longest propagation, and the same motions as one control at a time
+        std::vector<unsigned int> batchSteps(steps);
+        calls = 0;
+        si->propagateBatchWhileValid(start, applied, batchSteps, results);
+        BOOST_CHECK_LE(calls, *std::max_element(steps.begin(), steps.end()));
+        for (unsigned int i = 0; i < n; ++i)
+        {
+            BOOST_CHECK_EQUAL(si->propagateWhileValid(start, controls[i], steps[i], single), batchSteps[i]);
+            BOOST_CHECK(si->equalStates(single, results[i]));
+        }
+
+        batchSteps = steps;
+        si->propagateBatchWhileValidTest(start, applied, batchSteps, results, 3);
+        for (unsigned int i = 0; i < n; ++i)
+        {
+            BOOST_CHECK_EQUAL(si->propagateWhileValidTest(start, controls[i], steps[i], single, 3), batchSteps[i]);
+            BOOST_CHECK(si->equalStates(single, results[i]));
+        }
+    }
+
+    for (auto &control : controls)
+        si->freeControl(control);
+    si->freeStates(results);
+    si->freeState(start);
+    si->freeState(single);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
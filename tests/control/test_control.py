@@ -111,6 +111,12 @@ class MyStatePropagator(oc.StatePropagator):
         result[2] = control[0]
         result[3] = control[1]
 
+def propagateBatch(calls, states, controls, duration, results):
+    # all the states and controls are NumPy views, one per row
+    calls.append(states.shape[0])
+    results[:, 0:2] = states[:, 0:2] + duration * controls
+    results[:, 2:4] = controls
+
 class TestPlanner(object):
 
     def execute(self, env, time, pathLength, show=False):
@@ -200,6 +206,15 @@ class RRTTest(TestPlanner):
         planner = oc.RRT(si)
         return planner
 
+class RRTBatchTest(TestPlanner):
+    def __init__(self):
+        self.calls = []
+
+    def newplanner(self, si):
+        si.setBatchStatePropagator(oc.BatchStatePropagatorFn(partial(propagateBatch, self.calls)))
+        planner = oc.RRT(si)
+        return planner
+
 class ESTTest(TestPlanner):
     def newplanner(self, si):
         planner = oc.EST(si)
@@ -305,6 +320,16 @@ class PlanTest(unittest.TestCase):
         self.assertTrue(avgruntime < 5)
         self.assertTrue(avglength < 100.0)
 
+    def testControl_RRTBatch(self):
+        if not hasattr(oc, 'BatchStatePropagatorFn') or not hasattr(ob, 'BatchStateValidityCheckerFn'):
+            self.skipTest('NumPy support not available')
+        planner = RRTBatchTest()
+        (success, avgruntime, avglength) = self.runPlanTest(planner)
+        self.assertTrue(success >= 99.0)
+        self.assertTrue(avgruntime < 5)
+        self.assertTrue(avglength < 100.0)
+        self.assertTrue(planner.calls)
+
     def testControl_EST(self):
         planner = ESTTest()
         (success, avgruntime, avglength) = self.runPlanTest(planner)
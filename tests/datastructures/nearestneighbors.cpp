@@ -44,11 +44,14 @@
 #include "ompl/datastructures/NearestNeighborsSqrtApprox.h"
 #include "ompl/datastructures/NearestNeighborsGNAT.h"
 #include "ompl/datastructures/NearestNeighborsGNATNoThreadSafety.h"
+#include "ompl/datastructures/NearestNeighborsPlanarGrid.h"
 #if OMPL_HAVE_FLANN
 #include "ompl/datastructures/NearestNeighborsFLANN.h"
 #endif
 #include "ompl/base/ScopedState.h"
 #include "ompl/base/spaces/DiscreteStateSpace.h"
+#include "ompl/base/spaces/DubinsStateSpace.h"
+#include "ompl/base/spaces/ReedsSheppStateSpace.h"
 #include "ompl/base/spaces/SE3StateSpace.h"
 
 using namespace ompl;
@@ -70,17 +73,28 @@ const double eps = 1e-6; // tolerance on distance for equality test
 // fixture
 struct NearestNeighborConfig
 {
-    NearestNeighborConfig() : space0(0, range)
+    NearestNeighborConfig() : space0(0, range), space2(0.5), space3(0.5, true), space4(0.5)
     {
         base::RealVectorBounds b(3);
         b.setLow(0);
         b.setHigh(1);
         space1.setBounds(b);
+        space5.setBounds(b);
+        base::RealVectorBounds b2(2);
+        b2.setLow(-2);
+        b2.setHigh(2);
+        space2.setBounds(b2);
+        space3.setBounds(b2);
+        space4.setBounds(b2);
     }
     ~NearestNeighborConfig() = default;
 
     base::DiscreteStateSpace space0;
     base::SE3StateSpace     space1;
+    base::DubinsStateSpace  space2;
+    base::DubinsStateSpace  space3;
+    base::ReedsSheppStateSpace space4;
+    base::RealVectorStateSpace space5{3};
 };
 
 // a GNAT with a small number of data points per leaf and small cache
@@ -101,7 +115,71 @@ public:
     {
     }
 };
+// the same GNATs, but with rebalancing enabled, so that subtrees get rebuilt
+template<typename _T>
+class NearestNeighborsGNATRebalancings : public NearestNeighborsGNAT<_T>
+{
+public:
+    NearestNeighborsGNATRebalancings() : NearestNeighborsGNAT<_T>(4,2,6,5,5,true)
+    {
+    }
+};
+template<typename _T>
+class NearestNeighborsGNATNoThreadSafetyRebalancings : public NearestNeighborsGNATNoThreadSafety<_T>
+{
+public:
+    NearestNeighborsGNATNoThreadSafetyRebalancings() : NearestNeighborsGNATNoThreadSafety<_T>(4,2,6,5,5,true)
+    {
+    }
+};
+// a GNAT that computes the distances to pivots in several threads, even for small nodes
+template<typename _T>
+class NearestNeighborsGNATParallelSplits : public NearestNeighborsGNAT<_T>
+{
+public:
+    NearestNeighborsGNATParallelSplits() : NearestNeighborsGNAT<_T>(4,2,6,5,5)
+    {
+        this->getPivotSelector().setNumThreads(3);
+        this->getPivotSelector().setMinParallelSize(1);
+    }
+};
+
+// a grid over the positions of SE(2) states, pruning with the heading bound for a turning radius of 0.5
+template<typename _T>
+class NearestNeighborsPlanarGrids : public NearestNeighborsPlanarGrid<_T>
+{
+public:
+    NearestNeighborsPlanarGrids() : NearestNeighborsPlanarGrid<_T>(
+        [](const base::State *s)
+        {
+            const auto *se2 = s->as<base::SE2StateSpace::StateType>();
+            return std::array<double, 2>{{se2->getX(), se2->getY()}};
+        },
+        [](const base::State *a, const base::State *b)
+        {
+            double d = std::fabs(a->as<base::SE2StateSpace::StateType>()->getYaw() -
+                b->as<base::SE2StateSpace::StateType>()->getYaw());
+            d = std::fmod(d, 2. * boost::math::constants::pi<double>());
+            return .5 * std::min(d, 2. * boost::math::constants::pi<double>() - d);
+        })
+    {
+    }
+};
 
+// planar grids that compute the distances of the candidates of each query in one call
+template <typename _T>
+class NearestNeighborsBatchPlanarGrids : public NearestNeighborsPlanarGrids<_T>
+{
+public:
+    NearestNeighborsBatchPlanarGrids(const base::DubinsStateSpace &space)
+    {
+        this->setBatchDistanceFunction([&space](const std::vector<base::State *> &from, base::State *const &to,
+                                                std::vector<double> &result)
+            {
+                space.distances(std::vector<const base::State *>(from.begin(), from.end()), to, result);
+            });
+    }
+};
 
 NearestNeighborConfig nnConfig;
 
@@ -312,6 +390,237 @@ NN_TEST_CASES(Linear, false)
 NN_TEST_CASES(SqrtApprox, true)
 NN_TEST_CASES(GNATs, false)
 NN_TEST_CASES(GNATNoThreadSafetys, false)
+NN_TEST_CASES(GNATRebalancings, false)
+NN_TEST_CASES(GNATNoThreadSafetyRebalancings, false)
+NN_TEST_CASES(GNATParallelSplits, false)
+
+// a GNAT that checks the subtree sizes of its nodes and lists its pivots
+template<typename GNAT>
+class GNATInternals : public GNAT
+{
+public:
+    // check that every node counts the elements stored in its subtree (including those marked for removal) and
+    // return the number of elements in the tree
+    std::size_t checkSubtreeSizes() const
+    {
+        return this->tree_ ? checkSubtreeSizes(this->tree_) : 0;
+    }
+
+    std::size_t numRemoved() const
+    {
+        return this->removed_.size();
+    }
+
+    // the pivots of the nodes below the root
+    void pivots(std::vector<base::State*> &pvts) const
+    {
+        pvts.clear();
+        if (this->tree_)
+            for (const auto *child : this->tree_->children_)
+                pivots(child, pvts);
+    }
+
+private:
+    template <typename Node>
+    std::size_t checkSubtreeSizes(const Node *node) const
+    {
+        std::size_t size = 1 + node->data_.size();
+        for (const auto *child : node->children_)
+            size += checkSubtreeSizes(child);
+        BOOST_CHECK_EQUAL(node->subtreeSize_, size);
+        return size;
+    }
+
+    template <typename Node>
+    void pivots(const Node *node, std::vector<base::State*> &pvts) const
+    {
+        pvts.push_back(node->pivot_);
+        for (const auto *child : node->children_)
+            pivots(child, pvts);
+    }
+};
+
+// remove pivots and points from a GNAT grown one element at a time, checking its subtree sizes and queries
+template<typename GNAT>
+void gnatRemovalTest(base::StateSpace &space)
+{
+    RNG rng;
+    base::StateSamplerPtr sampler(space.allocStateSampler());
+    GNATInternals<GNAT> proximity;
+    NearestNeighborsLinear<base::State*> proximityLinear;
+    auto distance = [&space](const base::State *a, const base::State *b) { return space.distance(a, b); };
+    proximity.setDistanceFunction(distance);
+    proximityLinear.setDistanceFunction(distance);
+    std::vector<base::State*> states, pvts, nghbr, nghbrGroundTruth;
+    base::State *query = space.allocState();
+
+    auto check = [&]()
+    {
+        BOOST_CHECK_EQUAL(proximity.size(), proximityLinear.size());
+        BOOST_CHECK_EQUAL(proximity.checkSubtreeSizes(), proximity.size() + proximity.numRemoved());
+        sampler->sampleUniform(query);
+        proximity.nearestK(query, k, nghbr);
+        proximityLinear.nearestK(query, k, nghbrGroundTruth);
+        BOOST_REQUIRE_EQUAL(nghbr.size(), nghbrGroundTruth.size());
+        for (std::size_t i = 0; i < nghbr.size(); ++i)
+            BOOST_OMPL_EXPECT_NEAR(space.distance(query, nghbr[i]), space.distance(query, nghbrGroundTruth[i]), eps);
+        double r = rng.uniformReal(0., 1.);
+        proximity.nearestR(query, r, nghbr);
+        proximityLinear.nearestR(query, r, nghbrGroundTruth);
+        BOOST_CHECK_EQUAL(nghbr.size(), nghbrGroundTruth.size());
+    };
+
+    for (unsigned int round = 0; round < 3; ++round)
+    {
+        for (int i = 0; i < n; ++i)
+        {
+            states.push_back(space.allocState());
+            sampler->sampleUniform(states.back());
+            proximity.add(states.back());
+            proximityLinear.add(states.back());
+        }
+        check();
+
+        // remove a few pivots, then a third of the remaining points
+        for (unsigned int i = 0; i < 10; ++i)
+        {
+            proximity.pivots(pvts);
+            if (pvts.empty())
+                break;
+            base::State *pivot = pvts[rng.uniformInt(0, pvts.size() - 1)];
+            BOOST_CHECK(proximity.remove(pivot));
+            proximityLinear.remove(pivot);
+            states.erase(std::find(states.begin(), states.end(), pivot));
+            space.freeState(pivot);
+            check();
+        }
+        for (std::size_t i = 0; i < states.size(); )
+            if (rng.uniform01() < 1. / 3.)
+            {
+                BOOST_CHECK(proximity.remove(states[i]));
+                proximityLinear.remove(states[i]);
+                space.freeState(states[i]);
+                states.erase(states.begin() + i);
+                if (i % 8 == 0)
+                    check();
+            }
+            else
+                ++i;
+        check();
+    }
+
+    space.freeState(query);
+    for (auto *state : states)
+        space.freeState(state);
+}
+
+BOOST_AUTO_TEST_CASE(GNATRemovals)
+{
+    gnatRemovalTest<NearestNeighborsGNATs<base::State*>>(nnConfig.space5);
+    gnatRemovalTest<NearestNeighborsGNATNoThreadSafetys<base::State*>>(nnConfig.space5);
+    gnatRemovalTest<NearestNeighborsGNATRebalancings<base::State*>>(nnConfig.space5);
+    gnatRemovalTest<NearestNeighborsGNATNoThreadSafetyRebalancings<base::State*>>(nnConfig.space5);
+}
+
+BOOST_AUTO_TEST_CASE(RealVectorBatchGNATs)
+{
+    // pivots are selected with Euclidean distances computed directly on the coordinates
+    NearestNeighborsGNATs<base::State*> proximity;
+    proximity.getPivotSelector().setBatchDistanceFunction(GreedyKCenters<base::State*>::euclideanDistances(
+        [](base::State *const &s) { return s->as<base::RealVectorStateSpace::StateType>()->values; }, 3));
+    stateSpaceTest(nnConfig.space5, proximity);
+}
+
+BOOST_AUTO_TEST_CASE(DubinsPlanarGrids)
+{
+    NearestNeighborsPlanarGrids<base::State*> proximity;
+    stateSpaceTest(nnConfig.space2, proximity);
+}
+BOOST_AUTO_TEST_CASE(SymmetricDubinsPlanarGrids)
+{
+    NearestNeighborsPlanarGrids<base::State*> proximity;
+    stateSpaceTest(nnConfig.space3, proximity);
+}
+BOOST_AUTO_TEST_CASE(ReedsSheppPlanarGrids)
+{
+    NearestNeighborsPlanarGrids<base::State*> proximity;
+    stateSpaceTest(nnConfig.space4, proximity);
+}
+
+BOOST_AUTO_TEST_CASE(DubinsBatchPlanarGrids)
+{
+    NearestNeighborsBatchPlanarGrids<base::State*> proximity(nnConfig.space2);
+    stateSpaceTest(nnConfig.space2, proximity);
+}
+BOOST_AUTO_TEST_CASE(SymmetricDubinsBatchPlanarGrids)
+{
+    NearestNeighborsBatchPlanarGrids<base::State*> proximity(nnConfig.space3);
+    stateSpaceTest(nnConfig.space3, proximity);
+}
+
+BOOST_AUTO_TEST_CASE(LargeCoordinatesPlanarGrids)
+{
+    // a few elements far apart: the cell size must follow their spread long before the grid is rebuilt for
+    // its number of elements, or queries that visit every cell take forever
+    base::DubinsStateSpace space(0.5);
+    base::RealVectorBounds bounds(2);
+    bounds.setLow(-1e6);
+    bounds.setHigh(1e6);
+    space.setBounds(bounds);
+    base::StateSamplerPtr sampler(space.allocStateSampler());
+
+    NearestNeighborsPlanarGrids<base::State*> proximity;
+    proximity.setDistanceFunction([&space](const base::State *a, const base::State *b)
+        {
+            return space.distance(a, b);
+        });
+    std::vector<base::State*> states(10), nghbr;
+    for (auto &state : states)
+    {
+        state = space.allocState();
+        sampler->sampleUniform(state);
+        proximity.add(state);
+    }
+    BOOST_CHECK_GT(proximity.getCellSize(), 1e3);
+    proximity.nearestK(states[0], 2 * states.size(), nghbr);
+    BOOST_CHECK_EQUAL(nghbr.size(), states.size());
+    BOOST_CHECK(nghbr[0] == states[0]);
+    for (auto &state : states)
+        space.freeState(state);
+}
+
+BOOST_AUTO_TEST_CASE(SpreadingOutPlanarGrids)
+{
+    // every element is much farther out than the ones before it, so each addition spreads the elements over
+    // too many cells; the grid must not be rebuilt (which changes the cell size here) for every one of them
+    base::DubinsStateSpace space(0.5);
+    NearestNeighborsPlanarGrids<base::State*> proximity;
+    std::vector<base::State*> states(100);
+    unsigned int rebuilds = 0;
+    double x = 1.;
+    for (auto &state : states)
+    {
+        state = space.allocState();
+        state->as<base::SE2StateSpace::StateType>()->setXY(x, 0.);
+        state->as<base::SE2StateSpace::StateType>()->setYaw(0.);
+        x *= 30.;
+        double cellSize = proximity.getCellSize();
+        proximity.add(state);
+        if (proximity.getCellSize() != cellSize)
+            ++rebuilds;
+    }
+    BOOST_CHECK_EQUAL(proximity.size(), states.size());
+    BOOST_CHECK_LT(rebuilds, 30u);
+    for (auto &state : states)
+        space.freeState(state);
+}
+
+BOOST_AUTO_TEST_CASE(RandomAccessPatternDubinsPlanarGrids)
+{
+    NearestNeighborsPlanarGrids<base::State*> proximity;
+    randomAccessPatternTest(nnConfig.space2, proximity);
+}
+
 #if OMPL_HAVE_FLANN
 NN_TEST_CASES(FLANNLinear, false)
 NN_TEST_CASES(FLANNHierarchicalClustering, true)
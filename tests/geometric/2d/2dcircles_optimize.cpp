@@ -50,6 +50,8 @@ OMPL_POP_CLANG
 #include "ompl/geometric/planners/informedtrees/ABITstar.h"
 #include "ompl/geometric/planners/informedtrees/BITstar.h"
 #include "ompl/geometric/planners/cforest/CForest.h"
+#include "ompl/geometric/planners/fmt/BFMT.h"
+#include "ompl/geometric/planners/fmt/FMT.h"
 #include "ompl/geometric/planners/informedtrees/EITstar.h"
 #include "ompl/geometric/planners/informedtrees/EIRMstar.h"
 #include "ompl/geometric/planners/prm/PRMstar.h"
@@ -303,6 +305,112 @@ protected:
     }
 };
 
+class RRTstarParallelTest : public TestPlanner
+{
+protected:
+
+    base::PlannerPtr newPlanner(const base::SpaceInformationPtr &si) const override
+    {
+        auto rrtstar(std::make_shared<geometric::RRTstar>(si));
+        rrtstar->setNumThreads(4);
+        return rrtstar;
+    }
+};
+
+class RRTstarBatchedTest : public TestPlanner
+{
+protected:
+
+    base::PlannerPtr newPlanner(const base::SpaceInformationPtr &si) const override
+    {
+        auto rrtstar(std::make_shared<geometric::RRTstar>(si));
+        rrtstar->setNumThreads(4);
+        rrtstar->setNeighborhoodBatchSize(8);
+        rrtstar->setTreePruning(true);
+        return rrtstar;
+    }
+};
+
+/** \brief FMT* that exposes its precomputed neighborhoods */
+class FMTNeighborhoods : public geometric::FMT
+{
+public:
+    using geometric::FMT::FMT;
+
+    /* check every precomputed neighborhood against the one computed on demand; return how many were checked */
+    std::size_t checkPrecomputed()
+    {
+        std::vector<Motion *> motions;
+        nn_->list(motions);
+        std::size_t rows = 0;
+        for (Motion *m : motions)
+        {
+            if (m->getNeighborhoodRow() == Motion::NO_ROW)
+                continue;
+            ++rows;
+            Neighborhood precomputed = getNeighborhood(m);
+            std::vector<Motion *> lazy;
+            nn_->nearestK(m, NNk_, lazy);
+            lazy.erase(lazy.begin());
+            BOOST_CHECK(std::vector<Motion *>(precomputed.begin(), precomputed.end()) == lazy);
+        }
+        return rows;
+    }
+
+    std::size_t getPrecomputedSize() const
+    {
+        return precomputedNeighbors_.size();
+    }
+
+    void precompute()
+    {
+        precomputeNeighborhoods(base::plannerNonTerminatingCondition());
+    }
+};
+
+class FMTPrecomputedTest : public TestPlanner
+{
+public:
+
+    void test2DCircles(const Circles2D &circles) override
+    {
+        base::SpaceInformationPtr si = geometric::spaceInformation2DCircles(circles);
+        auto pdef(std::make_shared<base::ProblemDefinition>(si));
+        setupProblem(circles.getQuery(0), si, pdef);
+
+        auto fmt(std::make_shared<FMTNeighborhoods>(si));
+        fmt->setPrecomputeNeighborhoods(true);
+        fmt->setNumThreads(4);
+        fmt->setProblemDefinition(pdef);
+        fmt->setup();
+        BOOST_CHECK(fmt->base::Planner::solve(10.0) == base::PlannerStatus::EXACT_SOLUTION);
+        BOOST_CHECK(fmt->checkPrecomputed() > 0);
+
+        // the samples did not change, so nothing is recomputed
+        const std::size_t size = fmt->getPrecomputedSize();
+        fmt->precompute();
+        BOOST_CHECK_EQUAL(fmt->getPrecomputedSize(), size);
+
+        pdef->clearSolutionPaths();
+        auto bfmt(std::make_shared<geometric::BFMT>(si));
+        bfmt->setPrecomputeNN(true);
+        bfmt->setNumThreads(4);
+        bfmt->setProblemDefinition(pdef);
+        bfmt->setup();
+        BOOST_CHECK(bfmt->base::Planner::solve(10.0) == base::PlannerStatus::EXACT_SOLUTION);
+    }
+
+protected:
+
+    base::PlannerPtr newPlanner(const base::SpaceInformationPtr &si) const override
+    {
+        auto fmt(std::make_shared<geometric::FMT>(si));
+        fmt->setPrecomputeNeighborhoods(true);
+        fmt->setNumThreads(4);
+        return fmt;
+    }
+};
+
 class PRMstarTest : public TestPlanner
 {
 protected:
@@ -443,8 +551,11 @@ OMPL_PLANNER_TEST(BITstar)
 OMPL_PLANNER_TEST(CForest)
 OMPL_PLANNER_TEST(EITstar)
 OMPL_PLANNER_TEST(EIRMstar)
+OMPL_PLANNER_TEST(FMTPrecomputed)
 OMPL_PLANNER_TEST(PRM)
 OMPL_PLANNER_TEST(PRMstar)
 OMPL_PLANNER_TEST(RRTstar)
+OMPL_PLANNER_TEST(RRTstarParallel)
+OMPL_PLANNER_TEST(RRTstarBatched)
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,354 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2026, the MROR Multi-Robot OMPL contributors
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+/* Author: MROR Multi-Robot OMPL contributors */
+
+#ifndef OMPL_TEST_MULTIROBOT_SCENARIOS_
+#define OMPL_TEST_MULTIROBOT_SCENARIOS_
+
+#include "ompl/multirobot/base/ProblemDefinition.h"
+#include "ompl/multirobot/control/SpaceInformation.h"
+#include "ompl/multirobot/control/PlanControl.h"
+#include "ompl/multirobot/geometric/PlanGeometric.h"
+#include "ompl/base/goals/GoalRegion.h"
+#include "ompl/base/spaces/RealVectorStateSpace.h"
+#include "ompl/control/spaces/RealVectorControlSpace.h"
+#include "ompl/control/planners/rrt/RRT.h"
+
+#include <array>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace ompl
+{
+    namespace multirobot
+    {
+        namespace test
+        {
+            /** \brief A synthetic multi-robot problem: disk robots of equal radius that move in a square workspace
+                with axis-aligned rectangular obstacles. */
+            struct Scenario
+            {
+                std::string name;
+                /** \brief The workspace is [0, size] x [0, size] */
+                double size{10.};
+                /** \brief The radius of every robot */
+                double radius{0.25};
+                /** \brief The distance to its goal at which a robot has arrived */
+                double goalThreshold{0.5};
+                /** \brief Rectangular obstacles as (xmin, ymin, xmax, ymax) */
+                std::vector<std::array<double, 4>> obstacles;
+                std::vector<std::array<double, 2>> starts;
+                std::vector<std::array<double, 2>> goals;
+            };
+
+            /** \brief \e n robots cross an empty field from left to right, reversing their vertical order */
+            inline Scenario openField(unsigned int n)
+            {
+                Scenario s;
+                s.name = "open_field_" + std::to_string(n);
+                for (unsigned int i = 0; i < n; ++i)
+                {
+                    const double y = s.size * (i + 1) / (n + 1);
+                    s.starts.push_back({1., y});
+                    s.goals.push_back({s.size - 1., s.size - y});
+                }
+                return s;
+            }
+
+            /** \brief Two robots exchange their positions along a line */
+            inline Scenario swap()
+            {
+                Scenario s;
+                s.name = "swap";
+                s.starts = {{{2., 5.}}, {{8., 5.}}};
+                s.goals = {{{8., 5.}}, {{2., 5.}}};
+                return s;
+            }
+
+            /** \brief Two robots pass each other in opposite directions through a corridor that is wide enough
+                for both, but only just */
+            inline Scenario corridor()
+            {
+                Scenario s;
+                s.name = "corridor";
+                s.obstacles = {{{3., 0., 7., 4.}}, {{3., 6., 7., 10.}}};
+                s.starts = {{{1., 5.}}, {{9., 5.}}};
+                s.goals = {{{9., 5.}}, {{1., 5.}}};
+                return s;
+            }
+
+            /** \brief \e n robots evenly spaced on a ring move to the antipodal positions, all passing near the
+                center */
+            inline Scenario ring(unsigned int n)
+            {
+                Scenario s;
+                s.name = "ring_" + std::to_string(n);
+                const double c = s.size / 2., r = 3.5;
+                for (unsigned int i = 0; i < n; ++i)
+                {
+                    const double a = 2. * M_PI * i / n;
+                    s.starts.push_back({c + r * std::cos(a), c + r * std::sin(a)});
+                    s.goals.push_back({c - r * std::cos(a), c - r * std::sin(a)});
+                }
+                return s;
+            }
+
+            /** \brief \e n pairs of robots exchange their positions, each pair in its own horizontal lane. The
+                lanes are 1.5 wide and walled off from each other, so that robots of different pairs never
+                interact and the robots of a pair are hard pressed to pass each other without coordinating */
+            inline Scenario lanes(unsigned int n)
+            {
+                Scenario s;
+                s.name = "lanes_" + std::to_string(n);
+                const double halfWidth = 0.75;
+                double wall = 0.;
+                for (unsigned int i = 0; i < n; ++i)
+                {
+                    const double y = s.size * (i + 1) / (n + 1);
+                    if (y - halfWidth > wall)
+                        s.obstacles.push_back({{0., wall, s.size, y - halfWidth}});
+                    wall = y + halfWidth;
+                    s.starts.push_back({2., y});
+                    s.goals.push_back({s.size - 2., y});
+                    s.starts.push_back({s.size - 2., y});
+                    s.goals.push_back({2., y});
+                }
+                s.obstacles.push_back({{0., wall, s.size, s.size}});
+                return s;
+            }
+
+            /** \brief Checks a disk robot against the workspace boundary, the obstacles and other robots */
+            class ScenarioValidityChecker : public ompl::base::StateValidityChecker
+            {
+            public:
+                ScenarioValidityChecker(const ompl::base::SpaceInformationPtr &si, const Scenario &s)
+                  : ompl::base::StateValidityChecker(si), scenario_(s)
+                {
+                }
+
+                bool isValid(const ompl::base::State *state) const override
+                {
+                    const double *p = state->as<ompl::base::RealVectorStateSpace::StateType>()->values;
+                    const double r = scenario_.radius;
+                    if (p[0] < r || p[1] < r || p[0] > scenario_.size - r || p[1] > scenario_.size - r)
+                        return false;
+                    for (const auto &o : scenario_.obstacles)
+                    {
+                        const double dx = std::max({o[0] - p[0], 0., p[0] - o[2]});
+                        const double dy = std::max({o[1] - p[1], 0., p[1] - o[3]});
+                        if (dx * dx + dy * dy <= r * r)
+                            return false;
+                    }
+                    return true;
+                }
+
+                bool areStatesValid(const ompl::base::State *state1,
+                                    const std::pair<const ompl::base::SpaceInformationPtr, const ompl::base::State *> state2) const override
+                {
+                    return inCollision(scenario_, state1, state2.second) == false;
+                }
+
+                /** \brief Return true if two robots of scenario \e s at \e state1 and \e state2 overlap */
+                static bool inCollision(const Scenario &s, const ompl::base::State *state1, const ompl::base::State *state2)
+                {
+                    const double *p1 = state1->as<ompl::base::RealVectorStateSpace::StateType>()->values;
+                    const double *p2 = state2->as<ompl::base::RealVectorStateSpace::StateType>()->values;
+                    return std::hypot(p1[0] - p2[0], p1[1] - p2[1]) <= 2. * s.radius;
+                }
+
+            private:
+                Scenario scenario_;
+            };
+
+            /** \brief The goal region of a robot: a disk around its goal position */
+            class ScenarioGoal : public ompl::base::GoalRegion
+            {
+            public:
+                ScenarioGoal(const ompl::base::SpaceInformationPtr &si, const std::array<double, 2> &goal, double threshold)
+                  : ompl::base::GoalRegion(si), goal_(goal)
+                {
+                    threshold_ = threshold;
+                }
+
+                double distanceGoal(const ompl::base::State *st) const override
+                {
+                    const double *p = st->as<ompl::base::RealVectorStateSpace::StateType>()->values;
+                    return std::hypot(p[0] - goal_[0], p[1] - goal_[1]);
+                }
+
+            private:
+                std::array<double, 2> goal_;
+            };
+
+            /** \brief The robots are single integrators: the control is their velocity */
+            inline void propagate(const ompl::base::State *start, const ompl::control::Control *control,
+                                  const double duration, ompl::base::State *result)
+            {
+                const double *p = start->as<ompl::base::RealVectorStateSpace::StateType>()->values;
+                const double *u = control->as<ompl::control::RealVectorControlSpace::ControlType>()->values;
+                double *q = result->as<ompl::base::RealVectorStateSpace::StateType>()->values;
+                q[0] = p[0] + u[0] * duration;
+                q[1] = p[1] + u[1] * duration;
+            }
+
+            inline ompl::base::PlannerPtr allocateControlRRT(const ompl::base::SpaceInformationPtr &si)
+            {
+                return std::make_shared<ompl::control::RRT>(std::static_pointer_cast<ompl::control::SpaceInformation>(si));
+            }
+
+            inline std::shared_ptr<ompl::base::RealVectorStateSpace> allocateScenarioSpace(const Scenario &s, unsigned int robot)
+            {
+                auto space = std::make_shared<ompl::base::RealVectorStateSpace>(2);
+                space->setBounds(0., s.size);
+                space->setName("Robot " + std::to_string(robot));
+                return space;
+            }
+
+            /** \brief Build the multi-robot problem with controls for scenario \e s */
+            inline std::pair<ompl::multirobot::control::SpaceInformationPtr, ompl::multirobot::base::ProblemDefinitionPtr>
+            setupControlProblem(const Scenario &s)
+            {
+                auto ma_si = std::make_shared<ompl::multirobot::control::SpaceInformation>();
+                auto ma_pdef = std::make_shared<ompl::multirobot::base::ProblemDefinition>(ma_si);
+                for (unsigned int r = 0; r < s.starts.size(); ++r)
+                {
+                    auto space = allocateScenarioSpace(s, r);
+                    auto cspace = std::make_shared<ompl::control::RealVectorControlSpace>(space, 2);
+                    ompl::base::RealVectorBounds cbounds(2);
+                    cbounds.setLow(-1.);
+                    cbounds.setHigh(1.);
+                    cspace->setBounds(cbounds);
+
+                    auto si = std::make_shared<ompl::control::SpaceInformation>(space, cspace);
+                    si->setStateValidityChecker(std::make_shared<ScenarioValidityChecker>(si, s));
+                    si->setStatePropagator(propagate);
+                    si->setPropagationStepSize(0.1);
+                    si->setMinMaxControlDuration(1, 10);
+                    si->setup();
+
+                    ompl::base::ScopedState<> start(space);
+                    start[0] = s.starts[r][0];
+                    start[1] = s.starts[r][1];
+                    auto pdef = std::make_shared<ompl::base::ProblemDefinition>(si);
+                    pdef->addStartState(start);
+                    pdef->setGoal(std::make_shared<ScenarioGoal>(si, s.goals[r], s.goalThreshold));
+
+                    ma_si->addIndividual(si);
+                    ma_pdef->addIndividual(pdef);
+                }
+                ma_si->lock();
+                ma_pdef->lock();
+                ma_si->setPlannerAllocator(allocateControlRRT);
+                return {ma_si, ma_pdef};
+            }
+
+            /** \brief Build the geometric multi-robot problem for scenario \e s */
+            inline std::pair<ompl::multirobot::base::SpaceInformationPtr, ompl::multirobot::base::ProblemDefinitionPtr>
+            setupGeometricProblem(const Scenario &s)
+            {
+                auto ma_si = std::make_shared<ompl::multirobot::base::SpaceInformation>();
+                auto ma_pdef = std::make_shared<ompl::multirobot::base::ProblemDefinition>(ma_si);
+                for (unsigned int r = 0; r < s.starts.size(); ++r)
+                {
+                    auto space = allocateScenarioSpace(s, r);
+                    auto si = std::make_shared<ompl::base::SpaceInformation>(space);
+                    si->setStateValidityChecker(std::make_shared<ScenarioValidityChecker>(si, s));
+                    si->setup();
+
+                    ompl::base::ScopedState<> start(space), goal(space);
+                    start[0] = s.starts[r][0];
+                    start[1] = s.starts[r][1];
+                    goal[0] = s.goals[r][0];
+                    goal[1] = s.goals[r][1];
+                    auto pdef = std::make_shared<ompl::base::ProblemDefinition>(si);
+                    pdef->setStartAndGoalStates(start, goal, s.goalThreshold);
+
+                    ma_si->addIndividual(si);
+                    ma_pdef->addIndividual(pdef);
+                }
+                ma_si->lock();
+                ma_pdef->lock();
+                return {ma_si, ma_pdef};
+            }
+
+            /** \brief Return the number of time steps at which two robots of \e plan overlap. Paths are
+                interpolated at the propagation step size and robots stay at their last state once they arrive.
+                Only the first \e maxSteps time steps are checked. */
+            inline unsigned int countConflicts(const Scenario &s, const ompl::multirobot::control::PlanControl &plan,
+                                               std::size_t maxSteps = std::numeric_limits<std::size_t>::max())
+            {
+                ompl::multirobot::control::PlanControl copy(plan);
+                copy.interpolate();
+                const unsigned int n = s.starts.size();
+                std::size_t steps = 0;
+                for (unsigned int r = 0; r < n; ++r)
+                    steps = std::max(steps, copy.getPath(r)->getStateCount());
+                steps = std::min(steps, maxSteps);
+                unsigned int conflicts = 0;
+                for (std::size_t k = 0; k < steps; ++k)
+                    for (unsigned int r1 = 0; r1 < n; ++r1)
+                        for (unsigned int r2 = r1 + 1; r2 < n; ++r2)
+                        {
+                            const auto &p1 = copy.getPath(r1);
+                            const auto &p2 = copy.getPath(r2);
+                            const ompl::base::State *s1 = p1->getState(std::min(k, p1->getStateCount() - 1));
+                            const ompl::base::State *s2 = p2->getState(std::min(k, p2->getStateCount() - 1));
+                            if (ScenarioValidityChecker::inCollision(s, s1, s2))
+                                ++conflicts;
+                        }
+                return conflicts;
+            }
+
+            /** \brief Return true if every path of \e plan is valid and ends in the goal region of its robot */
+            template <typename PlanType>
+            bool reachesGoals(const Scenario &s, PlanType &plan, const ompl::multirobot::base::ProblemDefinitionPtr &pdef)
+            {
+                for (unsigned int r = 0; r < s.starts.size(); ++r)
+                {
+                    const auto &path = plan.getPath(r);
+                    if (!path || path->getStateCount() == 0 || !path->check())
+                        return false;
+                    if (!pdef->getIndividual(r)->getGoal()->isSatisfied(path->getStates().back()))
+                        return false;
+                }
+                return true;
+            }
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,673 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2026, the MROR Multi-Robot OMPL contributors
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+/* Author: MROR Multi-Robot OMPL contributors */
+
+#define BOOST_TEST_MODULE "MultiRobotControlPlanning"
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+#include "ompl/multirobot/control/planners/kcbs/KCBS.h"
+#include "ompl/multirobot/control/planners/pp/PP.h"
+
+#include "MultiRobotScenarios.h"
+
+using namespace ompl;
+namespace omrt = ompl::multirobot::test;
+namespace omrc = ompl::multirobot::control;
+
+static const double SOLUTION_TIME = 20.0;
+static const double LOW_LEVEL_SOLVE_TIME = 0.5;
+// set OMPL_TEST_VERBOSE in the environment to print the statistics of every solve
+static const bool VERBOSE = std::getenv("OMPL_TEST_VERBOSE") != nullptr;
+
+/** Performance budgets of K-CBS for each scenario: the wall-clock time and the number of constraint
+ * tree nodes expanded to find a solution. They are generous on purpose. When a change makes a budget
+ * fail, find out why before raising it, and record the new value here so that the budgets of every
+ * release can be compared. */
+struct Budget
+{
+    const char *scenario;
+    double seconds;
+    unsigned int nodes;
+};
+
+static const Budget KCBS_BUDGETS[] = {
+    {"swap", 2., 50},
+    {"corridor", 4., 100},
+    {"open_field_3", 4., 100},
+    {"ring_4", 6., 200},
+};
+
+/** Unlike node counts, run times depend on the machine and on its load, so the time budgets are checked
+ * times this factor. Set OMPL_TEST_TIME_TOLERANCE in the environment to use another factor on slow or
+ * busy machines. */
+static const double TIME_TOLERANCE = 2.0;
+
+static double timeTolerance()
+{
+    const char *factor = std::getenv("OMPL_TEST_TIME_TOLERANCE");
+    double tolerance = factor != nullptr ? std::atof(factor) : 0.;
+    return tolerance > 0. ? tolerance : TIME_TOLERANCE;
+}
+
+static const Budget &budgetFor(const std::string &scenario)
+{
+    for (const auto &b : KCBS_BUDGETS)
+        if (scenario == b.scenario)
+            return b;
+    throw Exception("No budget for scenario " + scenario);
+}
+
+static std::vector<omrt::Scenario> scenarios()
+{
+    return {omrt::swap(), omrt::corridor(), omrt::openField(3), omrt::ring(4)};
+}
+
+/* Solve scenario s with planner and check that the result is an exact, conflict-free plan */
+static double solveAndCheck(const omrt::Scenario &s, multirobot::base::Planner &planner,
+                            const multirobot::base::ProblemDefinitionPtr &pdef)
+{
+    auto start = std::chrono::steady_clock::now();
+    base::PlannerStatus status = planner.solve(SOLUTION_TIME);
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    BOOST_CHECK_MESSAGE(status == base::PlannerStatus::EXACT_SOLUTION,
+                        planner.getName() << " did not solve " << s.name << ": " << status.asString());
+    if (status != base::PlannerStatus::EXACT_SOLUTION)
+        return elapsed;
+
+    auto *plan = pdef->getSolutionPlan()->as<omrc::PlanControl>();
+    BOOST_CHECK_MESSAGE(omrt::reachesGoals(s, *plan, pdef), planner.getName() << " plan for " << s.name
+                                                                              << " does not reach every goal");
+    BOOST_CHECK_MESSAGE(omrt::countConflicts(s, *plan) == 0,
+                        planner.getName() << " plan for " << s.name << " has conflicts");
+    return elapsed;
+}
+
+/* Solve every scenario of ss with an instance of K-CBS set up by configure, check the result as solveAndCheck()
+   does, then call check(s, planner, elapsed) with the run time of the solve. With VERBOSE, print the run time and the statistics given by stats. */
+static void solveScenarios(const std::vector<omrt::Scenario> &ss, const std::string &label,
+                           const std::function<void(omrc::KCBS &)> &configure,
+                           const std::function<void(const omrt::Scenario &, omrc::KCBS &, double)> &check,
+                           const std::function<void(std::ostream &, omrc::KCBS &)> &stats = {})
+{
+    for (const auto &s : ss)
+    {
+        auto problem = omrt::setupControlProblem(s);
+        omrc::KCBS planner(problem.first);
+        planner.setProblemDefinition(problem.second);
+        planner.setLowLevelSolveTime(LOW_LEVEL_SOLVE_TIME);
+        configure(planner);
+        double elapsed = solveAndCheck(s, planner, problem.second);
+        if (VERBOSE)
+        {
+            std::cout << "K-CBS " << s.name << label << ": " << elapsed << " s, "
+                      << planner.getNumberOfNodesExpanded() << " nodes expanded";
+            if (stats)
+                stats(std::cout, planner);
+            std::cout << std::endl;
+        }
+        check(s, planner, elapsed);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(PlanControlCopy)
+{
+    omrt::Scenario s = omrt::swap();
+    auto problem = omrt::setupControlProblem(s);
+    const auto &si = problem.first;
+
+    omrc::PlanControl plan(si);
+    for (unsigned int r = 0; r < si->getIndividualCount(); ++r)
+    {
+        auto path = std::make_shared<control::PathControl>(si->getIndividual(r));
+        base::ScopedState<> a(si->getIndividual(r)->getStateSpace()), b(si->getIndividual(r)->getStateSpace());
+        a[0] = s.starts[r][0];
+        a[1] = s.starts[r][1];
+        b[0] = s.goals[r][0];
+        b[1] = s.goals[r][1];
+        control::Control *c = si->getIndividual(r)->allocControl();
+        path->append(a.get());
+        path->append(b.get(), c, 6.);
+        si->getIndividual(r)->freeControl(c);
+        plan.append(path);
+    }
+    BOOST_CHECK_EQUAL(plan.length(), 12.);
+
+    // the copy owns its paths
+    omrc::PlanControl copy(plan);
+    plan.getPath(0)->getState(1)->as<base::RealVectorStateSpace::StateType>()->values[0] = 0.;
+    BOOST_CHECK_EQUAL(copy.getPath(0)->getState(1)->as<base::RealVectorStateSpace::StateType>()->values[0], 8.);
+    BOOST_CHECK_EQUAL(copy.length(), 12.);
+
+    // plans with controls require a multi-robot space information with controls
+    auto geometric = omrt::setupGeometricProblem(s);
+    BOOST_CHECK_THROW(omrc::PlanControl(geometric.first), Exception);
+}
+
+BOOST_AUTO_TEST_CASE(SharedPathInterpolation)
+{
+    omrt::Scenario s = omrt::swap();
+    auto problem = omrt::setupControlProblem(s);
+    const auto &si = problem.first;
+    const auto &robot = si->getIndividual(0);
+
+    auto path = std::make_shared<control::PathControl>(robot);
+    base::ScopedState<> a(robot->getStateSpace()), b(robot->getStateSpace());
+    a[0] = s.starts[0][0];
+    a[1] = s.starts[0][1];
+    b[0] = s.goals[0][0];
+    b[1] = s.goals[0][1];
+    control::Control *c = robot->allocControl();
+    robot->nullControl(c);
+    path->append(a.get());
+    path->append(b.get(), c, 6.);
+    robot->freeControl(c);
+    path->interpolate();
+    const std::vector<base::State *> states = path->getStates();
+    BOOST_CHECK_GT(states.size(), 2u);
+
+    // K-CBS nodes interpolate plans that share paths with their parent from several threads at once; this is safe
+    // because the shared paths were interpolated first, and an interpolated path is not modified again
+    std::vector<std::thread> threads;
+    for (unsigned int t = 0; t < 4; ++t)
+        threads.emplace_back([&si, &path]
+                             {
+                                 for (unsigned int i = 0; i < 100; ++i)
+                                 {
+                                     omrc::PlanControl plan(si);
+                                     plan.append(path);
+                                     plan.interpolate();
+                                 }
+                             });
+    for (auto &thread : threads)
+        thread.join();
+    BOOST_CHECK(path->getStates() == states);
+}
+
+BOOST_AUTO_TEST_CASE(KCBSScenarios)
+{
+    solveScenarios(scenarios(), "", [](omrc::KCBS &) {},
+                   [](const omrt::Scenario &s, omrc::KCBS &planner, double elapsed)
+                   {
+                       const Budget &budget = budgetFor(s.name);
+                       const double seconds = budget.seconds * timeTolerance();
+                       BOOST_CHECK_MESSAGE(elapsed <= seconds,
+                                           "K-CBS " << s.name << " took " << elapsed << " s, budget is " << seconds
+                                                    << " s");
+                       BOOST_CHECK_MESSAGE(planner.getNumberOfNodesExpanded() <= budget.nodes,
+                                           "K-CBS " << s.name << " expanded " << planner.getNumberOfNodesExpanded()
+                                                    << " nodes, budget is " << budget.nodes);
+                   });
+}
+
+BOOST_AUTO_TEST_CASE(KCBSRacing)
+{
+    solveScenarios({omrt::swap(), omrt::corridor()}, " with 3 racers",
+                   [](omrc::KCBS &planner)
+                   {
+                       planner.setNumRacers(3);
+                       // one racer is configured differently from the usual low-level planner
+                       planner.setRacerAllocators({omrt::allocateControlRRT, [](const base::SpaceInformationPtr &si)
+                                                   {
+                                                       auto rrt = std::make_shared<control::RRT>(
+                                                           std::static_pointer_cast<control::SpaceInformation>(si));
+                                                       rrt->setGoalBias(0.2);
+                                                       return rrt;
+                                                   }});
+                   },
+                   [](const omrt::Scenario &, omrc::KCBS &, double) {},
+                   [](std::ostream &out, omrc::KCBS &planner)
+                   { out << ", " << planner.getNumberOfRacesWonByRacers() << " races won by racers"; });
+}
+
+/* A path of robot through points, one propagation step apart */
+static control::PathControlPtr pathThrough(const control::SpaceInformationPtr &robot,
+                                           const std::vector<std::array<double, 2>> &points)
+{
+    auto path = std::make_shared<control::PathControl>(robot);
+    base::ScopedState<> state(robot->getStateSpace());
+    control::Control *c = robot->allocControl();
+    robot->nullControl(c);
+    for (std::size_t i = 0; i < points.size(); ++i)
+    {
+        state[0] = points[i][0];
+        state[1] = points[i][1];
+        if (i == 0)
+            path->append(state.get());
+        else
+            path->append(state.get(), c, robot->getPropagationStepSize());
+    }
+    robot->freeControl(c);
+    return path;
+}
+
+/* K-CBS that exposes how it expands a node */
+class KCBSInternals : public omrc::KCBS
+{
+public:
+    using omrc::KCBS::KCBS;
+
+    /* the robots of the conflict of plan that the search branches on */
+    std::pair<unsigned int, unsigned int> selectRobots(const omrc::PlanControlPtr &plan)
+    {
+        std::vector<Conflict> confs = findConflicts(plan);
+        const Conflict &c = selectConflict(confs, plan);
+        return {c.robots_[0], c.robots_[1]};
+    }
+
+    /* the independent groups of robots given by the conflicts of plan */
+    std::vector<std::vector<unsigned int>> groups(const omrc::PlanControlPtr &plan)
+    {
+        std::vector<std::vector<unsigned int>> singles;
+        for (unsigned int r = 0; r < siC_->getIndividualCount(); ++r)
+            singles.push_back({r});
+        return joinGroups(singles, findConflicts(plan));
+    }
+
+    /* the steps at which the robots of plan are in conflict */
+    std::vector<unsigned int> conflictSteps(const omrc::PlanControlPtr &plan)
+    {
+        std::vector<unsigned int> steps;
+        for (const auto &c : findConflicts(plan))
+            steps.push_back(c.timeStep_);
+        return steps;
+    }
+
+    /* Expand the node of plan into one child for every (robot, path) of replans, in which robot follows path
+       instead, and return the index of the child the node adopts (-1 if none). conflicts receives the number of
+       conflicts of the node followed by those of its children. */
+    int adoptedChild(const omrc::PlanControlPtr &plan,
+                     const std::vector<std::pair<unsigned int, control::PathControlPtr>> &replans,
+                     std::vector<std::size_t> &conflicts)
+    {
+        auto node = std::make_shared<Node>(plan);
+        node->setConflicts(findConflicts(plan));
+        conflicts = {node->getConflicts().size()};
+        std::vector<NodePtr> children;
+        for (const auto &replan : replans)
+        {
+            auto childPlan = std::make_shared<omrc::PlanControl>(si_);
+            for (unsigned int r = 0; r < siC_->getIndividualCount(); ++r)
+                childPlan->append(r == replan.first ? replan.second : plan->getPath(r));
+            auto child = std::make_shared<Node>(childPlan);
+            child->setConstraint(std::make_shared<Constraint>(replan.first, nullptr, 0, 0, nullptr));
+            child->setConflicts(findConflicts(childPlan));
+            child->setCost(child->getConflicts().size());
+            conflicts.push_back(child->getConflicts().size());
+            children.push_back(child);
+        }
+        NodePtr adopted = findBypass(node, children);
+        return adopted ? std::find(children.begin(), children.end(), adopted) - children.begin() : -1;
+    }
+};
+
+/* Robots 0 and 1 stop at goals that overlap from step 3 on: whichever is constrained must arrive later, so their
+   conflict is cardinal. Robots 2 and 3 touch at step 1 on their way, which either of them can avoid at no cost. */
+static omrc::PlanControlPtr conflictingPlan(const omrc::SpaceInformationPtr &si)
+{
+    auto plan = std::make_shared<omrc::PlanControl>(si);
+    plan->append(pathThrough(si->getIndividual(0), {{{1., 1.}}, {{2., 1.}}, {{3., 1.}}, {{4., 1.}}}));
+    plan->append(pathThrough(si->getIndividual(1), {{{7., 1.}}, {{6., 1.}}, {{5., 1.}}, {{4.3, 1.}}}));
+    plan->append(pathThrough(si->getIndividual(2),
+                             {{{3., 8.}}, {{4., 8.}}, {{5., 8.}}, {{6., 8.}}, {{7., 8.}}, {{8., 8.}}, {{9., 8.}}}));
+    plan->append(pathThrough(si->getIndividual(3),
+                             {{{4., 9.5}}, {{4., 8.2}}, {{4., 9.5}}, {{5., 9.5}}, {{6., 9.5}}, {{7., 9.5}}, {{8., 9.5}}}));
+    return plan;
+}
+
+BOOST_AUTO_TEST_CASE(KCBSConflictPrioritization)
+{
+    // branching on the earliest conflict and on the most constraining one must both solve the problem
+    for (bool prioritize : {false, true})
+        solveScenarios({omrt::corridor(), omrt::ring(4)}, prioritize ? " with conflict prioritization" : "",
+                       [prioritize](omrc::KCBS &planner) { planner.setPrioritizeConflicts(prioritize); },
+                       [prioritize](const omrt::Scenario &, omrc::KCBS &planner, double)
+                       {
+                           if (!prioritize)
+                               BOOST_CHECK_EQUAL(planner.getNumberOfCardinalConflicts() +
+                                                     planner.getNumberOfSemiCardinalConflicts(),
+                                                 0u);
+                       },
+                       [](std::ostream &out, omrc::KCBS &planner)
+                       {
+                           out << ", " << planner.getNumberOfCardinalConflicts() << " cardinal and "
+                               << planner.getNumberOfSemiCardinalConflicts() << " semi-cardinal conflicts";
+                       });
+}
+
+BOOST_AUTO_TEST_CASE(KCBSCardinalConflict)
+{
+    auto problem = omrt::setupControlProblem(omrt::openField(4));
+    omrc::PlanControlPtr plan = conflictingPlan(problem.first);
+
+    // the earliest conflict is branched on without prioritization, the cardinal one with it
+    KCBSInternals planner(problem.first);
+    planner.setPrioritizeConflicts(false);
+    BOOST_CHECK(planner.selectRobots(plan) == std::make_pair(2u, 3u));
+    BOOST_CHECK_EQUAL(planner.getNumberOfCardinalConflicts(), 0u);
+    planner.setPrioritizeConflicts(true);
+    BOOST_CHECK(planner.selectRobots(plan) == std::make_pair(0u, 1u));
+    BOOST_CHECK_EQUAL(planner.getNumberOfCardinalConflicts(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(KCBSBypass)
+{
+    // adopting children into their parent must not change what is solved
+    for (bool bypass : {false, true})
+        solveScenarios({omrt::corridor(), omrt::ring(4)}, bypass ? " with bypass" : "",
+                       [bypass](omrc::KCBS &planner) { planner.setBypass(bypass); },
+                       [bypass](const omrt::Scenario &, omrc::KCBS &planner, double)
+                       {
+                           if (!bypass)
+                               BOOST_CHECK_EQUAL(planner.getNumberOfBypasses(), 0u);
+                       },
+                       [](std::ostream &out, omrc::KCBS &planner)
+                       { out << ", " << planner.getNumberOfBypasses() << " bypasses"; });
+}
+
+BOOST_AUTO_TEST_CASE(KCBSForcedBypass)
+{
+    auto problem = omrt::setupControlProblem(omrt::openField(4));
+    const auto &si = problem.first;
+    omrc::PlanControlPtr plan = conflictingPlan(si);
+    // robot 3 waits instead of touching robot 2, which takes no longer; robot 0 stops short of robot 1, which
+    // leaves fewer conflicts but takes three times longer
+    const std::vector<std::pair<unsigned int, control::PathControlPtr>> replans = {
+        {3u, pathThrough(si->getIndividual(3), {{{4., 9.5}}, {{4., 9.5}}, {{4., 9.5}}, {{5., 9.5}}, {{6., 9.5}},
+                                                {{7., 9.5}}, {{8., 9.5}}})},
+        {0u, pathThrough(si->getIndividual(0), {{{1., 1.}}, {{1., 1.}}, {{1., 1.}}, {{1., 1.}}, {{1., 1.}},
+                                                {{1., 1.}}, {{1.5, 1.}}, {{2., 1.}}, {{2.5, 1.}}, {{3., 1.}}})}};
+
+    KCBSInternals planner(si);
+    planner.setBypass(true);
+    std::vector<std::size_t> conflicts;
+    BOOST_CHECK_EQUAL(planner.adoptedChild(plan, replans, conflicts), 0);
+    BOOST_CHECK_LT(conflicts[1], conflicts[0]);
+    BOOST_CHECK_LT(conflicts[2], conflicts[1]);
+
+    // robot 0 is adopted once its path may take three times longer
+    planner.setBypassTolerance(2.5);
+    BOOST_CHECK_EQUAL(planner.adoptedChild(plan, replans, conflicts), 1);
+
+    // without bypass, no child is adopted
+    planner.setBypass(false);
+    BOOST_CHECK_EQUAL(planner.adoptedChild(plan, replans, conflicts), -1);
+}
+
+BOOST_AUTO_TEST_CASE(KCBSIndependenceDetection)
+{
+    solveScenarios({omrt::lanes(3), omrt::ring(4)}, " with independence detection",
+                   [](omrc::KCBS &planner) { planner.setIndependenceDetection(true); },
+                   [](const omrt::Scenario &s, omrc::KCBS &planner, double)
+                   {
+                       BOOST_CHECK_GE(planner.getNumberOfGroups(), 1u);
+                       BOOST_CHECK_LE(planner.getNumberOfGroups(), s.starts.size());
+                   },
+                   [](std::ostream &out, omrc::KCBS &planner)
+                   { out << ", " << planner.getNumberOfGroups() << " groups"; });
+}
+
+BOOST_AUTO_TEST_CASE(KCBSLaneGroups)
+{
+    // whether the root paths of a pair are in conflict depends on the low-level planner, so the split is checked
+    // on a plan in which every robot drives straight to its goal and meets the other robot of its lane halfway
+    omrt::Scenario s = omrt::lanes(3);
+    auto problem = omrt::setupControlProblem(s);
+    auto plan = std::make_shared<omrc::PlanControl>(problem.first);
+    for (std::size_t r = 0; r < s.starts.size(); ++r)
+    {
+        std::vector<std::array<double, 2>> points;
+        for (unsigned int i = 0; i <= 12; ++i)
+            points.push_back({{s.starts[r][0] + (s.goals[r][0] - s.starts[r][0]) * i / 12.,
+                               s.starts[r][1] + (s.goals[r][1] - s.starts[r][1]) * i / 12.}});
+        plan->append(pathThrough(problem.first->getIndividual(r), points));
+    }
+
+    // the walls keep the lanes apart, so every lane is a group of its own
+    KCBSInternals planner(problem.first);
+    BOOST_CHECK(planner.groups(plan) == (std::vector<std::vector<unsigned int>>{{0, 1}, {2, 3}, {4, 5}}));
+}
+
+BOOST_AUTO_TEST_CASE(KCBSConflictWindow)
+{
+    omrt::Scenario s = omrt::ring(4);
+    auto problem = omrt::setupControlProblem(s);
+    omrc::KCBS planner(problem.first);
+    planner.setProblemDefinition(problem.second);
+    planner.setLowLevelSolveTime(LOW_LEVEL_SOLVE_TIME);
+    planner.setConflictWindow(1.);
+    const std::size_t steps = 1. / problem.first->getIndividual(0)->getPropagationStepSize();
+
+    // the planner is called repeatedly, as in a receding horizon
+    for (unsigned int call = 0; call < 2; ++call)
+    {
+        planner.clear();
+        problem.second->clearSolutionPaths();
+        base::PlannerStatus status = planner.as<multirobot::base::Planner>()->solve(SOLUTION_TIME);
+        BOOST_REQUIRE(status == base::PlannerStatus::EXACT_SOLUTION);
+        auto *plan = problem.second->getSolutionPlan()->as<omrc::PlanControl>();
+        BOOST_CHECK(omrt::reachesGoals(s, *plan, problem.second));
+        BOOST_CHECK_EQUAL(omrt::countConflicts(s, *plan, steps), 0u);
+        if (VERBOSE)
+            std::cout << "K-CBS " << s.name << " with a conflict window of 1 s: "
+                      << planner.getNumberOfNodesExpanded() << " nodes expanded, "
+                      << omrt::countConflicts(s, *plan) << " conflicts after the window" << std::endl;
+    }
+}
+
+/* The robots of the swap scenario drive straight at each other at full speed, from step \e from of the drive on.
+   They are in conflict from step 28 - from to step 32 - from. */
+static omrc::PlanControlPtr headOnPlan(const omrc::SpaceInformationPtr &si, unsigned int from)
+{
+    std::vector<std::array<double, 2>> points0, points1;
+    for (unsigned int k = from; k <= 60; ++k)
+    {
+        points0.push_back({{2. + 0.1 * k, 5.}});
+        points1.push_back({{8. - 0.1 * k, 5.}});
+    }
+    auto plan = std::make_shared<omrc::PlanControl>(si);
+    plan->append(pathThrough(si->getIndividual(0), points0));
+    plan->append(pathThrough(si->getIndividual(1), points1));
+    return plan;
+}
+
+BOOST_AUTO_TEST_CASE(KCBSDeferredConflict)
+{
+    omrt::Scenario s = omrt::swap();
+    auto problem = omrt::setupControlProblem(s);
+    const auto &si = problem.first;
+
+    // a conflict after the window is deferred, and found once the robots have advanced
+    KCBSInternals internals(si);
+    BOOST_CHECK_EQUAL(internals.conflictSteps(headOnPlan(si, 0)).size(), 5u);
+    internals.setConflictWindow(1.);
+    BOOST_CHECK(internals.conflictSteps(headOnPlan(si, 0)).empty());
+    const std::vector<unsigned int> steps = internals.conflictSteps(headOnPlan(si, 25));
+    BOOST_REQUIRE(!steps.empty());
+    BOOST_CHECK_EQUAL(steps.front(), 3u);
+
+    // the next call, from where the robots have advanced to, resolves it
+    omrt::Scenario advanced = s;
+    advanced.starts = {{{4.5, 5.}}, {{5.5, 5.}}};
+    auto later = omrt::setupControlProblem(advanced);
+    omrc::KCBS planner(later.first);
+    planner.setProblemDefinition(later.second);
+    planner.setLowLevelSolveTime(LOW_LEVEL_SOLVE_TIME);
+    planner.setConflictWindow(1.);
+    base::PlannerStatus status = planner.as<multirobot::base::Planner>()->solve(SOLUTION_TIME);
+    BOOST_REQUIRE(status == base::PlannerStatus::EXACT_SOLUTION);
+    auto *plan = later.second->getSolutionPlan()->as<omrc::PlanControl>();
+    BOOST_CHECK(omrt::reachesGoals(advanced, *plan, later.second));
+    const std::size_t window = 1. / later.first->getIndividual(0)->getPropagationStepSize();
+    BOOST_CHECK_EQUAL(omrt::countConflicts(advanced, *plan, window), 0u);
+
+    // the window is measured in steps, so it needs the robots to have the same step size
+    later.first->getIndividual(1)->setPropagationStepSize(0.2);
+    planner.clear();
+    BOOST_CHECK_THROW(planner.as<multirobot::base::Planner>()->solve(SOLUTION_TIME), ompl::Exception);
+}
+
+BOOST_AUTO_TEST_CASE(KCBSDeterministicReplay)
+{
+    omrt::Scenario s = omrt::swap();
+    std::stringstream log, plan, replayedLog, replayedPlan;
+    unsigned int nodes = 0;
+    {
+        auto problem = omrt::setupControlProblem(s);
+        omrc::KCBS planner(problem.first);
+        planner.setProblemDefinition(problem.second);
+        planner.setLowLevelSolveTime(LOW_LEVEL_SOLVE_TIME);
+        planner.setDeterministic(true);
+        planner.setSeed(1);
+        solveAndCheck(s, planner, problem.second);
+        planner.writeEventLog(log);
+        problem.second->getSolutionPlan()->as<omrc::PlanControl>()->printAsMatrix(plan, "Robot");
+        nodes = planner.getNumberOfNodesExpanded();
+    }
+    {
+        auto problem = omrt::setupControlProblem(s);
+        omrc::KCBS planner(problem.first);
+        planner.setProblemDefinition(problem.second);
+        planner.setLowLevelSolveTime(LOW_LEVEL_SOLVE_TIME);
+        planner.setup();
+        std::stringstream in(log.str());
+        planner.readEventLog(in);
+        BOOST_CHECK(planner.isReplaying());
+        BOOST_CHECK_EQUAL(planner.getSeed(), 1u);
+        solveAndCheck(s, planner, problem.second);
+        planner.writeEventLog(replayedLog);
+        problem.second->getSolutionPlan()->as<omrc::PlanControl>()->printAsMatrix(replayedPlan, "Robot");
+        BOOST_CHECK_EQUAL(planner.getNumberOfNodesExpanded(), nodes);
+    }
+    BOOST_CHECK(plan.str() == replayedPlan.str());
+    BOOST_CHECK(log.str() == replayedLog.str());
+
+    // malformed logs are rejected
+    auto problem = omrt::setupControlProblem(s);
+    omrc::KCBS planner(problem.first);
+    std::stringstream bad("KCBS-EVENT-LOG 1\nseed 1\nevents 1\nevent 0 0 7 0\n");
+    BOOST_CHECK_THROW(planner.readEventLog(bad), Exception);
+    BOOST_CHECK(!planner.isReplaying());
+}
+
+BOOST_AUTO_TEST_CASE(KCBSAutoTuning)
+{
+    omrt::Scenario s = omrt::corridor();
+    std::stringstream tuning;
+    {
+        auto problem = omrt::setupControlProblem(s);
+        omrc::KCBS planner(problem.first);
+        planner.setProblemDefinition(problem.second);
+        planner.setLowLevelSolveTime(LOW_LEVEL_SOLVE_TIME);
+        planner.setAutoTune(true);
+        planner.setScenarioClass("corridor");
+        solveAndCheck(s, planner, problem.second);
+        for (unsigned int r = 0; r < problem.first->getIndividualCount(); ++r)
+        {
+            BOOST_CHECK_GE(planner.getRobotSolveTime(r), 0.1 * LOW_LEVEL_SOLVE_TIME);
+            BOOST_CHECK_LE(planner.getRobotSolveTime(r), 10. * LOW_LEVEL_SOLVE_TIME);
+        }
+        planner.writeTuning(tuning);
+    }
+    {
+        // the learned settings are the starting point of the next run of the same scenario class
+        auto problem = omrt::setupControlProblem(s);
+        omrc::KCBS planner(problem.first);
+        planner.setProblemDefinition(problem.second);
+        planner.setLowLevelSolveTime(LOW_LEVEL_SOLVE_TIME);
+        planner.setAutoTune(true);
+        planner.setScenarioClass("corridor");
+        std::stringstream in(tuning.str());
+        planner.readTuning(in);
+        std::stringstream written;
+        planner.writeTuning(written);
+        BOOST_CHECK(tuning.str() == written.str());
+        solveAndCheck(s, planner, problem.second);
+    }
+    {
+        // the learned number of racers is only changed by the outcome of races; with two threads, one node is
+        // expanded at a time with its two replans, so no thread is free to race and the learned number is kept
+        std::string learned = tuning.str();
+        const std::size_t racers = learned.find("racers ");
+        BOOST_REQUIRE(racers != std::string::npos);
+        learned.replace(racers, learned.find('\n', racers) - racers, "racers 7");
+        auto problem = omrt::setupControlProblem(s);
+        omrc::KCBS planner(problem.first);
+        planner.setProblemDefinition(problem.second);
+        planner.setLowLevelSolveTime(LOW_LEVEL_SOLVE_TIME);
+        planner.setNumThreads(2);
+        planner.setAutoTune(true);
+        planner.setScenarioClass("corridor");
+        std::stringstream in(learned);
+        planner.readTuning(in);
+        solveAndCheck(s, planner, problem.second);
+        std::stringstream written;
+        planner.writeTuning(written);
+        BOOST_CHECK(written.str().find("racers 7\n") != std::string::npos);
+    }
+
+    // malformed settings are rejected
+    auto problem = omrt::setupControlProblem(s);
+    omrc::KCBS planner(problem.first);
+    std::stringstream bad("KCBS-TUNING 1\nclasses 1\nclass \"corridor\"\nracers 0\nsolve_times 0\n");
+    BOOST_CHECK_THROW(planner.readTuning(bad), Exception);
+}
+
+BOOST_AUTO_TEST_CASE(PPScenarios)
+{
+    for (const auto &s : {omrt::swap(), omrt::openField(3)})
+    {
+        // with and without the reservation table for the paths of higher-priority robots
+        for (double cellSize : {0., 1.})
+        {
+            auto problem = omrt::setupControlProblem(s);
+            omrc::PP planner(problem.first);
+            planner.setProblemDefinition(problem.second);
+            planner.setReservationTable(cellSize, 2. * s.radius);
+            double elapsed = solveAndCheck(s, planner, problem.second);
+            if (VERBOSE)
+                std::cout << "PP " << s.name << " (reservation cell size " << cellSize << "): " << elapsed << " s"
+                          << std::endl;
+        }
+    }
+}
@@ -0,0 +1,96 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2026, the MROR Multi-Robot OMPL contributors
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+/* Author: MROR Multi-Robot OMPL contributors */
+
+#define BOOST_TEST_MODULE "MultiRobotGeometricPlanning"
+#include <boost/test/unit_test.hpp>
+#include <iostream>
+
+#include "ompl/multirobot/geometric/planners/pp/PP.h"
+
+#include "MultiRobotScenarios.h"
+
+using namespace ompl;
+namespace omrt = ompl::multirobot::test;
+namespace omrg = ompl::multirobot::geometric;
+
+static const double SOLUTION_TIME = 10.0;
+
+BOOST_AUTO_TEST_CASE(PlanGeometricCopy)
+{
+    omrt::Scenario s = omrt::swap();
+    auto problem = omrt::setupGeometricProblem(s);
+    const auto &si = problem.first;
+
+    omrg::PlanGeometric plan(si);
+    for (unsigned int r = 0; r < si->getIndividualCount(); ++r)
+    {
+        base::ScopedState<> a(si->getIndividual(r)->getStateSpace()), b(si->getIndividual(r)->getStateSpace());
+        a[0] = s.starts[r][0];
+        a[1] = s.starts[r][1];
+        b[0] = s.goals[r][0];
+        b[1] = s.goals[r][1];
+        plan.append(std::make_shared<geometric::PathGeometric>(si->getIndividual(r), a.get(), b.get()));
+    }
+    BOOST_CHECK_EQUAL(plan.length(), 12.);
+
+    // the copy owns its paths
+    omrg::PlanGeometric copy(plan);
+    plan.getPath(0)->getState(1)->as<base::RealVectorStateSpace::StateType>()->values[0] = 0.;
+    BOOST_CHECK_EQUAL(copy.getPath(0)->getState(1)->as<base::RealVectorStateSpace::StateType>()->values[0], 8.);
+    BOOST_CHECK_EQUAL(copy.length(), 12.);
+
+    plan.interpolate();
+    BOOST_CHECK(plan.getPath(0)->getStateCount() > 2);
+    BOOST_CHECK_EQUAL(copy.getPath(0)->getStateCount(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(PPScenarios)
+{
+    for (const auto &s : {omrt::swap(), omrt::corridor(), omrt::openField(3), omrt::ring(4)})
+    {
+        auto problem = omrt::setupGeometricProblem(s);
+        omrg::PP planner(problem.first);
+        planner.setProblemDefinition(problem.second);
+        base::PlannerStatus status = planner.as<multirobot::base::Planner>()->solve(SOLUTION_TIME);
+        BOOST_CHECK_MESSAGE(status == base::PlannerStatus::EXACT_SOLUTION,
+                            "PP did not solve " << s.name << ": " << status.asString());
+        if (status != base::PlannerStatus::EXACT_SOLUTION)
+            continue;
+        auto *plan = problem.second->getSolutionPlan()->as<omrg::PlanGeometric>();
+        BOOST_CHECK_MESSAGE(omrt::reachesGoals(s, *plan, problem.second),
+                            "PP plan for " << s.name << " does not reach every goal");
+    }
+}
@@ -0,0 +1,166 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2026, the MROR Multi-Robot OMPL contributors
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+/* Author: MROR Multi-Robot OMPL contributors */
+
+#define BOOST_TEST_MODULE "Console"
+#include <boost/test/unit_test.hpp>
+
+#include "ompl/util/Console.h"
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace ompl;
+
+/* Records the messages it receives. If blocked, log() waits until the handler is released. */
+class RecordingOutputHandler : public msg::OutputHandler
+{
+public:
+    void log(const std::string &text, msg::LogLevel /*level*/, const char * /*filename*/, int /*line*/) override
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        messages_.push_back(text);
+        entered_.notify_all();
+        released_.wait(lock, [this] { return !blocked_; });
+    }
+
+    void block()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        blocked_ = true;
+    }
+
+    void release()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            blocked_ = false;
+        }
+        released_.notify_all();
+    }
+
+    /* Wait until \e count messages were received */
+    void waitFor(std::size_t count)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        entered_.wait(lock, [this, count] { return messages_.size() >= count; });
+    }
+
+    std::vector<std::string> messages()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return messages_;
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable entered_;
+    std::condition_variable released_;
+    std::vector<std::string> messages_;
+    bool blocked_{false};
+};
+
+BOOST_AUTO_TEST_CASE(AsyncFlush)
+{
+    RecordingOutputHandler recorder;
+    msg::OutputHandlerAsync async(&recorder);
+    for (int i = 0; i < 100; ++i)
+        async.log(std::to_string(i), msg::LOG_INFO, __FILE__, __LINE__);
+    // after flush(), every message logged before has been passed on, in order
+    async.flush();
+    std::vector<std::string> messages = recorder.messages();
+    BOOST_REQUIRE_EQUAL(messages.size(), 100u);
+    for (int i = 0; i < 100; ++i)
+        BOOST_CHECK_EQUAL(messages[i], std::to_string(i));
+    BOOST_CHECK_EQUAL(async.getDroppedCount(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(AsyncDropCounting)
+{
+    RecordingOutputHandler recorder;
+    msg::OutputHandlerAsync async(&recorder, 4);
+
+    // hold the background thread inside the handler, so that the buffer fills up
+    recorder.block();
+    async.log("first", msg::LOG_INFO, __FILE__, __LINE__);
+    recorder.waitFor(1);
+    for (int i = 0; i < 7; ++i)
+        async.log(std::to_string(i), msg::LOG_INFO, __FILE__, __LINE__);
+    BOOST_CHECK_EQUAL(async.getDroppedCount(), 3u);
+
+    recorder.release();
+    async.flush();
+    // the drop is reported before the next message that is passed on
+    std::vector<std::string> messages = recorder.messages();
+    BOOST_REQUIRE_EQUAL(messages.size(), 6u);
+    BOOST_CHECK_EQUAL(messages[0], "first");
+    BOOST_CHECK(messages[1].find("3 log messages were dropped") == 0);
+    for (int i = 0; i < 4; ++i)
+        BOOST_CHECK_EQUAL(messages[i + 2], std::to_string(i));
+}
+
+BOOST_AUTO_TEST_CASE(RateLimitPerCallSite)
+{
+    RecordingOutputHandler recorder;
+    msg::useOutputHandler(&recorder);
+    const msg::LogLevel level = msg::getLogLevel();
+    msg::setLogLevel(msg::LOG_WARN);
+    msg::setRateLimit(2);
+    const std::size_t limited = msg::getRateLimitedCount();
+
+    // each call site outputs at most 2 messages per second; errors are never limited
+    for (int i = 0; i < 5; ++i)
+        OMPL_WARN("first call site %d", i);
+    for (int i = 0; i < 5; ++i)
+        OMPL_WARN("second call site %d", i);
+    for (int i = 0; i < 5; ++i)
+        OMPL_ERROR("error %d", i);
+
+    msg::setRateLimit(0);
+    msg::setLogLevel(level);
+    msg::restorePreviousOutputHandler();
+
+    std::vector<std::string> messages = recorder.messages();
+    BOOST_CHECK_EQUAL(messages.size(), 9u);
+    BOOST_CHECK_EQUAL(msg::getRateLimitedCount() - limited, 6u);
+    BOOST_CHECK_EQUAL(std::count_if(messages.begin(), messages.end(),
+                                    [](const std::string &m) { return m.find("first call site") == 0; }),
+                      2);
+    BOOST_CHECK_EQUAL(std::count_if(messages.begin(), messages.end(),
+                                    [](const std::string &m) { return m.find("second call site") == 0; }),
+                      2);
+}
@@ -96,6 +96,31 @@ BOOST_AUTO_TEST_CASE(DifferentSeeds)
     BOOST_CHECK(same < 2 * N);
 }
 
+BOOST_AUTO_TEST_CASE(ScopedThreadSeed)
+{
+    std::vector<std::uint_fast32_t> seeds[2];
+    for (auto &s : seeds)
+    {
+        RNG::ScopedThreadSeed seed(42);
+        RNG r1, r2;
+        {
+            RNG::ScopedThreadSeed inner(7);
+            RNG r3;
+            s.push_back(r3.getLocalSeed());
+        }
+        RNG r4;
+        s.push_back(r1.getLocalSeed());
+        s.push_back(r2.getLocalSeed());
+        s.push_back(r4.getLocalSeed());
+    }
+    BOOST_CHECK(seeds[0] == seeds[1]);
+    BOOST_CHECK(seeds[0][1] != seeds[0][2]);
+
+    // without a scoped seed, seeds come from the global generator again
+    RNG r5, r6;
+    BOOST_CHECK(r5.getLocalSeed() != r6.getLocalSeed());
+}
+
 BOOST_AUTO_TEST_CASE(ValidRangeInts)
 {
     RNG r;